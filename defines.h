@@ -31,7 +31,31 @@
 #define MAX_PORT_TRIALS 100     /* rte_eth_link_get() is attempted maximum so many times, and error is reported if still unsuccessful */
 #define START_DELAY 2000        /* Delay (ms) before senders start sending, used for synchronized start. Beware that DUT NICs need time to get ready! */
 #define TOLERANCE 1.00001       /* Maximum allowed time inaccuracy, 1.00001 allows 0.001% more time for sending */
-#define N 40			/* used for PDV and varport: all frames exist is N copies to mitigate the problem of write after send */
+#define N 40			/* used for PDV and varport: all frames exist is N copies to mitigate the problem of write after send, if FRAME_COPIES cannot be used */
+#define FRAME_COPIES 8		/* number of copies used instead of N, if the PMD can clean up its TX descriptors on request (see frameReuse) */
+#define REUSE_POLLS 64		/* reference count reads between two TX descriptor cleanups, while a sender waits for a copy (see frameReuse) */
+#define ECHO_RING_SIZE 4096	/* size of the rte_ring carrying echo replies from Responder/Receiver to Responder/Sender (power of 2) */
+#define ECHO_RTT_SAMPLES 1000000 /* maximum number of round-trip time samples stored by the Initiator/Receiver in echo mode */
+#define MAX_PORT_PAIRS 4		/* maximum number of Left/Right port pairs used in parallel (stateless tests of siitperf-tp) */
+#define MAX_FRAME_SIZE 9018	/* largest Ethernet frame (including the FCS) on the wire: jumbo frame with 9000 bytes MTU */
+#define MAX_FRAME_RATE 300000000	/* sanity limit of the command line frame rates, the actual limit is derived from the link speed */
+#define RANDOM_LANES 4		/* number of independent xoshiro256** lanes generated together (4x64 bits fit into an AVX2 register) */
+#define RANDOM_BUFFER 64	/* number of bounded pseudorandom values generated in a batch for a field (multiple of 2*RANDOM_LANES) */
+#define PIPELINE_RING_SIZE 4096 /* size of the rte_ring carrying prepared frames from the producer to the sender (Pipeline 1, power of 2) */
+#define IMIX_MAX_SIZES 8	/* maximum number of frame size classes in an IMIX */
+#define IMIX_PERIOD 1024	/* maximum sum of the weights of the IMIX frame size classes (length of the precomputed order) */
+#define SCHEDULE_CHUNK 65536	/* number of frames in a chunk of a traffic schedule that is generated by a helper lcore (see trafficSchedule) */
+#define MAX_DEST_NETS 65536	/* maximum number of destination networks (Num-L-Nets, Num-R-Nets) in stateless tests of siitperf-tp, see send() */
+#define MAX_PREGEN_NETS 256	/* maximum number of destination networks, if the frames of each network are pre-generated (stateful tests, lat, pdv) */
+#define PERMUTATION_ROUNDS 6	/* number of rounds of the Feistel network of the on the fly random permutation (see randomPermutation) */
+#define CALIBRATION_RING_SIZE 1024 /* size of the rte_rings of the software loopback ports used by the self-calibration (like the RX queues) */
+#define LATENESS_BINS 65	/* number of bins of the log2 histogram of the lateness of the senders (see latenessHistogram) */
+#define FULL_BURSTS_WARNING 50	/* a receiver is warned to be close to its limit, if this percentage of its polls returned full bursts */
+#define TSC_PINGPONG_ROUNDS 1000	/* number of ping-pong rounds of the measurement of the TSC offset of a receiver (see tscOffset) */
+#define DELAY_SUB_BITS 7	/* each power of two range of the delay histogram of the combined measurement has 2^7 bins (see delayHistogram) */
+#define NOISE_CHECK_MS 200	/* duration of the host noise preflight check of the lcores in milliseconds (see hostNoiseCheck) */
+#define BENCH_FRAMES 1000000	/* number of frames (or other items) processed by a micro-benchmark of siitperf-bench */
+#define BENCH_POOL_SIZE 8191	/* number of mbufs in the packet pool of siitperf-bench */
 
 // values taken from DPDK sample programs
 #define MAX_PKT_BURST 32        /* Maximum burst size for rte_eth_rx_burst() */
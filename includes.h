@@ -22,12 +22,16 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
 #include <numa.h>
 #include <random>
 #include <iostream>
 #include <iomanip>
 #include <chrono>
 #include <algorithm>
+#include <vector>
 #include <atomic>
 #include <rte_lcore.h>
 #include <rte_mempool.h>
@@ -35,6 +39,10 @@
 #include <rte_ether.h>
 #include <rte_ip.h>
 #include <rte_udp.h>
+#include <rte_tcp.h>
 #include <rte_ethdev.h>
 #include <rte_malloc.h>
+#include <rte_ring.h>
+#include <rte_eth_ring.h>
+#include <rte_telemetry.h>
 
@@ -39,6 +39,51 @@ int Latency::readCmdLine(int argc, const char *argv[]) {
   if ( Throughput::readCmdLine(argc-2,argv) < 0 )
     return -1;
 
+  if ( responder_echo ) {
+    std::cerr << "Input Error: 'Responder-echo' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( combined ) {
+    std::cerr << "Input Error: 'Combined' is supported by siitperf-pdv only." << std::endl;
+    return -1;
+  }
+  if ( search_mode ) {
+    std::cerr << "Input Error: 'Search-mode' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( popularity.type ) {
+    std::cerr << "Input Error: 'Popularity' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( port_pairs > 1 ) {
+    std::cerr << "Input Error: Multiple port pairs are supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( schedule ) {
+    std::cerr << "Input Error: 'Schedule' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( pipeline ) {
+    std::cerr << "Input Error: 'Pipeline' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( imix.sizes ) {
+    std::cerr << "Input Error: 'IMIX' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( tcp ) {
+    std::cerr << "Input Error: 'TCP' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( num_left_nets > MAX_PREGEN_NETS || num_right_nets > MAX_PREGEN_NETS ) {
+    std::cerr << "Input Error: More than " << MAX_PREGEN_NETS << " destination networks are supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( calibrate ) {
+    std::cerr << "Input Error: 'Calibrate' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+
   if ( !stateful )
     numThroughputPars=6;	// stateless throughput test uses 6 parameters 
   else
@@ -187,6 +232,17 @@ void mkDataLatency(uint8_t *data, uint16_t length, uint16_t latency_frame_id) {
     data[i] = i % 256;
 }
 
+// allocates the arrays for the Latency Frames at the first measurement, the further repetitions reuse the frames
+bool latencyFrames::reuse(uint16_t num_timestamps) {
+  if ( frames )
+    return true;
+  frames = new struct rte_mbuf *[num_timestamps];
+  chksum = new uint16_t[num_timestamps];
+  if ( !frames || !chksum )
+    rte_exit(EXIT_FAILURE, "Error: Tester can't allocate memory for latency frame pointers!\n");
+  return false;
+}
+
 // sends Test Frames for latency measurements including "num_timestamps" number of Latency frames
 int sendLatency(void *par) {
   // collecting input parameters:
@@ -228,10 +284,13 @@ int sendLatency(void *par) {
   uint16_t dport_min = p->dport_min;
   uint16_t dport_max = p->dport_max;
   uint64_t *send_ts = p->send_ts;
+  latencyFrames *lat_frames = p->lat_frames;
 
   // further local variables
   uint64_t frames_to_send = duration * frame_rate;      // Each active sender sends this number of frames
   uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
   double elapsed_seconds; // for checking the elapsed seconds during sending
   int latency_test_time = duration-delay;	// lenght of the time interval, while latency frames are sent
   uint64_t frames_to_send_during_latency_test = latency_test_time * frame_rate; // precalcalculated value to speed up calculation in the loop
@@ -253,30 +312,31 @@ int sendLatency(void *par) {
       // create backround Test Frame (always IPv6)
       bg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0);
   
-      // create Latency Test Frames (may be foreground frames and background frames as well)
-      struct rte_mbuf ** latency_frames = new struct rte_mbuf *[num_timestamps];
-      if ( !latency_frames )
-        rte_exit(EXIT_FAILURE, "Error: Tester can't allocate memory for latency frame pointers!\n");
+      // create Latency Test Frames (may be foreground frames and background frames as well), unless a previous repetition did so
+      bool reuse = lat_frames->reuse(num_timestamps);
+      struct rte_mbuf ** latency_frames = lat_frames->frames;
   
       uint64_t start_latency_frame = delay*frame_rate; // the ordinal number of the very first latency frame
-      for ( int i=0; i<num_timestamps; i++ )
-        if ( (start_latency_frame+i*frame_rate*latency_test_time/num_timestamps) % n  < m ) {
-          if ( ip_version == 4 )  // foreground frame, may be IPv4 or IPv6
-            latency_frames[i] = mkLatencyFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0, i);
-          else  // IPv6
-            latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0, i);
-        } else {
-          // background frame, must be IPv6
-          latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0, i);
-        }
+      if ( !reuse )
+        for ( int i=0; i<num_timestamps; i++ )
+          if ( (start_latency_frame+i*frame_rate*latency_test_time/num_timestamps) % n  < m ) {
+            if ( ip_version == 4 )  // foreground frame, may be IPv4 or IPv6
+              latency_frames[i] = mkLatencyFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0, i);
+            else  // IPv6
+              latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0, i);
+          } else {
+            // background frame, must be IPv6
+            latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0, i);
+          }
    
       // naive sender version: it is simple and fast
       int latency_timestamp_no=0; // counter for the latency frames from 0 to num_timestamps-1
       uint64_t send_next_latency_frame = start_latency_frame; // at what frame count to send the next latency frame 
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further three will come!
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // a latency frame is to be sent
+          rte_mbuf_refcnt_update(latency_frames[latency_timestamp_no], 1); // it is kept for the repetitions
           while ( !rte_eth_tx_burst(eth_id, 0, &latency_frames[latency_timestamp_no], 1) ); // send latency frame
           send_ts[latency_timestamp_no++]=rte_rdtsc();
           send_next_latency_frame = start_latency_frame + latency_timestamp_no*frames_to_send_during_latency_test/num_timestamps; 
@@ -320,43 +380,43 @@ int sendLatency(void *par) {
       }
   
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      thread_local fastRandom gen(rd());
+      randomRange uni_dis(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
   
-      // create Latency Test Frames (may be foreground frames and background frames as well)
-      struct rte_mbuf ** latency_frames = new struct rte_mbuf *[num_timestamps];
-      if ( !latency_frames )
-        rte_exit(EXIT_FAILURE, "Error: Tester can't allocate memory for latency frame pointers!\n");
+      // create Latency Test Frames (may be foreground frames and background frames as well), unless a previous repetition did so
+      bool reuse = lat_frames->reuse(num_timestamps);
+      struct rte_mbuf ** latency_frames = lat_frames->frames;
   
       uint64_t start_latency_frame = delay*frame_rate; // the ordinal number of the very first latency frame
-      for ( int i=0; i<num_timestamps; i++ )
-        if ( (start_latency_frame+i*frame_rate*latency_test_time/num_timestamps) % n  < m ) {
-          if ( ip_version == 4 ) { 
-            // random IPv4 destination network
-            ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) uni_dis(gen); // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-            latency_frames[i] = mkLatencyFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, 0, 0, i);
+      if ( !reuse )
+        for ( int i=0; i<num_timestamps; i++ )
+          if ( (start_latency_frame+i*frame_rate*latency_test_time/num_timestamps) % n  < m ) {
+            if ( ip_version == 4 ) { 
+              // random IPv4 destination network
+              ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) uni_dis(gen); // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
+              latency_frames[i] = mkLatencyFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, 0, 0, i);
+            } else {
+              // random IPv6 destination network
+              ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
+              latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, 0, 0, i);
+            }
           } else {
-            // random IPv6 destination network
-            ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-            latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, 0, 0, i);
+            // background frame, must be IPv6, choose random network
+            ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
+            latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, 0, 0, i);
           }
-        } else {
-          // background frame, must be IPv6, choose random network
-          ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, 0, 0, i);
-        }
   
       // naive sender version: it is simple and fast
       int latency_timestamp_no=0; // counter for the latency frames from 0 to num_timestamps-1
       uint64_t send_next_latency_frame = start_latency_frame; // at what frame count to send the next latency frame
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
         int index = uni_dis(gen); // index of the pre-generated frame (it will not be used, when a latency frame is sent)
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further two will come!
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // a latency frame is to be sent
+          rte_mbuf_refcnt_update(latency_frames[latency_timestamp_no], 1); // it is kept for the repetitions
           while ( !rte_eth_tx_burst(eth_id, 0, &latency_frames[latency_timestamp_no], 1) ); // send latency frame
           send_ts[latency_timestamp_no++]=rte_rdtsc();
           send_next_latency_frame = start_latency_frame + latency_timestamp_no*frames_to_send_during_latency_test/num_timestamps;
@@ -379,6 +439,7 @@ int sendLatency(void *par) {
       // source and/or destination port number(s) and UDP checksum are updated
       // as for foreground or background frames, N size arrays are used to resolve the write after send problem
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N]; // pointers to the given fields
@@ -389,16 +450,16 @@ int sendLatency(void *par) {
       uint16_t sport, dport; // values of source and destination port numbers -- to be preserved, when increase or decrease is done
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
 
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground Test Frame
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[i] = pkt + 34;
           fg_udp_dport[i] = pkt + 36;
           fg_udp_chksum[i] = pkt + 40;
         } else { // IPv6
-          fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[i] = pkt + 54;
           fg_udp_dport[i] = pkt + 56;
@@ -407,30 +468,31 @@ int sendLatency(void *par) {
 	fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
     
         // create backround Test Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+        bg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
         bg_udp_sport[i] = pkt + 54;
         bg_udp_dport[i] = pkt  + 56;
         bg_udp_chksum[i] = pkt + 60;
         bg_udp_chksum_start = *(uint16_t *)bg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
       } 
-      // create Latency Test Frames (may be foreground frames and background frames as well)
-      struct rte_mbuf ** latency_frames = new struct rte_mbuf *[num_timestamps];
-      if ( !latency_frames )
-        rte_exit(EXIT_FAILURE, "Error: Tester can't allocate memory for latency frame pointers!\n");
+      // create Latency Test Frames (may be foreground frames and background frames as well), unless a previous repetition did so
+      bool reuse = lat_frames->reuse(num_timestamps);
+      struct rte_mbuf ** latency_frames = lat_frames->frames;
   
       uint64_t start_latency_frame = delay*frame_rate; // the ordinal number of the very first latency frame
       for ( int i=0; i<num_timestamps; i++ )
         if ( (start_latency_frame+i*frame_rate*latency_test_time/num_timestamps) % n  < m ) {
 	  // foreground frame, may be IPv4 or IPv6
           if ( ip_version == 4 ) {
-            latency_frames[i] = mkLatencyFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, i);
+            if ( !reuse )
+              latency_frames[i] = mkLatencyFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, i);
             pkt = rte_pktmbuf_mtod(latency_frames[i], uint8_t *); // Access the Test Frame in the message buffer
             lat_udp_sport[i] = pkt + 34;
             lat_udp_dport[i] = pkt + 36;
             lat_udp_chksum[i] = pkt + 40;
           } else { // IPv6
-            latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, i);
+            if ( !reuse )
+              latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, i);
             pkt = rte_pktmbuf_mtod(latency_frames[i], uint8_t *); // Access the Test Frame in the message buffer
             lat_udp_sport[i] = pkt + 54;
             lat_udp_dport[i] = pkt + 56;
@@ -438,13 +500,18 @@ int sendLatency(void *par) {
 	  }
         } else {
           // background frame, must be IPv6
-          latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, i);
+          if ( !reuse )
+            latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, i);
           pkt = rte_pktmbuf_mtod(latency_frames[i], uint8_t *); // Access the Test Frame in the message buffer
           lat_udp_sport[i] = pkt + 54;
           lat_udp_dport[i] = pkt + 56;
           lat_udp_chksum[i] = pkt + 60;
         }
   
+      if ( !reuse )
+        for ( int i=0; i<num_timestamps; i++ )
+          lat_frames->chksum[i] = *(uint16_t *)lat_udp_chksum[i]; // save the uncomplemented checksum values
+  
       // set the starting values of port numbers, if they are increased or decreased
       if ( var_sport == 1 )
         sport = sport_min;
@@ -457,10 +524,10 @@ int sendLatency(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [dport_min, dport_max]
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [dport_min, dport_max]
  
       // naive sender version: it is simple and fast
       i=0; // increase maunally after each sending of a normal Test Frame 
@@ -469,7 +536,7 @@ int sendLatency(void *par) {
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // a latency frame is to be sent
-          chksum = *(uint16_t *)lat_udp_chksum[latency_timestamp_no]; // take the value of the uncomplemented checksum
+          chksum = lat_frames->chksum[latency_timestamp_no]; // take the value of the uncomplemented checksum
           udp_sport = (uint16_t *)lat_udp_sport[latency_timestamp_no];
           udp_dport = (uint16_t *)lat_udp_dport[latency_timestamp_no];
           udp_chksum = (uint16_t *)lat_udp_chksum[latency_timestamp_no];
@@ -477,6 +544,7 @@ int sendLatency(void *par) {
         } else {
           // normal test frame is to be sent
           if ( fg_frame = sent_frames % n  < m ) {
+            fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
             // foreground frame is to be sent
             chksum = fg_udp_chksum_start;
             udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -484,6 +552,7 @@ int sendLatency(void *par) {
             udp_chksum = (uint16_t *)fg_udp_chksum[i];
             pkt_mbuf = fg_pkt_mbuf[i];
           } else {
+            fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
             // background frame is to be sent
             chksum = bg_udp_chksum_start;
             udp_sport = (uint16_t *)bg_udp_sport[i];
@@ -534,15 +603,15 @@ int sendLatency(void *par) {
           chksum = 0xffff;
         *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // the sent frame was a Latency Frame
           send_ts[latency_timestamp_no++]=rte_rdtsc(); // store its sending timestamp
           send_next_latency_frame = start_latency_frame + latency_timestamp_no*frames_to_send_during_latency_test/num_timestamps; 
 	} else {
           // the sent frame was a normal Test Frame
-          i = (i+1) % N;
+          i = (i+1) % fr.copies;
         }
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
@@ -553,6 +622,7 @@ int sendLatency(void *par) {
       // source and/or destination port number(s) and UDP checksum are updated in the actually used copy before sending
       // assertion: num_dest_nets <= 256
       int j; // cycle variable to index the N size array: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[256][N], *bg_pkt_mbuf[256][N],  *pkt_mbuf; // message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[256][N], *fg_udp_dport[256][N], *fg_udp_chksum[256][N]; // pointers to the given fields of the pre-prepared Test Frames
@@ -573,12 +643,12 @@ int sendLatency(void *par) {
         curr_dst_ipv6 = *dst_ipv6;
       curr_dst_bg = *dst_bg;
   
-      for ( j=0; j<N; j++ ) {
+      for ( j=0; j<fr.copies; j++ ) {
         for ( i=0; i<num_dest_nets; i++ ) {
           // create foreground Test Frame
           if ( ip_version == 4 ) {
             ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) i; // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-            fg_pkt_mbuf[i][j] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport);
+            fg_pkt_mbuf[i][j] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport));
             pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
             fg_udp_sport[i][j] = pkt + 34;
             fg_udp_dport[i][j] = pkt + 36;
@@ -586,7 +656,7 @@ int sendLatency(void *par) {
           }
           else { // IPv6
             ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-            fg_pkt_mbuf[i][j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport);
+            fg_pkt_mbuf[i][j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport));
             pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
             fg_udp_sport[i][j] = pkt + 54;
             fg_udp_dport[i][j] = pkt + 56;
@@ -595,7 +665,7 @@ int sendLatency(void *par) {
           fg_udp_chksum_start[i] = *(uint16_t *)fg_udp_chksum[i][j]; // save the uncomplemented checksum value (same for all values of "j")
           // create backround Test Frame (always IPv6)
           ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport);
+          bg_pkt_mbuf[i][j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
           bg_udp_sport[i][j] = pkt + 54;
           bg_udp_dport[i][j] = pkt  + 56;
@@ -605,20 +675,18 @@ int sendLatency(void *par) {
       }
   
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen_net(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [dport_min, dport_max]
+      thread_local fastRandom gen_net(rd());
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [dport_min, dport_max]
  
-      // create Latency Test Frames (may be foreground frames and background frames as well)
-      struct rte_mbuf ** latency_frames = new struct rte_mbuf *[num_timestamps];
-      if ( !latency_frames )
-        rte_exit(EXIT_FAILURE, "Error: Tester can't allocate memory for latency frame pointers!\n");
+      // create Latency Test Frames (may be foreground frames and background frames as well), unless a previous repetition did so
+      bool reuse = lat_frames->reuse(num_timestamps);
+      struct rte_mbuf ** latency_frames = lat_frames->frames;
   
       uint64_t start_latency_frame = delay*frame_rate; // the ordinal number of the very first latency frame
       for ( int i=0; i<num_timestamps; i++ )
@@ -627,7 +695,8 @@ int sendLatency(void *par) {
           if ( ip_version == 4 ) { 
             // random IPv4 destination network
             ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) uni_dis_net(gen_net); // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-            latency_frames[i] = mkLatencyFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport, i);
+            if ( !reuse )
+              latency_frames[i] = mkLatencyFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport, i);
             pkt = rte_pktmbuf_mtod(latency_frames[i], uint8_t *); // Access the Test Frame in the message buffer
             lat_udp_sport[i] = pkt + 34;
             lat_udp_dport[i] = pkt + 36;
@@ -635,7 +704,8 @@ int sendLatency(void *par) {
           } else {
             // random IPv6 destination network
             ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-            latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport, i);
+            if ( !reuse )
+              latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport, i);
             pkt = rte_pktmbuf_mtod(latency_frames[i], uint8_t *); // Access the Test Frame in the message buffer
             lat_udp_sport[i] = pkt + 54;
             lat_udp_dport[i] = pkt + 56;
@@ -644,13 +714,18 @@ int sendLatency(void *par) {
         } else {
           // background frame, must be IPv6, choose random network
           ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport, i);
+          if ( !reuse )
+            latency_frames[i] = mkLatencyFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport, i);
           pkt = rte_pktmbuf_mtod(latency_frames[i], uint8_t *); // Access the Test Frame in the message buffer
           lat_udp_sport[i] = pkt + 54;
           lat_udp_dport[i] = pkt + 56;
           lat_udp_chksum[i] = pkt + 60;
         }
   
+      if ( !reuse )
+        for ( int i=0; i<num_timestamps; i++ )
+          lat_frames->chksum[i] = *(uint16_t *)lat_udp_chksum[i]; // save the uncomplemented checksum values
+  
       // set the starting values of port numbers, if they are increased or decreased
       if ( var_sport == 1 )
         sport = sport_min;
@@ -668,7 +743,7 @@ int sendLatency(void *par) {
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // a latency frame is to be sent
-          chksum = *(uint16_t *)lat_udp_chksum[latency_timestamp_no]; // take the value of the uncomplemented checksum
+          chksum = lat_frames->chksum[latency_timestamp_no]; // take the value of the uncomplemented checksum
           udp_sport = (uint16_t *)lat_udp_sport[latency_timestamp_no];
           udp_dport = (uint16_t *)lat_udp_dport[latency_timestamp_no];
           udp_chksum = (uint16_t *)lat_udp_chksum[latency_timestamp_no];
@@ -677,6 +752,7 @@ int sendLatency(void *par) {
           // normal test frame is to be sent
           int index = uni_dis_net(gen_net); // index of the pre-generated frame 
           if ( fg_frame = sent_frames % n  < m ) {
+            fr.wait(fg_pkt_mbuf[index][i]); // its previous transmission must be completed
             // foreground frame is to be sent
             chksum = fg_udp_chksum_start[index];
             udp_sport = (uint16_t *)fg_udp_sport[index][i];
@@ -684,6 +760,7 @@ int sendLatency(void *par) {
             udp_chksum = (uint16_t *)fg_udp_chksum[index][i];
             pkt_mbuf = fg_pkt_mbuf[index][i];
           } else {
+            fr.wait(bg_pkt_mbuf[index][i]); // its previous transmission must be completed
             // background frame is to be sent
             chksum = bg_udp_chksum_start[index];
             udp_sport = (uint16_t *)bg_udp_sport[index][i];
@@ -734,15 +811,15 @@ int sendLatency(void *par) {
           chksum = 0xffff;
         *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // the sent frame was a Latency Frame
           send_ts[latency_timestamp_no++]=rte_rdtsc(); // store its sending timestamp
           send_next_latency_frame = start_latency_frame + latency_timestamp_no*frames_to_send_during_latency_test/num_timestamps;
         } else {
           // the sent frame was a normal Test Frame
-          i = (i+1) % N;
+          i = (i+1) % fr.copies;
         }
       } // this is the end of the sending cycle
     } // end of optimized code for multiple destination networks
@@ -751,11 +828,12 @@ int sendLatency(void *par) {
   // Now, we check the time
   elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
   if ( elapsed_seconds > duration*TOLERANCE )
     printf("Warning: %s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
-  else
+  else if ( !late )
     printf("%s frames sent: %lu\n", side, sent_frames);
-  return 0;
+  return late;
 }
 
 
@@ -810,6 +888,8 @@ int rsendLatency(void *par) {
   // further local variables
   uint64_t frames_to_send = duration * frame_rate;      // Each active sender sends this number of frames
   uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
   double elapsed_seconds; // for checking the elapsed seconds during sending
   int latency_test_time = duration-delay;	// lenght of the time interval, while latency frames are sent
   uint64_t frames_to_send_during_latency_test = latency_test_time * frame_rate; // precalcalculated value to speed up calculation in the loop
@@ -830,7 +910,7 @@ int rsendLatency(void *par) {
       struct rte_mbuf *fg_pkt_mbuf, *bg_pkt_mbuf; // message buffers for fg. and bg. Test Frames
       // create foreground Test Frame
       if ( ip_version == 4 )
-        fg_pkt_mbuf = mkFinalTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, resp_port, init_port);
+        fg_pkt_mbuf = mkFinalTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, resp_port, init_port, 0);
       else  // IPv6 -- stateful operation is not yet supported!
         fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0);
   
@@ -858,7 +938,7 @@ int rsendLatency(void *par) {
       int latency_timestamp_no=0; // counter for the latency frames from 0 to num_timestamps-1
       uint64_t send_next_latency_frame = start_latency_frame; // at what frame count to send the next latency frame 
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further three will come!
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // a latency frame is to be sent
           while ( !rte_eth_tx_burst(eth_id, 0, &latency_frames[latency_timestamp_no], 1) ); // send latency frame
@@ -872,6 +952,7 @@ int rsendLatency(void *par) {
              while ( !rte_eth_tx_burst(eth_id, 0, &bg_pkt_mbuf, 1) ); // send background frame
         }
       } // this is the end of the sending cycle
+      delete[] latency_frames; // the Latency Frames themselves were released by the PMD
     } // end of optimized code for single flow
     else {
       // optimized code for multiple destination networks  -- only regarding background traffic!
@@ -887,7 +968,7 @@ int rsendLatency(void *par) {
   
       // create foreground Test Frame
       if ( ip_version == 4 ) {
-        fg_pkt_mbuf = mkFinalTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, resp_port, init_port);
+        fg_pkt_mbuf = mkFinalTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, resp_port, init_port, 0);
       }
       else { // IPv6 -- stateful operation is not yet supported!
         fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0);
@@ -899,11 +980,10 @@ int rsendLatency(void *par) {
       }
   
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      thread_local fastRandom gen(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
   
       // create Latency Test Frames (may be foreground frames and background frames as well)
       struct rte_mbuf ** latency_frames = new struct rte_mbuf *[num_timestamps];
@@ -929,7 +1009,7 @@ int rsendLatency(void *par) {
       int latency_timestamp_no=0; // counter for the latency frames from 0 to num_timestamps-1
       uint64_t send_next_latency_frame = start_latency_frame; // at what frame count to send the next latency frame
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further two will come!
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // a latency frame is to be sent
           while ( !rte_eth_tx_burst(eth_id, 0, &latency_frames[latency_timestamp_no], 1) ); // send latency frame
@@ -945,6 +1025,7 @@ int rsendLatency(void *par) {
           }
         }
       } // this is the end of the sending cycle
+      delete[] latency_frames; // the Latency Frames themselves were released by the PMD
     } // end of optimized code for multiple destination networks
   } // end of optimized code for fixed port numbers
   else {
@@ -965,6 +1046,7 @@ int rsendLatency(void *par) {
       // IPv4 addresses, source and destination port number(s) and UDP checksum are updated in the actually used copy.
       // as for foreground or background frames, N size arrays are used to resolve the write after send problem
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N]; // pointers to the given fields
@@ -980,11 +1062,11 @@ int rsendLatency(void *par) {
       uint16_t sport, dport; // values of source and destination port numbers -- to be preserved, when increase or decrease is done
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
 
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground Test Frame
         if ( ip_version == 4 ) {
           // All IPv4 addresses and port numbers are set to 0.
-          fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_rte_ipv4_hdr[i] = pkt + 14;
           fg_ipv4_chksum[i] = pkt + 24;
@@ -994,7 +1076,7 @@ int rsendLatency(void *par) {
           fg_udp_dport[i] = pkt + 36;
           fg_udp_chksum[i] = pkt + 40;
         } else { // IPv6 -- stateful operation is not yet supported!
-          fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[i] = pkt + 54;
           fg_udp_dport[i] = pkt + 56;
@@ -1002,7 +1084,7 @@ int rsendLatency(void *par) {
 	}
 	fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
         // create backround Test Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+        bg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
         bg_udp_sport[i] = pkt + 54;
         bg_udp_dport[i] = pkt  + 56;
@@ -1056,12 +1138,12 @@ int rsendLatency(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_index(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [dport_min, dport_max]
-      std::uniform_int_distribution<unsigned> uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      thread_local fastRandom gen_index(rd());
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [dport_min, dport_max]
+      randomRange uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
  
       // naive sender version: it is simple and fast
       i=0; // increase maunally after each sending of a normal Test Frame 
@@ -1083,6 +1165,7 @@ int rsendLatency(void *par) {
         } else {
           // normal test frame is to be sent
           if ( fg_frame = sent_frames % n  < m ) {
+            fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
             // foreground frame is to be sent
             chksum = fg_udp_chksum_start;
             udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -1094,6 +1177,7 @@ int rsendLatency(void *par) {
             ipv4_dst = (uint32_t *)fg_ipv4_dst[i];        // this is rubbish if IP version is 6
             pkt_mbuf = fg_pkt_mbuf[i];
           } else {
+            fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
             // background frame is to be sent
             chksum = bg_udp_chksum_start;
             udp_sport = (uint16_t *)bg_udp_sport[i];
@@ -1181,17 +1265,20 @@ int rsendLatency(void *par) {
         }
 
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // the sent frame was a Latency Frame
           send_ts[latency_timestamp_no++]=rte_rdtsc(); // store its sending timestamp
           send_next_latency_frame = start_latency_frame + latency_timestamp_no*frames_to_send_during_latency_test/num_timestamps; 
 	} else {
           // the sent frame was a normal Test Frame
-          i = (i+1) % N;
+          i = (i+1) % fr.copies;
         }
       } // this is the end of the sending cycle
+      for ( int k=0; k<num_timestamps; k++ )
+        rte_pktmbuf_free(latency_frames[k]); // they depend on the state table, the repetitions build them again
+      delete[] latency_frames;
     } // end of optimized code for single destination network
     else {
       // optimized code for multiple destination networks: foreground and background frames are generated for each network and pointers are stored in arrays
@@ -1200,6 +1287,7 @@ int rsendLatency(void *par) {
       // source and/or destination port number(s) and UDP checksum are updated in the actually used copy before sending
       // assertion: num_dest_nets <= 256
       int j; // cycle variable to index the N size array: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[256][N], *pkt_mbuf; // message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N]; // pointers to the given fields of the pre-prepared Test Frames
@@ -1220,10 +1308,10 @@ int rsendLatency(void *par) {
   
       curr_dst_bg = *dst_bg;
   
-      for ( j=0; j<N; j++ ) {
+      for ( j=0; j<fr.copies; j++ ) {
         // create foreground Test Frame
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[j] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1);
+          fg_pkt_mbuf[j] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
           fg_rte_ipv4_hdr[j] = pkt + 14;
           fg_ipv4_chksum[j] = pkt + 24;
@@ -1234,7 +1322,7 @@ int rsendLatency(void *par) {
           fg_udp_chksum[j] = pkt + 40;
         }
         else { // IPv6 -- stateful operation is not yet supported!
-          fg_pkt_mbuf[j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+          fg_pkt_mbuf[j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[j] = pkt + 54;
           fg_udp_dport[j] = pkt + 56;
@@ -1244,7 +1332,7 @@ int rsendLatency(void *par) {
         // create backround Test Frame (always IPv6)
         for ( i=0; i<num_dest_nets; i++ ) {
           ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport);
+          bg_pkt_mbuf[i][j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
           bg_udp_sport[i][j] = pkt + 54;
           bg_udp_dport[i][j] = pkt  + 56;
@@ -1254,17 +1342,16 @@ int rsendLatency(void *par) {
       }
   
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen_net(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_index(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [dport_min, dport_max]
-      std::uniform_int_distribution<unsigned> uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
+      thread_local fastRandom gen_net(rd());
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      thread_local fastRandom gen_index(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [dport_min, dport_max]
+      randomRange uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
  
       // create Latency Test Frames (may be foreground frames and background frames as well)
       struct rte_mbuf ** latency_frames = new struct rte_mbuf *[num_timestamps];
@@ -1332,6 +1419,7 @@ int rsendLatency(void *par) {
         } else {
           // normal test frame is to be sent
           if ( fg_frame = sent_frames % n  < m ) {
+            fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
             // foreground frame is to be sent
             chksum = fg_udp_chksum_start;
             udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -1345,6 +1433,7 @@ int rsendLatency(void *par) {
           } else {
             // background frame is to be sent
             int net_index = uni_dis_net(gen_net); // index of the pre-generated frame 
+            fr.wait(bg_pkt_mbuf[net_index][i]); // its previous transmission must be completed
             chksum = bg_udp_chksum_start[net_index];
             udp_sport = (uint16_t *)bg_udp_sport[net_index][i];
             udp_dport = (uint16_t *)bg_udp_dport[net_index][i];
@@ -1431,27 +1520,32 @@ int rsendLatency(void *par) {
         }
 
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
         if ( unlikely( sent_frames == send_next_latency_frame ) ) {
           // the sent frame was a Latency Frame
           send_ts[latency_timestamp_no++]=rte_rdtsc(); // store its sending timestamp
           send_next_latency_frame = start_latency_frame + latency_timestamp_no*frames_to_send_during_latency_test/num_timestamps;
         } else {
           // the sent frame was a normal Test Frame
-          i = (i+1) % N;
+          i = (i+1) % fr.copies;
         }
       } // this is the end of the sending cycle
+      for ( int k=0; k<num_timestamps; k++ )
+        rte_pktmbuf_free(latency_frames[k]); // they depend on the state table, the repetitions build them again
+      delete[] latency_frames;
     } // end of optimized code for multiple destination networks
   } // end of implementation of varying port numbers
 
   // Now, we check the time
   elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
   if ( elapsed_seconds > duration*TOLERANCE )
     rte_exit(EXIT_FAILURE, "%s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
-  printf("%s frames sent: %lu\n", side, sent_frames);
-  return 0;
+  if ( !late )
+    printf("%s frames sent: %lu\n", side, sent_frames);
+  return late;
 }
 
 // receives Test Frames for latency measurements including "num_timestamps" number of Latency frames
@@ -1479,7 +1573,9 @@ int receiveLatency(void *par) {
   uint64_t *id_lat=(uint64_t *) identify_latency;
   uint64_t received=0;  // number of received frames
 
-  while ( rte_rdtsc() < finish_receiving ){
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
     frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
     for (i=0; i < frames; i++){
       uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the Test Frame in the message buffer
@@ -1512,7 +1608,9 @@ int receiveLatency(void *par) {
       }
       rte_pktmbuf_free(pkt_mbufs[i]);
     }
+    polls.count(frames, poll_tsc); // called after processing not to delay the time stamps: receiving includes processing
   }
+  polls.report(side);
   printf("%s frames received: %lu\n", side, received);
   return received;
 }
@@ -1562,7 +1660,10 @@ int rreceiveLatency(void *par) {
   }
 
   // frames are received and their four tuples are recorded, timestamps of latency frames are also recorded
-  while ( rte_rdtsc() < finish_receiving ){
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  polls.lc->state_entries.store(*valid_entries, std::memory_order_relaxed); // 0 in the preliminary phase
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
     frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
     for (i=0; i < frames; i++){
       uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the Test Frame in the message buffer
@@ -1610,7 +1711,11 @@ int rreceiveLatency(void *par) {
       }
       rte_pktmbuf_free(pkt_mbufs[i]);
     }
+    polls.count(frames, poll_tsc); // called after processing not to delay the time stamps: receiving includes processing
+    if ( !*valid_entries ) // preliminary phase: the state table is being filled
+      polls.lc->state_entries.store(fg_received < state_table_size ? fg_received : state_table_size, std::memory_order_relaxed);
   }
+  polls.report(side);
   printf("%s frames received: %lu\n", side, fg_received+bg_received);
   if ( !*valid_entries ) {
     // This one was a preliminary test, the number of valid entries should be reported
@@ -1621,8 +1726,6 @@ int rreceiveLatency(void *par) {
 
 // performs latency measurement
 void Latency::measure(uint16_t leftport, uint16_t rightport) {
-  uint64_t *left_send_ts, *right_send_ts, *left_receive_ts, *right_receive_ts; // pointers for timestamp arrays
-
   // Several parameters are provided to the various sender functions (sendLatency, rsendLatency, isend)
   // and receiver functions (receiveLatency, rreceiveLatency, rreceive) in the following 'struct'-s.
   // They are declared here so that they will not be overwritten in the stack when the program leaves an 'if' block.
@@ -1634,21 +1737,39 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
   rReceiverParameters rrpars;			// used by rreceive() in phase 1 of the stateful test
   rReceiverParametersLatency rrparsL;		// used by rreceiveLatency in phase 2 of the stateful test
   rSenderParametersLatency rsparsL;		// used by rsendLatency() in phase 2 of the stateful test
+  tscOffset fwd_offset(cpu_left_sender, cpu_right_receiver);	// TSC offset of the receiver of the Latency Frames (Forward)
+  tscOffset rev_offset(cpu_right_sender, cpu_left_receiver);	// TSC offset of the receiver of the Latency Frames (Reverse)
+
+  // the receivers may still be zeroing their timestamps used by the previous repetition
+  // (only the receivers of the active directions were launched, the lcores of the others may not even be set)
+  if ( repetition > 1 ) {
+    if ( forward )
+      rte_eal_wait_lcore(cpu_right_receiver);
+    if ( reverse )
+      rte_eal_wait_lcore(cpu_left_receiver);
+    setTimestamps();	// the test starts only after the zeroing is finished
+  }
 
-  // create the dynamic arrays for timestamps depending on which directions are active.
-  if ( forward ) {      // Left to right direction is active
-    // create dynamic arrays for timestamps
-    left_send_ts = new uint64_t[num_timestamps];
-    right_receive_ts = new uint64_t[num_timestamps];
+  // the TSC offsets are measured before the test (and after it, see below)
+  if ( forward )
+    fwd_offset.measure();
+  if ( reverse )
+    rev_offset.measure();
+
+  // create the dynamic arrays for timestamps depending on which directions are active (unless a previous repetition did so).
+  if ( forward && !left_send_ts ) {      // Left to right direction is active
+    // create dynamic arrays for timestamps (on the NUMA nodes of the lcores writing them)
+    left_send_ts = (uint64_t *) rte_malloc_socket("Left Sender's timestamps", sizeof(uint64_t)*num_timestamps, 128, rte_lcore_to_socket_id(cpu_left_sender));
+    right_receive_ts = (uint64_t *) rte_malloc_socket("Right Receiver's timestamps", sizeof(uint64_t)*num_timestamps, 128, rte_lcore_to_socket_id(cpu_right_receiver));
     if ( !left_send_ts || !right_receive_ts )
       rte_exit(EXIT_FAILURE, "Error: Tester can't allocate memory for timestamps!\n");
     // fill with 0 (will be used to chek, if frame with timestamp was received)
     memset(right_receive_ts, 0, num_timestamps*sizeof(uint64_t));
   }
-  if ( reverse ) {      // Right to Left direction is active
-    // create dynamic arrays for timestamps
-    right_send_ts = new uint64_t[num_timestamps];
-    left_receive_ts = new uint64_t[num_timestamps];
+  if ( reverse && !right_send_ts ) {      // Right to Left direction is active
+    // create dynamic arrays for timestamps (on the NUMA nodes of the lcores writing them)
+    right_send_ts = (uint64_t *) rte_malloc_socket("Right Sender's timestamps", sizeof(uint64_t)*num_timestamps, 128, rte_lcore_to_socket_id(cpu_right_sender));
+    left_receive_ts = (uint64_t *) rte_malloc_socket("Left Receiver's timestamps", sizeof(uint64_t)*num_timestamps, 128, rte_lcore_to_socket_id(cpu_left_receiver));
     if ( !right_send_ts || !left_receive_ts )
       rte_exit(EXIT_FAILURE, "Error: Tester can't allocate memory for timestamps!\n");
     // fill with 0 (will be used to chek, if frame with timestamp was received)
@@ -1660,6 +1781,7 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
       {
       // set common parameters for senders
       scpL=senderCommonParametersLatency(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc,delay,num_timestamps);
+      scpL.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
     
       if ( forward ) {      // Left to right direction is active
         // set individual parameters for the left sender
@@ -1672,6 +1794,7 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
         sparsL1=senderParametersLatency(&scpL,ip_left_version,pkt_pool_left_sender,leftport,"Forward",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
                                         ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,num_right_nets,
     				        fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,left_send_ts);
+        sparsL1.lat_frames = &left_frames;
     
         // start left sender
         if ( rte_eal_remote_launch(sendLatency, &sparsL1, cpu_left_sender) )
@@ -1695,6 +1818,7 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
         sparsL2=senderParametersLatency(&scpL,ip_right_version,pkt_pool_right_sender,rightport,"Reverse",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
                                         ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
     			                rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max,right_send_ts);
+        sparsL2.lat_frames = &right_frames;
     
         // start right sender
         if (rte_eal_remote_launch(sendLatency, &sparsL2, cpu_right_sender) )
@@ -1770,6 +1894,7 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
   
       // set common parameters for senders
       scpL=senderCommonParametersLatency(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc,delay,num_timestamps);
+      scpL.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
   
       if ( forward ) {      // Left to right direction is active
 
@@ -1779,6 +1904,7 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
         sparsL1=senderParametersLatency(&scpL,ip_left_version,pkt_pool_left_sender,leftport,"Forward",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
                                         ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,num_right_nets,
                                         fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,left_send_ts);
+        sparsL1.lat_frames = &left_frames;
   
         // start left sender
         if ( rte_eal_remote_launch(sendLatency, &sparsL1, cpu_left_sender) )
@@ -1880,6 +2006,7 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
   
       // set common parameters for senders
       scpL=senderCommonParametersLatency(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc,delay,num_timestamps);
+      scpL.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
   
       if ( reverse) {      // Right to Left direction is active
 
@@ -1889,6 +2016,7 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
         sparsL1=senderParametersLatency(&scpL,ip_right_version,pkt_pool_right_sender,rightport,"Reverse",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
                                         ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
                                         fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,right_send_ts);
+        sparsL1.lat_frames = &right_frames;
   
         // start right sender
         if ( rte_eal_remote_launch(sendLatency, &sparsL1, cpu_right_sender) )
@@ -1946,10 +2074,28 @@ void Latency::measure(uint16_t leftport, uint16_t rightport) {
     
   // Process the timestamps
   int penalty=1000*(duration-delay)+global_timeout; // latency to be reported for lost timestamps, expressed in milliseconds
-  if ( forward )
+  if ( forward ) {
+    fwd_offset.correct(num_timestamps, right_receive_ts, hz, "Forward");
     evaluateLatency(num_timestamps, left_send_ts, right_receive_ts, hz, penalty, "Forward"); 
-  if ( reverse )
+  }
+  if ( reverse ) {
+    rev_offset.correct(num_timestamps, left_receive_ts, hz, "Reverse");
     evaluateLatency(num_timestamps, right_send_ts, left_receive_ts, hz, penalty, "Reverse"); 
+  }
+
+  // the idle receivers zero their timestamps for the next repetition, while the main lcore prepares it
+  if ( repetition < repetitions ) {
+    if ( forward ) {
+      right_clear = clearParameters(right_receive_ts, num_timestamps);
+      if ( rte_eal_remote_launch(clearTimestamps, &right_clear, cpu_right_receiver) )
+        std::cout << "Error: could not start Right Receiver." << std::endl;
+    }
+    if ( reverse ) {
+      left_clear = clearParameters(left_receive_ts, num_timestamps);
+      if ( rte_eal_remote_launch(clearTimestamps, &left_clear, cpu_left_receiver) )
+        std::cout << "Error: could not start Left Receiver." << std::endl;
+    }
+  }
 
 }
 
@@ -1972,9 +2118,11 @@ senderParametersLatency::senderParametersLatency(class senderCommonParameters *c
   senderParameters(cp_,ip_version_,pkt_pool_,eth_id_,side_,dst_mac_,src_mac_,src_ipv4_,dst_ipv4_,src_ipv6_,dst_ipv6_,src_bg_,dst_bg_,num_dest_nets_,
 		  var_sport_,var_dport_,sport_min_,sport_max_,dport_min_,dport_max_) {
   send_ts = send_ts_;
+  lat_frames = 0;
 }
 senderParametersLatency::senderParametersLatency()
 {
+  lat_frames = 0;
 }
 
 rSenderParametersLatency::rSenderParametersLatency(class senderCommonParameters *cp_, int ip_version_, rte_mempool *pkt_pool_, uint16_t eth_id_, const char *side_,
@@ -2032,4 +2180,5 @@ void evaluateLatency(uint16_t num_timestamps, uint64_t *send_ts, uint64_t *recei
   }
   printf("%s TL: %lf\n", side, median_latency); // Typical Latency
   printf("%s WCL: %lf\n", side, worst_case_latency); // Worst Case Latency
+  delete[] latency;
 }
@@ -27,13 +27,28 @@
 #ifndef LATENCY_H_INCLUDED
 #define LATENCY_H_INCLUDED
 
+// the Latency Frames of a stateless sender: they are built by the first measurement and reused by its repetitions
+class latencyFrames {
+public:
+  struct rte_mbuf **frames;	// pointers to the Latency Frames (0: not yet built)
+  uint16_t *chksum;		// their uncomplemented UDP checksums (the field is overwritten when port numbers vary)
+
+  latencyFrames() { frames = 0; chksum = 0; };
+  bool reuse(uint16_t num_timestamps);	// allocates the arrays, if needed; returns true, if the frames are already built
+};
+
 // the main class for latency measurements, adds some features to class Throughput
 class Latency : public Throughput {
 public:
   uint16_t delay;               // time period while frames are sent, but no timestamps are used; then timestaps are used in the "duration-delay" length interval
   uint16_t num_timestamps;      // number of timestamps used, 1-50000 is accepted, RFC 8219 requires at least 500, RFC 2544 requires 1
 
-  Latency() : Throughput() { }; // default constructor
+  // kept for the repetitions of the measurement
+  uint64_t *left_send_ts, *right_send_ts, *left_receive_ts, *right_receive_ts; // timestamp arrays (0: not yet allocated)
+  latencyFrames left_frames, right_frames;	// Latency Frames of the stateless Left and Right senders
+  clearParameters left_clear, right_clear;	// the receive timestamps to be zeroed by the Left and Right receivers
+
+  Latency() : Throughput() { left_send_ts = right_send_ts = left_receive_ts = right_receive_ts = 0; }; // default constructor
   int readCmdLine(int argc, const char *argv[]);	// reads further two arguments
   virtual int senderPoolSize(int numDestNets, int varport);	// adds num_timestamps, too
   virtual int senderPoolSize(int numDestNets, int varport, int ip_varies);	// adds num_timestamps, too
@@ -68,6 +83,7 @@ public:
 class senderParametersLatency : public senderParameters {
 public:
   uint64_t *send_ts;
+  latencyFrames *lat_frames;	// the Latency Frames are built only once
   senderParametersLatency();
   senderParametersLatency(class senderCommonParameters *cp_, int ip_version_, rte_mempool *pkt_pool_, uint16_t eth_id_, const char *side_,
                           struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
@@ -0,0 +1,368 @@
+/* Siitperf is an RFC 8219 SIIT (stateless NAT64) tester written in C++ using DPDK
+ *
+ *  Copyright (C) 2026 Gabor Lencse
+ *
+ *  This file is part of siitperf.
+ *
+ *  Siitperf is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Siitperf is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with siitperf.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// siitperf-bench: offline micro-benchmarks of the hot kernels of siitperf, neither NICs nor a DUT are needed.
+// The EAL is initialized with --no-pci, the receive path uses a software loopback port built from an rte_ring.
+// Each result is printed in a machine-readable line: bench,<kernel>,<variant>,<items>,<cycles per item>
+// (the other lines, e.g. the ones printed by evaluateLatency() and evaluatePdv(), do not start with "bench,").
+
+#include "defines.h"
+#include "includes.h"
+#include "throughput.h"
+#include "latency.h"
+#include "pdv.h"
+
+uint64_t sink; // the results of the kernels are accumulated here, so that the compiler cannot optimize them away
+
+// the addresses of the Test Frames (the same as in the sample configuration file)
+uint8_t dst_mac[6] = { 0xa0, 0x36, 0x9f, 0xc5, 0xfa, 0x1e };
+uint8_t src_mac[6] = { 0xa0, 0x36, 0x9f, 0xc5, 0xfa, 0x1c };
+uint32_t src_ipv4, dst_ipv4;
+struct in6_addr src_ipv6, dst_ipv6;
+
+// prints the result of a benchmark: the number of TSC cycles elapsed since 'start' per processed item
+void report(const char *kernel, const char *variant, uint64_t items, uint64_t start) {
+  uint64_t cycles = rte_rdtsc()-start;
+  printf("bench,%s,%s,%lu,%.2lf\n", kernel, variant, items, (double)cycles/items);
+}
+
+// the functions creating the Test Frames and the templates of the senders (including mbuf allocation and release)
+void benchFrames(rte_mempool *pool) {
+  uint16_t sizes[2] = { 84, 1518 };	// IPv6 frame sizes, the IPv4 frames are 20 bytes shorter
+  char variant[16];
+  uint64_t start, i;
+
+  for ( int s=0; s<2; s++ ) {
+    uint16_t size = sizes[s];
+    snprintf(variant, 16, "%u", size);
+    start = rte_rdtsc();
+    for ( i=0; i<BENCH_FRAMES; i++ )
+      rte_pktmbuf_free(mkTestFrame4(size-20, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv4, &dst_ipv4, 0, 0));
+    report("mkTestFrame4", variant, BENCH_FRAMES, start);
+    start = rte_rdtsc();
+    for ( i=0; i<BENCH_FRAMES; i++ )
+      rte_pktmbuf_free(mkTestFrame6(size, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv6, &dst_ipv6, 0, 0));
+    report("mkTestFrame6", variant, BENCH_FRAMES, start);
+    start = rte_rdtsc();
+    for ( i=0; i<BENCH_FRAMES; i++ )
+      rte_pktmbuf_free(mkVaripTestFrame4(size-20, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv4, &dst_ipv4, 3, 3));
+    report("mkVaripTestFrame4", variant, BENCH_FRAMES, start);
+    start = rte_rdtsc();
+    for ( i=0; i<BENCH_FRAMES; i++ )
+      rte_pktmbuf_free(mkVaripTestFrame6(size, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv6, &dst_ipv6, 3, 3));
+    report("mkVaripTestFrame6", variant, BENCH_FRAMES, start);
+    start = rte_rdtsc();
+    for ( i=0; i<BENCH_FRAMES; i++ )
+      rte_pktmbuf_free(mkFinalTestFrame4(size-20, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv4, &dst_ipv4, 1024, 80, 0));
+    report("mkFinalTestFrame4", variant, BENCH_FRAMES, start);
+  }
+}
+
+// the incremental update of the IPv4 header and UDP checksums after rewriting the varying fields (like in msend())
+// the fields of 'bytes' length are written at the given offsets of the source and destination addresses, and if 'ports'
+// is non-zero, then the port numbers are also rewritten
+void checksumKernel(rte_mempool *pool, int ip_version, unsigned bytes, unsigned offset, int ports, const char *variant) {
+  struct rte_mbuf *pkt_mbuf;	// the Test Frame (its template)
+  uint8_t *pkt, *ip_src, *ip_dst;	// pointers to the frame and to the varying fields of the IP addresses
+  uint16_t *ipv4_chksum, *udp_sport, *udp_dport, *udp_chksum;	// pointers to the fields to be modified
+  uint16_t ipv4_chksum_start, udp_chksum_start;	// uncomplemented checksums taken from the template
+  uint32_t ip_chksum, v4_chksum, chksum;	// temporary variables for the checksum calculation
+  uint64_t start, i;
+
+  if ( ip_version == 4 ) {
+    pkt_mbuf = mkVaripTestFrame4(64, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv4, &dst_ipv4, ports, ports);
+    pkt = rte_pktmbuf_mtod(pkt_mbuf, uint8_t *);
+    ip_src = pkt + 26 + offset;	// 14+12: source IPv4 address
+    ip_dst = pkt + 30 + offset;	// 14+16: destination IPv4 address
+    udp_sport = (uint16_t *)(pkt + 34);
+    udp_dport = (uint16_t *)(pkt + 36);
+    udp_chksum = (uint16_t *)(pkt + 40);
+  } else {
+    pkt_mbuf = mkVaripTestFrame6(84, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv6, &dst_ipv6, ports, ports);
+    pkt = rte_pktmbuf_mtod(pkt_mbuf, uint8_t *);
+    ip_src = pkt + 22 + offset;	// 14+8: source IPv6 address
+    ip_dst = pkt + 38 + offset;	// 14+24: destination IPv6 address
+    udp_sport = (uint16_t *)(pkt + 54);
+    udp_dport = (uint16_t *)(pkt + 56);
+    udp_chksum = (uint16_t *)(pkt + 60);
+  }
+  ipv4_chksum = (uint16_t *)(pkt + 24);	// 14+10: IPv4 header checksum (rubbish, if IPv6)
+  ipv4_chksum_start = ~*ipv4_chksum;
+  udp_chksum_start = *udp_chksum;
+
+  start = rte_rdtsc();
+  for ( i=0; i<BENCH_FRAMES; i++ ) {
+    ip_chksum = setIpField(ip_src, i*0x9e3779b97f4a7c15ull, bytes);	// set src IP field and add to checksum
+    ip_chksum += setIpField(ip_dst, ~i, bytes);			// set dst IP field and add to checksum
+    if ( ip_version == 4 ) {
+      v4_chksum = ipv4_chksum_start + ip_chksum;
+      v4_chksum = ((v4_chksum & 0xffff0000) >> 16) + (v4_chksum & 0xffff);	// calculate 16-bit one's complement sum
+      v4_chksum = ((v4_chksum & 0xffff0000) >> 16) + (v4_chksum & 0xffff);	// twice is enough
+      *ipv4_chksum = (uint16_t) ~v4_chksum;
+    }
+    chksum = udp_chksum_start + ip_chksum;
+    if ( ports ) {
+      chksum += *udp_sport = htons(1024+(uint16_t)i);
+      chksum += *udp_dport = htons(1+(uint16_t)~i);
+    }
+    chksum = ((chksum & 0xffff0000) >> 16) + (chksum & 0xffff);	// calculate 16-bit one's complement sum
+    chksum = ((chksum & 0xffff0000) >> 16) + (chksum & 0xffff);	// twice is enough
+    chksum = (~chksum) & 0xffff;					// make one's complement
+    if ( unlikely( ip_version == 4 && chksum == 0 ) )
+      chksum = 0xffff;
+    *udp_chksum = (uint16_t) chksum;
+  }
+  report("checksum", variant, BENCH_FRAMES, start);
+  sink += *udp_chksum;
+  rte_pktmbuf_free(pkt_mbuf);
+}
+
+void benchChecksums(rte_mempool *pool) {
+  struct rte_mbuf *fg_pkt_mbuf, *bg_pkt_mbuf;	// templates for the table of the destination networks
+  destNetFields *nets;
+  uint64_t start;
+
+  checksumKernel(pool, 4, 2, 2, 0, "ipv4-16bit");
+  checksumKernel(pool, 4, 4, 0, 0, "ipv4-32bit");
+  checksumKernel(pool, 4, 2, 2, 3, "ipv4-16bit-ports");
+  checksumKernel(pool, 6, 2, 14, 0, "ipv6-16bit");
+  checksumKernel(pool, 6, 4, 12, 0, "ipv6-32bit");
+  checksumKernel(pool, 6, 8, 8, 0, "ipv6-64bit");
+  checksumKernel(pool, 6, 2, 14, 3, "ipv6-16bit-ports");
+
+  // the table of the destination networks is computed by incremental checksum updates, too (see send())
+  fg_pkt_mbuf = mkTestFrame4(64, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv4, &dst_ipv4, 0, 0);
+  bg_pkt_mbuf = mkTestFrame6(84, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv6, &dst_ipv6, 0, 0);
+  start = rte_rdtsc();
+  nets = mkDestNets(fg_pkt_mbuf, bg_pkt_mbuf, 4, MAX_DEST_NETS, 0, 0, "Bench");
+  report("mkDestNets", "ipv4", MAX_DEST_NETS, start);
+  sink += nets[MAX_DEST_NETS-1].fg_chksum;
+  rte_free(nets);
+  rte_pktmbuf_free(fg_pkt_mbuf);
+  rte_pktmbuf_free(bg_pkt_mbuf);
+}
+
+// the per-frame pseudorandom number generation paths of the senders and of the Responder
+void benchRandom() {
+  fastRandom gen(0x5eed);
+  popularityParameters zipf(1,1.0,10,90), hot(2,1.0,10,90);
+  popularityDistribution uniform_ports(1024, 65535, 0), zipf_ports(1024, 65535, &zipf), hot_ports(1024, 65535, &hot);
+  randomRange64 range64(0, (1ull << 40) - 1);
+  uint64_t sizes[3] = { 1000000, (1ull << 33) + 1, 0 };	// sizes of the on the fly permutations (0 means 2^64)
+  const char *size_names[3] = { "1000000", "2^33+1", "2^64" };
+  uint64_t buf[RANDOM_BUFFER];
+  uint64_t start, i;
+
+  start = rte_rdtsc();
+  for ( i=0; i<BENCH_FRAMES; i++ )
+    sink += gen();
+  report("random", "xoshiro256**", BENCH_FRAMES, start);
+  start = rte_rdtsc();
+  for ( i=0; i<BENCH_FRAMES; i+=RANDOM_BUFFER ) {
+    gen.fill(buf, RANDOM_BUFFER);
+    sink += buf[RANDOM_BUFFER-1];
+  }
+  report("random", "xoshiro256**-lanes", BENCH_FRAMES, start);
+  start = rte_rdtsc();
+  for ( i=0; i<BENCH_FRAMES; i++ )
+    sink += uniform_ports(gen);
+  report("random", "uniform", BENCH_FRAMES, start);
+  start = rte_rdtsc();
+  for ( i=0; i<BENCH_FRAMES; i++ )
+    sink += zipf_ports(gen);
+  report("random", "zipf", BENCH_FRAMES, start);
+  start = rte_rdtsc();
+  for ( i=0; i<BENCH_FRAMES; i++ )
+    sink += hot_ports(gen);
+  report("random", "hot-set", BENCH_FRAMES, start);
+  start = rte_rdtsc();
+  for ( i=0; i<BENCH_FRAMES; i++ )
+    sink += range64(gen);
+  report("random", "range64", BENCH_FRAMES, start);
+  for ( int s=0; s<3; s++ ) {
+    randomPermutation perm(sizes[s], 0x5eed);
+    start = rte_rdtsc();
+    for ( i=0; i<BENCH_FRAMES; i++ )
+      sink += perm();
+    report("randomPermutation", size_names[s], BENCH_FRAMES, start);
+  }
+}
+
+// the pre-generation of the unique combinations (Enumerate-ports 3 or Enumerate-ips 3)
+void benchPermutations() {
+  uint16_t ranges[3] = { 256, 1024, 4096 };	// randomPermutation32: size of the ranges of the two 16-bit fields
+  uint16_t ranges4[3] = { 16, 32, 64 };		// randomPermutation64: size of the ranges of the four 16-bit fields
+  char variant[32];
+  uint64_t start, size;
+
+  for ( int s=0; s<3; s++ ) {
+    size = (uint64_t)ranges[s]*ranges[s];
+    bits32 *array = new bits32[size];
+    snprintf(variant, 32, "%ux%u", ranges[s], ranges[s]);
+    start = rte_rdtsc();
+    randomPermutation32(array, 1024, 1024+ranges[s]-1, 1, ranges[s]);
+    report("randomPermutation32", variant, size, start);
+    sink += array[size-1].data;
+    delete[] array;
+  }
+  for ( int s=0; s<3; s++ ) {
+    size = (uint64_t)ranges4[s]*ranges4[s]*ranges4[s]*ranges4[s];
+    bits64 *array = new bits64[size];
+    snprintf(variant, 32, "%ux%ux%ux%u", ranges4[s], ranges4[s], ranges4[s], ranges4[s]);
+    start = rte_rdtsc();
+    randomPermutation64(array, 0, ranges4[s]-1, 0, ranges4[s]-1, 1024, 1024+ranges4[s]-1, 1, ranges4[s]);
+    report("randomPermutation64", variant, size, start);
+    sink += array[size-1].data;
+    delete[] array;
+  }
+}
+
+// the classification of the received frames (see receive()) on synthetic bursts: first from memory, then also
+// received from a software loopback port (the frames sent to the port by rte_eth_tx_burst() are received from it)
+void benchReceive(rte_mempool *pool) {
+  struct rte_mbuf *burst[MAX_PKT_BURST], *pkt_mbufs[MAX_PKT_BURST];
+  struct rte_eth_conf cfg_port;
+  struct rte_ring *ring;
+  int port, sent, frames, i;
+  uint64_t start, b, received=0;
+
+  // a mix of IPv4 and IPv6 UDP and TCP Test Frames, and some frames that are not Test Frames
+  for ( i=0; i<MAX_PKT_BURST; i++ ) {
+    switch ( i%4 ) {
+      case 0:
+        burst[i] = mkTestFrame4(64, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv4, &dst_ipv4, 0, 0);
+        break;
+      case 1:
+        burst[i] = mkTestFrame6(84, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv6, &dst_ipv6, 0, 0);
+        break;
+      case 2:
+        burst[i] = mkTestFrame4(76, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv4, &dst_ipv4, 0, 0, RTE_TCP_ACK_FLAG);
+        break;
+      default:
+        burst[i] = mkTestFrame6(84, pool, "Bench", (ether_addr *)dst_mac, (ether_addr *)src_mac, &src_ipv6, &dst_ipv6, 0, 0);
+        if ( i%8 == 7 )
+          *rte_pktmbuf_mtod_offset(burst[i], uint16_t *, 12) = htons(0x0806); // ARP EtherType: not a Test Frame
+    }
+  }
+
+  start = rte_rdtsc();
+  for ( b=0; b<BENCH_FRAMES/MAX_PKT_BURST; b++ )
+    for ( i=0; i<MAX_PKT_BURST; i++ )
+      received += isTestFrame(rte_pktmbuf_mtod(burst[i], uint8_t *));
+  report("receive", "classification", b*MAX_PKT_BURST, start);
+
+  ring = rte_ring_create("bench_loopback", CALIBRATION_RING_SIZE, rte_socket_id(), RING_F_SP_ENQ | RING_F_SC_DEQ);
+  if ( !ring || (port = rte_eth_from_rings("bench_loopback", &ring, 1, &ring, 1, rte_socket_id())) < 0 )
+    rte_exit(EXIT_FAILURE, "Error: Cannot create software loopback port, siitperf-bench exits.\n");
+  memset(&cfg_port, 0, sizeof(cfg_port));
+  if ( rte_eth_dev_configure(port, 1, 1, &cfg_port) < 0 ||
+       rte_eth_tx_queue_setup(port, 0, PORT_TX_QUEUE_SIZE, rte_socket_id(), NULL) < 0 ||
+       rte_eth_rx_queue_setup(port, 0, PORT_RX_QUEUE_SIZE, rte_socket_id(), NULL, pool) < 0 ||
+       rte_eth_dev_start(port) < 0 )
+    rte_exit(EXIT_FAILURE, "Error: Cannot set up software loopback port, siitperf-bench exits.\n");
+  start = rte_rdtsc();
+  for ( b=0; b<BENCH_FRAMES/MAX_PKT_BURST; b++ ) {
+    for ( i=0; i<MAX_PKT_BURST; i++ )
+      rte_mbuf_refcnt_update(burst[i], 1);	// this one is released by the receiver (like at frameReuse)
+    sent = rte_eth_tx_burst(port, 0, burst, MAX_PKT_BURST);
+    for ( i=sent; i<MAX_PKT_BURST; i++ )
+      rte_mbuf_refcnt_update(burst[i], -1);
+    frames = rte_eth_rx_burst(port, 0, pkt_mbufs, MAX_PKT_BURST);
+    for ( i=0; i<frames; i++ ) {
+      if ( likely( isTestFrame(rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *)) ) )
+        received++;
+      rte_pktmbuf_free(pkt_mbufs[i]);
+    }
+  }
+  report("receive", "loopback-port", b*MAX_PKT_BURST, start);
+  sink += received;
+  rte_eth_dev_stop(port);
+  for ( i=0; i<MAX_PKT_BURST; i++ )
+    rte_pktmbuf_free(burst[i]);
+}
+
+// the evaluation of the time stamps by siitperf-lat and siitperf-pdv on large arrays (about 0.1% of the frames are lost)
+void benchEvaluate(uint64_t hz) {
+  uint64_t num = 10*BENCH_FRAMES;	// e.g. 10 seconds at 1Mfps for siitperf-pdv
+  uint16_t num_lat = 50000;		// the highest number of time stamps of siitperf-lat (uint16_t)
+  uint64_t *send_ts = new uint64_t[num];
+  uint64_t *receive_ts = new uint64_t[num];
+  fastRandom gen(0x5eed);
+  uint64_t start, i;
+
+  for ( i=0; i<num; i++ ) {
+    send_ts[i] = i*hz/1000000;
+    receive_ts[i] = gen() % 1000 ? send_ts[i] + hz/100000 + gen() % (hz/100000) : 0; // 10-20us delay or lost
+  }
+  start = rte_rdtsc();
+  evaluateLatency(num_lat, send_ts, receive_ts, hz, 1000, "Bench");
+  report("evaluateLatency", "50000", num_lat, start);
+  start = rte_rdtsc();
+  evaluatePdv(num, send_ts, receive_ts, hz, 0, 1000, "Bench");
+  report("evaluatePdv", "pdv", num, start);
+  start = rte_rdtsc();
+  evaluatePdv(num, send_ts, receive_ts, hz, 10, 1000, "Bench");
+  report("evaluatePdv", "frame-timeout", num, start);
+  delete[] send_ts;
+  delete[] receive_ts;
+}
+
+int main(int argc, const char **argv) {
+  const char *rte_argv[5]; // parameters for DPDK EAL init: {NULL, "-l", "2", "--no-pci", NULL};
+  rte_mempool *pool;	// packet pool for the Test Frames
+  uint64_t hz;		// number of clock cycles per second
+
+  if ( argc > 2 ) {
+    std::cerr << "Usage: " << argv[0] << " [<lcore>]" << std::endl;
+    return -1;
+  }
+  rte_argv[0] = argv[0];
+  rte_argv[1] = "-l";
+  rte_argv[2] = argc == 2 ? argv[1] : "0";	// the lcore executing the benchmarks
+  rte_argv[3] = "--no-pci";			// no NICs are needed
+  rte_argv[4] = 0;
+  if ( rte_eal_init(4, const_cast<char **>(rte_argv)) < 0 ) {
+    std::cerr << "Error: DPDK RTE initialization failed, siitperf-bench exits." << std::endl;
+    return -1;
+  }
+  pool = rte_pktmbuf_pool_create("pp_bench", BENCH_POOL_SIZE, PKTPOOL_CACHE, 0, RTE_MBUF_DEFAULT_BUF_SIZE, rte_socket_id());
+  if ( !pool ) {
+    std::cerr << "Error: Cannot create packet pool, siitperf-bench exits." << std::endl;
+    return -1;
+  }
+  inet_pton(AF_INET, "198.18.0.2", &src_ipv4);
+  inet_pton(AF_INET, "198.19.0.2", &dst_ipv4);
+  inet_pton(AF_INET6, "2001:2::2", &src_ipv6);
+  inet_pton(AF_INET6, "2001:2:0:8000::2", &dst_ipv6);
+  hz = rte_get_timer_hz();
+  printf("Info: TSC frequency: %lu Hz\n", hz);
+  printf("bench,kernel,variant,items,cycles_per_item\n");
+
+  benchFrames(pool);
+  benchChecksums(pool);
+  benchRandom();
+  benchPermutations();
+  benchReceive(pool);
+  benchEvaluate(hz);
+
+  printf("Info: checksum of the results: %lu\n", sink);
+  rte_eal_cleanup();
+  return 0;
+}
@@ -32,6 +32,10 @@ int main(int argc, const char **argv) {
      return -1;
   if ( tester.init(argv[0],LEFTPORT,RIGHTPORT) < 0 )
      return -1;
-  tester.measure(LEFTPORT,RIGHTPORT);
+  for ( unsigned k=1; k<=tester.repetitions; k++ ) {
+    tester.prepareRepetition(k);
+    tester.measure(LEFTPORT,RIGHTPORT);
+  }
+  tester.freeUniqueCombinations();
 }
 
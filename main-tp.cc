@@ -29,7 +29,30 @@ int main(int argc, const char **argv) {
     return -1;
   if ( tester.readCmdLine(argc,argv) < 0 )
      return -1;
+  if ( tester.combined ) {
+    std::cerr << "Input Error: 'Combined' is supported by siitperf-pdv only." << std::endl;
+    return -1;
+  }
+  if ( tester.repetitions > 1 ) {
+    std::cerr << "Input Error: 'Repetitions' is supported by siitperf-lat and siitperf-pdv only." << std::endl;
+    return -1;
+  }
   if ( tester.init(argv[0],LEFTPORT,RIGHTPORT) < 0 )
      return -1;
-  tester.measure(LEFTPORT,RIGHTPORT);
+  switch ( tester.search_mode ) {
+    case 0:
+      if ( tester.calibrate )
+        tester.calibrationSearch(LEFTPORT,RIGHTPORT);
+      else {
+        tester.measure(LEFTPORT,RIGHTPORT);
+        tester.freeUniqueCombinations();
+      }
+      break;
+    case 1:
+      tester.cttcSearch(LEFTPORT,RIGHTPORT);
+      break;
+    case 2:
+      tester.rateSearch(LEFTPORT,RIGHTPORT);
+      break;
+  }
 }
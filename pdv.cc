@@ -39,6 +39,47 @@ int Pdv::readCmdLine(int argc, const char *argv[]) {
   if ( Throughput::readCmdLine(argc-1,argv) < 0 )
     return -1;
 
+  if ( responder_echo ) {
+    std::cerr << "Input Error: 'Responder-echo' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( search_mode ) {
+    std::cerr << "Input Error: 'Search-mode' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( popularity.type ) {
+    std::cerr << "Input Error: 'Popularity' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( port_pairs > 1 ) {
+    std::cerr << "Input Error: Multiple port pairs are supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( schedule ) {
+    std::cerr << "Input Error: 'Schedule' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( pipeline ) {
+    std::cerr << "Input Error: 'Pipeline' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( imix.sizes ) {
+    std::cerr << "Input Error: 'IMIX' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( tcp ) {
+    std::cerr << "Input Error: 'TCP' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( num_left_nets > MAX_PREGEN_NETS || num_right_nets > MAX_PREGEN_NETS ) {
+    std::cerr << "Input Error: More than " << MAX_PREGEN_NETS << " destination networks are supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+  if ( calibrate ) {
+    std::cerr << "Input Error: 'Calibrate' is supported by siitperf-tp only." << std::endl;
+    return -1;
+  }
+
   if ( !stateful )
     numThroughputPars=6;        // stateless throughput test uses 6 parameters
   else
@@ -199,13 +240,21 @@ int sendPdv(void *par) {
 
   uint64_t frames_to_send = duration * frame_rate;      // Each active sender sends this number of packets
   uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
   double elapsed_seconds; // for checking the elapsed seconds during sending
 
-  // prepare a NUMA local, cache line aligned array for send timestamps
-  uint64_t *snd_ts = (uint64_t *) rte_malloc(0, 8*frames_to_send, 128);
-  if ( !snd_ts )
-      rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for timestamps!\n");
-  *send_ts = snd_ts; // return the address of the array to the caller function
+  // prepare a NUMA local, cache line aligned array for send timestamps (not needed by the combined measurement)
+  uint64_t *snd_ts = 0;
+  if ( send_ts ) {
+    snd_ts = *send_ts; // the array of the previous repetition is reused
+    if ( !snd_ts ) {
+      snd_ts = (uint64_t *) rte_malloc(0, 8*frames_to_send, 128);
+      if ( !snd_ts )
+          rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for timestamps!\n");
+      *send_ts = snd_ts; // return the address of the array to the caller function
+    }
+  }
 
   bool fg_frame, ipv4_frame; // when sending IPv4 traffic, background frames are IPv6: their UDP checksum may be 0.
   uint32_t chksum; 	// temporary variable for shecksum calculation
@@ -218,28 +267,29 @@ int sendPdv(void *par) {
       // but it is updated regarding counter and UDP checksum
       // N size arrays are used to resolve the write after send problem
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. PDV Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_chksum[N], *bg_udp_chksum[N], *fg_counter[N], *bg_counter[N]; 	// pointers to the given fields
       uint16_t fg_udp_chksum_start, bg_udp_chksum_start; 	// starting values (uncomplemented checksums taken from the original frames)
   
       // create PDV Test Frames 
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground PDV Frame (IPv4 or IPv6)
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[i] = mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0);
+          fg_pkt_mbuf[i] = fr.add(mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_chksum[i] = pkt + 40;
           fg_counter[i] = pkt + 50;
         } else { // IPv6
-          fg_pkt_mbuf[i] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0);
+          fg_pkt_mbuf[i] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_chksum[i] = pkt + 60;
           fg_counter[i] = pkt + 70;
         }
         fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
         // create backround PDV Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0);
+        bg_pkt_mbuf[i] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
         bg_udp_chksum[i] = pkt + 60;
         bg_counter[i] = pkt + 70;
@@ -250,12 +300,14 @@ int sendPdv(void *par) {
       i=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ) {	// Main cycle for the number of frames to send
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
           // foreground frame is to be sent
           *(uint64_t *)fg_counter[i] = sent_frames;	// set the counter in the frame
           chksum = fg_udp_chksum_start;
           chksump = (uint16_t *)fg_udp_chksum[i];
           pkt_mbuf = fg_pkt_mbuf[i];
         } else {
+          fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
           // background frame is to be sent
           *(uint64_t *)bg_counter[i] = sent_frames;	// set the counter in the frame
           chksum = bg_udp_chksum_start;
@@ -270,10 +322,11 @@ int sendPdv(void *par) {
         if ( unlikely( ipv4_frame && chksum == 0 ) )	// over IPv4, checksum should not be 0 (0 means, no checksum is used)
           chksum = 0xffff;
         *chksump = (uint16_t) chksum;		// set checksum in the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); 	// Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) ); 		// send out the frame
-        snd_ts[sent_frames] = rte_rdtsc();				// store timestamp
-        i = (i+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf); 		// send out the frame
+        if ( snd_ts )
+          snd_ts[sent_frames] = rte_rdtsc();			// store timestamp
+        i = (i+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
     else {
@@ -282,6 +335,7 @@ int sendPdv(void *par) {
       // N size arrays are used to resolve the write after send problem
       int j; // cycle variable for the above mentioned purpose: takes {0..N-1} values
       // num_dest_nets <= 256
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[256][N], *bg_pkt_mbuf[256][N], *pkt_mbuf; // pointers of message buffers for fg. and bg. PDV Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_chksum[256][N], *bg_udp_chksum[256][N], *fg_counter[256][N], *bg_counter[256][N];   // pointers to the given fields
@@ -297,19 +351,19 @@ int sendPdv(void *par) {
       curr_dst_bg = *dst_bg;
   
       // create PDV Test Frames
-      for ( j=0; j<N; j++ ) {
+      for ( j=0; j<fr.copies; j++ ) {
         // create foreground PDV Frame (IPv4 or IPv6)
         for ( i=0; i<num_dest_nets; i++ ) {
           if ( ip_version == 4 ) {
             ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) i; // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-            fg_pkt_mbuf[i][j] = mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, 0, 0);
+            fg_pkt_mbuf[i][j] = fr.add(mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, 0, 0));
             pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the PDV Frame in the message buffer
             fg_udp_chksum[i][j] = pkt + 40;
             fg_counter[i][j] = pkt + 50;
           }
           else { // IPv6
             ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-            fg_pkt_mbuf[i][j] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, 0, 0);
+            fg_pkt_mbuf[i][j] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, 0, 0));
             pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the PDV Frame in the message buffer
             fg_udp_chksum[i][j] = pkt + 60;
             fg_counter[i][j] = pkt + 70;
@@ -317,7 +371,7 @@ int sendPdv(void *par) {
           fg_udp_chksum_start[i] = *(uint16_t *)fg_udp_chksum[i][j]; // save the uncomplemented checksum value (same for all values of "j")
           // create backround Test Frame (always IPv6)
           ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, 0, 0);
+          bg_pkt_mbuf[i][j] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, 0, 0));
           pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the PDV Frame in the message buffer
           bg_udp_chksum[i][j] = pkt + 60;
           bg_counter[i][j] = pkt + 70;
@@ -326,23 +380,24 @@ int sendPdv(void *par) {
       }
   
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      thread_local fastRandom gen(rd());
+      randomRange uni_dis(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
   
       // naive sender version: it is simple and fast
       j=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ 	// Main cycle for the number of frames to send
         int index = uni_dis(gen); // index of the pre-generated frame 
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[index][j]); // its previous transmission must be completed
           // foreground frame is to be sent
           *(uint64_t *)fg_counter[index][j] = sent_frames;                      // set the counter in the frame
           chksum = fg_udp_chksum_start[index];
           chksump = (uint16_t *)fg_udp_chksum[index][j];
           pkt_mbuf = fg_pkt_mbuf[index][j];
         } else {
+          fr.wait(bg_pkt_mbuf[index][j]); // its previous transmission must be completed
           // background frame is to be sent
           *(uint64_t *)bg_counter[index][j] = sent_frames;                      // set the counter in the frame
           chksum = bg_udp_chksum_start[index];
@@ -357,10 +412,11 @@ int sendPdv(void *par) {
         if ( unlikely( ipv4_frame && chksum == 0 ) )    // over IPv4, checksum should not be 0 (0 means, no checksum is used)
           chksum = 0xffff;
         *chksump = (uint16_t) chksum;           // set checksum in the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        snd_ts[sent_frames] = rte_rdtsc();                              // store timestamp
-        j = (j+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        if ( snd_ts )
+          snd_ts[sent_frames] = rte_rdtsc();			// store timestamp
+        j = (j+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for multiple destination networks
   } // end of optimized code for fixed port numbers
@@ -372,6 +428,7 @@ int sendPdv(void *par) {
       // but it is updated regarding counter, source and/or destination port number(s) and UDP checksum
       // N size arrays are used to resolve the write after send problem
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. PDV Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *fg_counter[N]; // pointers to the given fields
@@ -383,17 +440,17 @@ int sendPdv(void *par) {
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
 
       // create PDV Test Frames 
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground PDV Frame (IPv4 or IPv6)
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[i] = mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_sport[i] = pkt + 34;
           fg_udp_dport[i] = pkt + 36;
           fg_udp_chksum[i] = pkt + 40;
           fg_counter[i] = pkt + 50;
         } else { // IPv6
-          fg_pkt_mbuf[i] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_sport[i] = pkt + 54;
           fg_udp_dport[i] = pkt + 56;
@@ -402,7 +459,7 @@ int sendPdv(void *par) {
         }
         fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
         // create backround PDV Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+        bg_pkt_mbuf[i] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
         bg_udp_sport[i] = pkt + 54;
         bg_udp_dport[i] = pkt  + 56;
@@ -423,16 +480,17 @@ int sendPdv(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
  
       // naive sender version: it is simple and fast
       i=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ) {	// Main cycle for the number of frames to send
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start;
           udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -441,6 +499,7 @@ int sendPdv(void *par) {
           counter = (uint64_t *)fg_counter[i];
           pkt_mbuf = fg_pkt_mbuf[i];
         } else {
+          fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
           // background frame is to be sent
           chksum = bg_udp_chksum_start;
           udp_sport = (uint16_t *)bg_udp_sport[i];
@@ -496,10 +555,11 @@ int sendPdv(void *par) {
           chksum = 0xffff;
         *udp_chksum = (uint16_t) chksum;                // set checksum in the frame
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        snd_ts[sent_frames] = rte_rdtsc();                              // store timestamp
-        i = (i+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        if ( snd_ts )
+          snd_ts[sent_frames] = rte_rdtsc();			// store timestamp
+        i = (i+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
     else {
@@ -508,6 +568,7 @@ int sendPdv(void *par) {
       // N size arrays are used to resolve the write after send problem
       int j; // cycle variable for the above mentioned purpose: takes {0..N-1} values
       // num_dest_nets <= 256
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[256][N], *bg_pkt_mbuf[256][N], *pkt_mbuf; // pointers of message buffers for fg. and bg. PDV Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[256][N], *fg_udp_dport[256][N], *fg_udp_chksum[256][N], *fg_counter[256][N]; // pointers to the given fields
@@ -529,12 +590,12 @@ int sendPdv(void *par) {
       curr_dst_bg = *dst_bg;
   
       // create PDV Test Frames
-      for ( j=0; j<N; j++ ) {
+      for ( j=0; j<fr.copies; j++ ) {
         // create foreground PDV Frame (IPv4 or IPv6)
         for ( i=0; i<num_dest_nets; i++ ) {
           if ( ip_version == 4 ) {
             ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) i; // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-            fg_pkt_mbuf[i][j] = mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport);
+            fg_pkt_mbuf[i][j] = fr.add(mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport));
             pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the PDV Frame in the message buffer
             fg_udp_sport[i][j] = pkt + 34;
             fg_udp_dport[i][j] = pkt + 36;
@@ -543,7 +604,7 @@ int sendPdv(void *par) {
           }
           else { // IPv6
             ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-            fg_pkt_mbuf[i][j] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport);
+            fg_pkt_mbuf[i][j] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport));
             pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the PDV Frame in the message buffer
             fg_udp_sport[i][j] = pkt + 54;
             fg_udp_dport[i][j] = pkt + 56;
@@ -553,7 +614,7 @@ int sendPdv(void *par) {
           fg_udp_chksum_start[i] = *(uint16_t *)fg_udp_chksum[i][j]; // save the uncomplemented checksum value (same for all values of "j")
           // create backround Test Frame (always IPv6)
           ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport);
+          bg_pkt_mbuf[i][j] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the PDV Frame in the message buffer
           bg_udp_sport[i][j] = pkt + 54;
           bg_udp_dport[i][j] = pkt  + 56;
@@ -574,15 +635,14 @@ int sendPdv(void *par) {
         dport = dport_max;
 
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen_net(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
+      thread_local fastRandom gen_net(rd());
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
   
       // naive sender version: it is simple and fast
       j=0; // increase maunally after each sending
@@ -590,6 +650,7 @@ int sendPdv(void *par) {
         int index = uni_dis_net(gen_net); // index of the pre-generated frame 
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[index][j]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start[index];
           udp_sport = (uint16_t *)fg_udp_sport[index][j];
@@ -598,6 +659,7 @@ int sendPdv(void *par) {
           counter = (uint64_t *)fg_counter[index][j];
           pkt_mbuf = fg_pkt_mbuf[index][j];
         } else {
+          fr.wait(bg_pkt_mbuf[index][j]); // its previous transmission must be completed
           // background frame is to be sent
           chksum = bg_udp_chksum_start[index];
           udp_sport = (uint16_t *)bg_udp_sport[index][j];
@@ -653,21 +715,23 @@ int sendPdv(void *par) {
           chksum = 0xffff;
         *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        snd_ts[sent_frames] = rte_rdtsc();                            	// store timestamp
-        j = (j+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        if ( snd_ts )
+          snd_ts[sent_frames] = rte_rdtsc();			// store timestamp
+        j = (j+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for multiple destination networks
   } // end of implementation of varying port numbers
   // Now, we check the time
   elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
   if ( elapsed_seconds > duration*TOLERANCE )
     printf("Error: %s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
-  else
+  else if ( !late )
     printf("%s frames sent: %lu\n", side, sent_frames);
-  return 0;
+  return late;
 }
 
 // Responder/Sender: sends Test Frames for PDV measurements
@@ -716,13 +780,21 @@ int rsendPdv(void *par) {
 
   uint64_t frames_to_send = duration * frame_rate;      // Each active sender sends this number of packets
   uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
   double elapsed_seconds; // for checking the elapsed seconds during sending
 
-  // prepare a NUMA local, cache line aligned array for send timestamps
-  uint64_t *snd_ts = (uint64_t *) rte_malloc(0, 8*frames_to_send, 128);
-  if ( !snd_ts )
-      rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for timestamps!\n");
-  *send_ts = snd_ts; // return the address of the array to the caller function
+  // prepare a NUMA local, cache line aligned array for send timestamps (not needed by the combined measurement)
+  uint64_t *snd_ts = 0;
+  if ( send_ts ) {
+    snd_ts = *send_ts; // the array of the previous repetition is reused
+    if ( !snd_ts ) {
+      snd_ts = (uint64_t *) rte_malloc(0, 8*frames_to_send, 128);
+      if ( !snd_ts )
+          rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for timestamps!\n");
+      *send_ts = snd_ts; // return the address of the array to the caller function
+    }
+  }
 
   unsigned index;       // current state table index for reading a 4-tuple (used when 'responder-ports' is 1 or 2)
   fourTuple ft;         // 4-tuple is read from the state table into this
@@ -742,6 +814,7 @@ int rsendPdv(void *par) {
       // but it is updated regarding counter and UDP checksum
       // N size arrays are used to resolve the write after send problem
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. PDV Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_chksum[N], *bg_udp_chksum[N], *fg_counter[N], *bg_counter[N]; 	// pointers to the given fields
@@ -749,22 +822,22 @@ int rsendPdv(void *par) {
       uint32_t chksum; // temporary variable for shecksum calculation
   
       // create PDV Test Frames 
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground PDV Frame (IPv4 or IPv6)
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[i] = mkFinalPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, resp_port, init_port);
+          fg_pkt_mbuf[i] = fr.add(mkFinalPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, resp_port, init_port));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_chksum[i] = pkt + 40;
           fg_counter[i] = pkt + 50;
         } else { // IPv6 -- stateful operation is not yet supported!
-          fg_pkt_mbuf[i] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0);
+          fg_pkt_mbuf[i] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_chksum[i] = pkt + 60;
           fg_counter[i] = pkt + 70;
         }
         fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
         // create backround PDV Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+        bg_pkt_mbuf[i] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
         bg_udp_chksum[i] = pkt + 60;
         bg_counter[i] = pkt + 70;
@@ -775,12 +848,14 @@ int rsendPdv(void *par) {
       i=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ) {	// Main cycle for the number of frames to send
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
           // foreground frame is to be sent
           *(uint64_t *)fg_counter[i] = sent_frames;			// set the counter in the frame 
           chksum = fg_udp_chksum_start;
           chksump = (uint16_t *)fg_udp_chksum[i];
           pkt_mbuf = fg_pkt_mbuf[i];
         } else {
+          fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
           // background frame is to be sent
           *(uint64_t *)bg_counter[i] = sent_frames;			// set the counter in the frame 
           chksum = bg_udp_chksum_start;
@@ -795,10 +870,11 @@ int rsendPdv(void *par) {
         if ( unlikely( ipv4_frame && chksum == 0 ) )    // over IPv4, checksum should not be 0 (0 means, no checksum is used)
           chksum = 0xffff;
         *chksump = (uint16_t) chksum;                   // set checksum in the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );  // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );   // send background frame
-        snd_ts[sent_frames] = rte_rdtsc();                            // store timestamp
-        i = (i+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);   // send background frame
+        if ( snd_ts )
+          snd_ts[sent_frames] = rte_rdtsc();			// store timestamp
+        i = (i+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
     else {
@@ -809,6 +885,7 @@ int rsendPdv(void *par) {
       // N size arrays are used to resolve the write after send problem
       int j; // cycle variable for the above mentioned purpose: takes {0..N-1} values
       // num_dest_nets <= 256
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[256][N], *pkt_mbuf; // pointers of message buffers for fg. and bg. PDV Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_chksum[N], *bg_udp_chksum[256][N], *fg_counter[N], *bg_counter[256][N];   // pointers to the given fields
@@ -821,16 +898,16 @@ int rsendPdv(void *par) {
       curr_dst_bg = *dst_bg;
   
       // create PDV Test Frames
-      for ( j=0; j<N; j++ ) {
+      for ( j=0; j<fr.copies; j++ ) {
         // create foreground PDV Frame (IPv4 or IPv6)
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[j] = mkFinalPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, resp_port, init_port);
+          fg_pkt_mbuf[j] = fr.add(mkFinalPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, resp_port, init_port));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_chksum[j] = pkt + 40;
           fg_counter[j] = pkt + 50;
         }
         else { // IPv6 -- stateful operation is not yet supported!
-          fg_pkt_mbuf[j] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0); // garbage
+          fg_pkt_mbuf[j] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0)); // garbage
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_chksum[j] = pkt + 60;
           fg_counter[j] = pkt + 70;
@@ -840,7 +917,7 @@ int rsendPdv(void *par) {
         for ( i=0; i<num_dest_nets; i++ ) {
           // create backround Test Frame (always IPv6)
           ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport);
+          bg_pkt_mbuf[i][j] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the PDV Frame in the message buffer
           bg_udp_chksum[i][j] = pkt + 60;
           bg_counter[i][j] = pkt + 70;
@@ -849,16 +926,16 @@ int rsendPdv(void *par) {
       }
   
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      thread_local fastRandom gen(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
   
       // naive sender version: it is simple and fast
       j=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ 	// Main cycle for the number of frames to send
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[j]); // its previous transmission must be completed
           *(uint64_t *)fg_counter[j] = sent_frames;                        	// set the counter in the frame
           chksum = fg_udp_chksum_start;
           chksump = (uint16_t *)fg_udp_chksum[j];
@@ -866,6 +943,7 @@ int rsendPdv(void *par) {
         } else {
           // background frame is to be sent
           int index = uni_dis_net(gen); // index of the pre-generated frame 
+          fr.wait(bg_pkt_mbuf[index][j]); // its previous transmission must be completed
           *(uint64_t *)bg_counter[index][j] = sent_frames;                      // set the counter in the frame
           chksum = bg_udp_chksum_start[index];
           chksump = (uint16_t *)bg_udp_chksum[index][j];
@@ -879,10 +957,11 @@ int rsendPdv(void *par) {
         if ( unlikely( ipv4_frame && chksum == 0 ) )    // over IPv4, checksum should not be 0 (0 means, no checksum is used)
           chksum = 0xffff;
         *chksump = (uint16_t) chksum;                   // set checksum in the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        snd_ts[sent_frames] = rte_rdtsc();                              // store timestamp
-        j = (j+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        if ( snd_ts )
+          snd_ts[sent_frames] = rte_rdtsc();			// store timestamp
+        j = (j+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for multiple destination networks
   } // end of optimized code for fixed port numbers
@@ -903,6 +982,7 @@ int rsendPdv(void *par) {
       // but it is updated regarding counter, source and/or destination port number(s) and UDP checksum
       // N size arrays are used to resolve the write after send problem
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. PDV Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *fg_counter[N]; // pointers to the given fields
@@ -918,11 +998,11 @@ int rsendPdv(void *par) {
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
 
       // create PDV Test Frames 
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground PDV Frame (IPv4 or IPv6)
         if ( ip_version == 4 ) {
           // All IPv4 addresses and port numbers are set to 0.
-          fg_pkt_mbuf[i] = mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1);
+          fg_pkt_mbuf[i] = fr.add(mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
           fg_rte_ipv4_hdr[i] = pkt + 14;
           fg_ipv4_chksum[i] = pkt + 24;
@@ -933,7 +1013,7 @@ int rsendPdv(void *par) {
           fg_udp_chksum[i] = pkt + 40;
           fg_counter[i] = pkt + 50;
         } else { // IPv6 -- stateful operation is not yet supported!
-          fg_pkt_mbuf[i] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0); // garbage
+          fg_pkt_mbuf[i] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0)); // garbage
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_sport[i] = pkt + 54;
           fg_udp_dport[i] = pkt + 56;
@@ -942,7 +1022,7 @@ int rsendPdv(void *par) {
         }
         fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
         // create backround PDV Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+        bg_pkt_mbuf[i] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the PDV Frame in the message buffer
         bg_udp_sport[i] = pkt + 54;
         bg_udp_dport[i] = pkt  + 56;
@@ -963,18 +1043,19 @@ int rsendPdv(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_index(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<unsigned> uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      thread_local fastRandom gen_index(rd());
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
  
       // naive sender version: it is simple and fast
       i=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ) {	// Main cycle for the number of frames to send
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start;
           udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -987,6 +1068,7 @@ int rsendPdv(void *par) {
           counter = (uint64_t *)fg_counter[i];
           pkt_mbuf = fg_pkt_mbuf[i];
         } else {
+          fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
           // background frame is to be sent
           chksum = bg_udp_chksum_start;
           udp_sport = (uint16_t *)bg_udp_sport[i];
@@ -1076,10 +1158,11 @@ int rsendPdv(void *par) {
           // this is the end of handling the frame in the old way
         }
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        snd_ts[sent_frames] = rte_rdtsc();                              // store timestamp
-        i = (i+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        if ( snd_ts )
+          snd_ts[sent_frames] = rte_rdtsc();			// store timestamp
+        i = (i+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
     else {
@@ -1088,6 +1171,7 @@ int rsendPdv(void *par) {
       // N size arrays are used to resolve the write after send problem
       int j; // cycle variable for the above mentioned purpose: takes {0..N-1} values
       // num_dest_nets <= 256
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[256][N], *pkt_mbuf; // pointers of message buffers for fg. and bg. PDV Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *fg_counter[N]; // pointers to the given fields
@@ -1108,10 +1192,10 @@ int rsendPdv(void *par) {
       curr_dst_bg = *dst_bg;
   
       // create PDV Test Frames
-      for ( j=0; j<N; j++ ) {
+      for ( j=0; j<fr.copies; j++ ) {
         // create foreground PDV Frame (IPv4 or IPv6)
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[j] = mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1);
+          fg_pkt_mbuf[j] = fr.add(mkPdvFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the PDV Frame in the message buffer
           fg_rte_ipv4_hdr[j] = pkt + 14;
           fg_ipv4_chksum[j] = pkt + 24;
@@ -1122,7 +1206,7 @@ int rsendPdv(void *par) {
           fg_udp_chksum[j] = pkt + 40;
           fg_counter[j] = pkt + 50;
         } else { // IPv6 -- stateful operation is not yet supported!
-          fg_pkt_mbuf[j] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0); // garbage
+          fg_pkt_mbuf[j] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0)); // garbage
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the PDV Frame in the message buffer
           fg_udp_sport[j] = pkt + 54;
           fg_udp_dport[j] = pkt + 56;
@@ -1134,7 +1218,7 @@ int rsendPdv(void *par) {
         for ( i=0; i<num_dest_nets; i++ ) {
           // create backround Test Frame (always IPv6)
           ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport);
+          bg_pkt_mbuf[i][j] = fr.add(mkPdvFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport));
           pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the PDV Frame in the message buffer
           bg_udp_sport[i][j] = pkt + 54;
           bg_udp_dport[i][j] = pkt  + 56;
@@ -1155,23 +1239,23 @@ int rsendPdv(void *par) {
         dport = dport_max;
 
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen_net(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_index(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<unsigned> uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
+      thread_local fastRandom gen_net(rd());
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      thread_local fastRandom gen_index(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
   
       // naive sender version: it is simple and fast
       j=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ 	// Main cycle for the number of frames to send
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[j]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start;
           udp_sport = (uint16_t *)fg_udp_sport[j];
@@ -1186,6 +1270,7 @@ int rsendPdv(void *par) {
         } else {
           // background frame is to be sent
           int net_index = uni_dis_net(gen_net); // index of the pre-generated frame
+          fr.wait(bg_pkt_mbuf[net_index][j]); // its previous transmission must be completed
           chksum = bg_udp_chksum_start[net_index];
           udp_sport = (uint16_t *)bg_udp_sport[net_index][j];
           udp_dport = (uint16_t *)bg_udp_dport[net_index][j];
@@ -1274,21 +1359,23 @@ int rsendPdv(void *par) {
           // this is the end of handling the frame in the old way
         }
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        snd_ts[sent_frames] = rte_rdtsc();                            	// store timestamp
-        j = (j+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        if ( snd_ts )
+          snd_ts[sent_frames] = rte_rdtsc();			// store timestamp
+        j = (j+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for multiple destination networks
   } // end of implementation of varying port numbers
   // Now, we check the time
   elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
   if ( elapsed_seconds > duration*TOLERANCE )
     printf("Error: %s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
-  else
+  else if ( !late )
     printf("%s frames sent: %lu\n", side, sent_frames);
-  return 0;
+  return late;
 }
 
 // receives PDV Frames for PDV or special throughput (or frame loss rate) measurements
@@ -1315,13 +1402,37 @@ int receivePdv(void *par) {
   uint64_t *id=(uint64_t *) identify;
   uint64_t received=0;  // number of received frames
 
-  // prepare a NUMA local, cache line aligned array for reveive timestamps, and fill it with all 0-s
-  uint64_t *rec_ts = (uint64_t *) rte_zmalloc(0, 8*num_frames, 128);
-  if ( !rec_ts )
-      rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for timestamps!\n");
-  *receive_ts = rec_ts; // return the address of the array to the caller function
+  combinedParameters cmb = p->cmb;	// used by the combined measurement
+  uint64_t *rec_ts = 0;
+  delayHistogram *delays = 0;
+
+  if ( cmb.delays ) {
+    // combined measurement: a NUMA local histogram of bounded size is used for the delays instead of the timestamps
+    delays = *cmb.delays; // the histogram of the previous repetition is reused
+    if ( !delays ) {
+      delays = (delayHistogram *) rte_malloc(0, sizeof(delayHistogram), 128);
+      if ( !delays )
+          rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for the delay histogram!\n");
+      *cmb.delays = delays; // return the address of the histogram to the caller function
+    }
+    memset(delays, 0, sizeof(delayHistogram));
+    delays->min = UINT64_MAX;
+    delays->frame_to = cmb.frame_to;
+  } else {
+    // prepare a NUMA local, cache line aligned array for reveive timestamps, and fill it with all 0-s
+    // (the array of the previous repetition is reused: this lcore has already zeroed it, see clearTimestamps)
+    rec_ts = *receive_ts;
+    if ( !rec_ts ) {
+      rec_ts = (uint64_t *) rte_zmalloc(0, 8*num_frames, 128);
+      if ( !rec_ts )
+          rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for timestamps!\n");
+      *receive_ts = rec_ts; // return the address of the array to the caller function
+    }
+  }
 
-  while ( rte_rdtsc() < finish_receiving ){
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
     frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
     for (i=0; i < frames; i++){
       uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the PDV Frame in the message buffer
@@ -1334,7 +1445,10 @@ int receivePdv(void *par) {
           uint64_t counter = *(uint64_t *)&pkt[70]; 
           if ( unlikely ( counter >= num_frames ) )
             rte_exit(EXIT_FAILURE, "Error: KAKUKK1 PDV Frame with invalid frame ID was received!\n"); // to avoid segmentation fault
-          rec_ts[counter] = timestamp;
+          if ( delays )
+            delays->add(cmb.delay(counter, timestamp)); // combined measurement
+          else
+            rec_ts[counter] = timestamp;
           received++; // also count it 
         }
       } else if ( *(uint16_t *)&pkt[12]==ipv4 ) { /* IPv4 */
@@ -1344,13 +1458,18 @@ int receivePdv(void *par) {
           uint64_t counter = *(uint64_t *)&pkt[50];
           if ( unlikely ( counter >= num_frames ) )
             rte_exit(EXIT_FAILURE, "Error: KAKUKK2 PDV Frame with invalid frame ID was received!\n"); // to avoid segmentation fault
-          rec_ts[counter] = timestamp;
+          if ( delays )
+            delays->add(cmb.delay(counter, timestamp)); // combined measurement
+          else
+            rec_ts[counter] = timestamp;
           received++; // also count it 
         }
       }
       rte_pktmbuf_free(pkt_mbufs[i]);
     }
+    polls.count(frames, poll_tsc); // called after processing not to delay the time stamps: receiving includes processing
   }
+  polls.report(side);
   if ( frame_timeout == 0 )
     printf("%s frames received: %lu\n", side, received); //  printed if normal PDV, but not printed if special throughput measurement is done
   return received;
@@ -1388,11 +1507,33 @@ int rreceivePdv(void *par) {
   uint64_t *id=(uint64_t *) identify;
   uint64_t fg_received=0, bg_received=0;        // number of received (fg, bg) frames (counted separetely)
 
-  // prepare a NUMA local, cache line aligned array for reveive timestamps, and fill it with all 0-s
-  uint64_t *rec_ts = (uint64_t *) rte_zmalloc(0, 8*num_frames, 128);
-  if ( !rec_ts )
-      rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for timestamps!\n");
-  *receive_ts = rec_ts; // return the address of the array to the caller function
+  combinedParameters cmb = p->cmb;	// used by the combined measurement
+  uint64_t *rec_ts = 0;
+  delayHistogram *delays = 0;
+
+  if ( cmb.delays ) {
+    // combined measurement: a NUMA local histogram of bounded size is used for the delays instead of the timestamps
+    delays = *cmb.delays; // the histogram of the previous repetition is reused
+    if ( !delays ) {
+      delays = (delayHistogram *) rte_malloc(0, sizeof(delayHistogram), 128);
+      if ( !delays )
+          rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for the delay histogram!\n");
+      *cmb.delays = delays; // return the address of the histogram to the caller function
+    }
+    memset(delays, 0, sizeof(delayHistogram));
+    delays->min = UINT64_MAX;
+    delays->frame_to = cmb.frame_to;
+  } else {
+    // prepare a NUMA local, cache line aligned array for reveive timestamps, and fill it with all 0-s
+    // (the array of the previous repetition is reused: this lcore has already zeroed it, see clearTimestamps)
+    rec_ts = *receive_ts;
+    if ( !rec_ts ) {
+      rec_ts = (uint64_t *) rte_zmalloc(0, 8*num_frames, 128);
+      if ( !rec_ts )
+          rte_exit(EXIT_FAILURE, "Error: Receiver can't allocate memory for timestamps!\n");
+      *receive_ts = rec_ts; // return the address of the array to the caller function
+    }
+  }
 
   if ( !*valid_entries ) {
     // This is preliminary phase: state table is allocated from the memory of this NUMA node
@@ -1406,7 +1547,10 @@ int rreceivePdv(void *par) {
   }
 
   // frames are received and their four tuples are recorded, timestamps are also recorded
-  while ( rte_rdtsc() < finish_receiving ){
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  polls.lc->state_entries.store(*valid_entries, std::memory_order_relaxed); // 0 in the preliminary phase
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
     frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
     for (i=0; i < frames; i++){
       uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the PDV Frame in the message buffer
@@ -1419,7 +1563,10 @@ int rreceivePdv(void *par) {
           uint64_t counter = *(uint64_t *)&pkt[70]; 
           if ( unlikely ( counter >= num_frames ) )
             rte_exit(EXIT_FAILURE, "Error: KAKUKK3 PDV Frame with invalid frame ID was received!\n"); // to avoid segmentation fault
-          rec_ts[counter] = timestamp;
+          if ( delays )
+            delays->add(cmb.delay(counter, timestamp)); // combined measurement
+          else
+            rec_ts[counter] = timestamp;
           bg_received++; // also count it 
         }
       } else if ( *(uint16_t *)&pkt[12]==ipv4 ) { /* IPv4 */
@@ -1429,7 +1576,10 @@ int rreceivePdv(void *par) {
           uint64_t counter = *(uint64_t *)&pkt[50];
           if ( unlikely ( counter >= num_frames ) )
             rte_exit(EXIT_FAILURE, "Error: KAKUKK4 PDV Frame with invalid frame ID was received!\n"); // to avoid segmentation fault
-          rec_ts[counter] = timestamp;
+          if ( delays )
+            delays->add(cmb.delay(counter, timestamp)); // combined measurement
+          else
+            rec_ts[counter] = timestamp;
           fg_received++; // it is considered a freground frame: we must learn its 4-tuple
           // copy IPv4 fields to the four_tuple -- without using conversion from network byte order to host byte order
           four_tuple.init_addr = *(uint32_t *)&pkt[26];         // 14+12: source IPv4 address
@@ -1442,7 +1592,11 @@ int rreceivePdv(void *par) {
       }
       rte_pktmbuf_free(pkt_mbufs[i]);
     }
+    polls.count(frames, poll_tsc); // called after processing not to delay the time stamps: receiving includes processing
+    if ( !*valid_entries ) // preliminary phase: the state table is being filled
+      polls.lc->state_entries.store(fg_received < state_table_size ? fg_received : state_table_size, std::memory_order_relaxed);
   }
+  polls.report(side);
   if ( frame_timeout == 0 )
     printf("%s frames received: %lu\n", side, fg_received+bg_received); //  printed if normal PDV, but not printed if special throughput measurement is done
   if ( !*valid_entries ) {
@@ -1454,7 +1608,7 @@ int rreceivePdv(void *par) {
 
 // performs PDV measurement
 void Pdv::measure(uint16_t leftport, uint16_t rightport) {
-  uint64_t *left_send_ts, *right_send_ts, *left_receive_ts, *right_receive_ts; // pointers for timestamp arrays
+  uint64_t frame_to = (uint64_t)frame_timeout*hz/1000;	// frame timeout in TSC cycles
 
   // Several parameters are provided to the various sender functions (sendPdv(), rsendPdv(), isend())
   // and receiver functions (receivePdv(), rreceivePdv(), rreceive()) in the following 'struct'-s.
@@ -1467,6 +1621,24 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
   rReceiverParameters rrpars;                   // used by rreceive() in phase 1 of the stateful test
   rReceiverParametersPdv rrparsP;               // used by rreceivePdv() in phase 2 of the stateful test
   rSenderParametersPdv rsparsP;                 // used by rsendPdv() in phase 2 of the stateful test
+  tscOffset fwd_offset(cpu_left_sender, cpu_right_receiver);	// TSC offset of the receiver of the PDV Frames (Forward)
+  tscOffset rev_offset(cpu_right_sender, cpu_left_receiver);	// TSC offset of the receiver of the PDV Frames (Reverse)
+
+  // the receivers may still be zeroing their timestamps used by the previous repetition
+  // (only the receivers of the active directions were launched, the lcores of the others may not even be set)
+  if ( repetition > 1 ) {
+    if ( forward )
+      rte_eal_wait_lcore(cpu_right_receiver);
+    if ( reverse )
+      rte_eal_wait_lcore(cpu_left_receiver);
+    setTimestamps();	// the test starts only after the zeroing is finished
+  }
+
+  // the TSC offsets are measured before the test (and after it, see below)
+  if ( forward )
+    fwd_offset.measure();
+  if ( reverse )
+    rev_offset.measure();
 
   switch ( stateful ) {
     case 0:     // stateless test is to be performed
@@ -1474,6 +1646,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
 
       // set common parameters for senders
       scp=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc);
+      scp.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
     
       if ( forward ) {      // Left to right direction is active
     
@@ -1486,7 +1659,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
         // then, initialize the parameter class instance
         sparsP1=senderParametersPdv(&scp,ip_left_version,pkt_pool_left_sender,leftport,"Forward",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
                                     ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,num_right_nets,
-                                    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,&left_send_ts);
+                                    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,combined ? 0 : &left_send_ts);
     
         // start left sender
         if ( rte_eal_remote_launch(sendPdv, &sparsP1, cpu_left_sender) )
@@ -1494,6 +1667,8 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
     
         // set parameters for the right receiver
         rparsP1=receiverParametersPdv(finish_receiving,rightport,"Forward",duration*frame_rate,frame_timeout,&right_receive_ts);
+        if ( combined )
+          rparsP1.cmb = combinedParameters(&right_delays,start_tsc,frame_rate,hz,fwd_offset.offset,frame_to);
     
         // start right receiver
         if ( rte_eal_remote_launch(receivePdv, &rparsP1, cpu_right_receiver) )
@@ -1511,7 +1686,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
         // then, initialize the parameter class instance
         sparsP2=senderParametersPdv(&scp,ip_right_version,pkt_pool_right_sender,rightport,"Reverse",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
                                     ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
-    			            fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,&right_send_ts);
+    			            fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,combined ? 0 : &right_send_ts);
     
         // start right sender
         if (rte_eal_remote_launch(sendPdv, &sparsP2, cpu_right_sender) )
@@ -1519,6 +1694,8 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
     
         // set parameters for the left receiver
         rparsP2=receiverParametersPdv(finish_receiving,leftport,"Reverse",duration*frame_rate,frame_timeout,&left_receive_ts);
+        if ( combined )
+          rparsP2.cmb = combinedParameters(&left_delays,start_tsc,frame_rate,hz,rev_offset.offset,frame_to);
     
         // start left receiver
         if ( rte_eal_remote_launch(receivePdv, &rparsP2, cpu_left_receiver) )
@@ -1588,6 +1765,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
 
       // set common parameters for senders
       scp=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc);
+      scp.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
 
       if ( forward ) {      // Left to right direction is active
 
@@ -1596,7 +1774,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
         // initialize the parameter class instance for real test (reuse previously prepared 'ipq')
         sparsP1=senderParametersPdv(&scp,ip_left_version,pkt_pool_left_sender,leftport,"Forward",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
                                     ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,num_right_nets,
-                                    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,&left_send_ts);
+                                    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,combined ? 0 : &left_send_ts);
 
         // start left sender
         if ( rte_eal_remote_launch(sendPdv, &sparsP1, cpu_left_sender) )
@@ -1605,6 +1783,8 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
         // set parameters for the right receiver
         rrparsP=rReceiverParametersPdv(finish_receiving,rightport,"Forward",state_table_size,&valid_entries,&stateTable,
 				       duration*frame_rate,frame_timeout,&right_receive_ts);
+        if ( combined )
+          rrparsP.cmb = combinedParameters(&right_delays,start_tsc,frame_rate,hz,fwd_offset.offset,frame_to);
 
         // start right receiver
         if ( rte_eal_remote_launch(rreceivePdv, &rrparsP, cpu_right_receiver) )
@@ -1623,7 +1803,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
         rsparsP=rSenderParametersPdv(&scp,ip_right_version,pkt_pool_right_sender,rightport,"Reverse",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
                                      ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
                                      rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max,
-                                     state_table_size,stateTable,responder_tuples,&right_send_ts);
+                                     state_table_size,stateTable,responder_tuples,combined ? 0 : &right_send_ts);
 
         // start right sender
         if (rte_eal_remote_launch(rsendPdv, &rsparsP, cpu_right_sender) )
@@ -1631,6 +1811,8 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
 
         // set parameters for the left receiver
         rparsP2=receiverParametersPdv(finish_receiving,leftport,"Reverse",duration*frame_rate,frame_timeout,&left_receive_ts);
+        if ( combined )
+          rparsP2.cmb = combinedParameters(&left_delays,start_tsc,frame_rate,hz,rev_offset.offset,frame_to);
 
         // start left receiver
         if ( rte_eal_remote_launch(receivePdv, &rparsP2, cpu_left_receiver) )
@@ -1699,6 +1881,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
  
       // set common parameters for senders
       scp=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc);
+      scp.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
 
       if ( reverse ) {      // Right to Left direction is active
 
@@ -1707,7 +1890,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
         // initialize the parameter class instance for real test (reuse previously prepared 'ipq')
         sparsP1=senderParametersPdv(&scp,ip_right_version,pkt_pool_right_sender,rightport,"Reverse",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
                                     ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
-                              	    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,&right_send_ts);
+                              	    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,combined ? 0 : &right_send_ts);
 
         // start right sender
         if ( rte_eal_remote_launch(sendPdv, &sparsP1, cpu_right_sender) )
@@ -1716,6 +1899,8 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
          // set parameters for the left receiver
         rrparsP=rReceiverParametersPdv(finish_receiving,leftport,"Reverse",state_table_size,&valid_entries,&stateTable,
 				       duration*frame_rate,frame_timeout,&left_receive_ts);
+        if ( combined )
+          rrparsP.cmb = combinedParameters(&left_delays,start_tsc,frame_rate,hz,rev_offset.offset,frame_to);
 
         // start left receiver
         if ( rte_eal_remote_launch(rreceivePdv, &rrparsP, cpu_left_receiver) )
@@ -1734,7 +1919,7 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
         rsparsP=rSenderParametersPdv(&scp,ip_left_version,pkt_pool_left_sender,leftport,"Forward",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
                                 ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,num_right_nets,
                                 fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,
-                                state_table_size,stateTable,responder_tuples,&left_send_ts);
+                                state_table_size,stateTable,responder_tuples,combined ? 0 : &left_send_ts);
 
         // start left sender
         if (rte_eal_remote_launch(rsendPdv, &rsparsP, cpu_left_sender) )
@@ -1742,6 +1927,8 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
 
         // set parameters for the right receiver
         rparsP2=receiverParametersPdv(finish_receiving,rightport,"Forward",duration*frame_rate,frame_timeout,&right_receive_ts);
+        if ( combined )
+          rparsP2.cmb = combinedParameters(&right_delays,start_tsc,frame_rate,hz,fwd_offset.offset,frame_to);
 
         // start right receiver
         if ( rte_eal_remote_launch(receivePdv, &rparsP2, cpu_right_receiver) )
@@ -1767,10 +1954,40 @@ void Pdv::measure(uint16_t leftport, uint16_t rightport) {
   // Process the timestamps
   int penalty=1000*duration+global_timeout; // latency to be reported for lost timestamps, expressed in milliseconds
 
-  if ( forward )
-    evaluatePdv(duration*frame_rate, left_send_ts, right_receive_ts, hz, frame_timeout, penalty, "Forward"); 
-  if ( reverse )
-    evaluatePdv(duration*frame_rate, right_send_ts, left_receive_ts, hz, frame_timeout, penalty, "Reverse"); 
+  if ( combined ) {
+    // the receivers have already subtracted the TSC offsets measured before the test, only the rest of the correction is left
+    if ( forward ) {
+      fwd_offset.correct(0, 0, hz, "Forward");
+      evaluateCombined(duration*frame_rate, right_delays, (fwd_offset.offset-fwd_offset.offset_before)/2, hz, frame_timeout, penalty, "Forward");
+    }
+    if ( reverse ) {
+      rev_offset.correct(0, 0, hz, "Reverse");
+      evaluateCombined(duration*frame_rate, left_delays, (rev_offset.offset-rev_offset.offset_before)/2, hz, frame_timeout, penalty, "Reverse");
+    }
+  } else {
+    if ( forward ) {
+      fwd_offset.correct(duration*frame_rate, right_receive_ts, hz, "Forward");
+      evaluatePdv(duration*frame_rate, left_send_ts, right_receive_ts, hz, frame_timeout, penalty, "Forward"); 
+    }
+    if ( reverse ) {
+      rev_offset.correct(duration*frame_rate, left_receive_ts, hz, "Reverse");
+      evaluatePdv(duration*frame_rate, right_send_ts, left_receive_ts, hz, frame_timeout, penalty, "Reverse"); 
+    }
+  }
+
+  // the idle receivers zero their timestamps for the next repetition, while the main lcore prepares it
+  if ( repetition < repetitions && !combined ) {
+    if ( forward ) {
+      right_clear = clearParameters(right_receive_ts, duration*frame_rate);
+      if ( rte_eal_remote_launch(clearTimestamps, &right_clear, cpu_right_receiver) )
+        std::cout << "Error: could not start Right Receiver." << std::endl;
+    }
+    if ( reverse ) {
+      left_clear = clearParameters(left_receive_ts, duration*frame_rate);
+      if ( rte_eal_remote_launch(clearTimestamps, &left_clear, cpu_left_receiver) )
+        std::cout << "Error: could not start Left Receiver." << std::endl;
+    }
+  }
 
   std::cout << "Info: Test finished." << std::endl;
 }
@@ -1802,6 +2019,16 @@ rSenderParametersPdv::rSenderParametersPdv()
 {
 }
 
+combinedParameters::combinedParameters(delayHistogram **delays_, uint64_t start_tsc_, uint32_t frame_rate_, uint64_t hz_,
+                                       int64_t tsc_offset_, uint64_t frame_to_) {
+  delays = delays_;
+  start_tsc = start_tsc_;
+  frame_rate = frame_rate_;
+  hz = hz_;
+  tsc_offset = tsc_offset_;
+  frame_to = frame_to_;
+}
+
 receiverParametersPdv::receiverParametersPdv(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, 
 				             uint64_t num_frames_, uint16_t frame_timeout_, uint64_t **receive_ts_) :
   receiverParameters(finish_receiving_,eth_id_,side_) {
@@ -1880,4 +2107,54 @@ void evaluatePdv(uint64_t num_timestamps, uint64_t *send_ts, uint64_t *receive_t
     printf("Info: %s Dmax: %lf\n", side, 1000.0*Dmax/hz);
     printf("%s PDV: %lf\n", side, 1000.0*PDV/hz);
   }
+  delete[] latency;
+}
+
+// returns the p-quantile (0 < p <= 1) of the recorded delays (TSC cycles): the middle of the bin containing it
+uint64_t delayHistogram::percentile(double p) {
+  uint64_t rank = ceil(p*frames), cumulated = 0, value;
+  unsigned i, e;
+
+  if ( rank < 1 )
+    rank = 1;
+  for ( i=0; cumulated+bins[i] < rank; i++ )
+    cumulated += bins[i];
+  if ( i < (2u << DELAY_SUB_BITS) )
+    value = i; // exact value
+  else {
+    e = (i >> DELAY_SUB_BITS) + DELAY_SUB_BITS - 1; // the bin is in the [2^e, 2^(e+1)) range
+    value = (((1ul << DELAY_SUB_BITS) + (i & ((1u << DELAY_SUB_BITS)-1))) << (e-DELAY_SUB_BITS)) + (1ul << (e-DELAY_SUB_BITS))/2;
+  }
+  return value < min ? min : value > max ? max : value;
+}
+
+// evaluates the combined measurement: the number of the frames received (within the frame timeout, if it is used),
+// the latency (TL and WCL of RFC 8219) and the PDV are computed from the histogram of the delays of all frames;
+// lost frames get the penalty, and 'correction' is the part of the TSC offset correction not yet applied by the receiver
+void evaluateCombined(uint64_t num_frames, delayHistogram *delays, int64_t correction, uint64_t hz, uint16_t frame_timeout, int penalty, const char *side) {
+  uint64_t penalty_tsc = penalty*hz/1000;	// exchange penaly from ms to TSC
+  uint64_t frames_lost = num_frames > delays->frames ? num_frames-delays->frames : 0;	// the number of physically lost frames
+  int64_t TL, WCL, PDV, Dmin, D99_9th_perc, Dmax;
+
+  if ( delays->corrected )
+    printf("Debug: %s number of negative delay values corrected to 0: %lu\n", side, delays->corrected);
+  if ( frame_timeout ) {
+    printf("%s frames received: %lu\n", side, delays->in_time);
+    printf("Info: %s frames completely missing: %lu\n", side, frames_lost);
+  }
+  if ( frames_lost )
+    delays->add(penalty_tsc+correction, frames_lost); // the penalty is not corrected below
+  TL = delays->percentile(0.5) - correction;
+  WCL = D99_9th_perc = delays->percentile(0.999) - correction;
+  Dmin = delays->min - correction;
+  Dmax = delays->max - correction;
+  printf("%s TL: %lf\n", side, 1000.0*TL/hz); // Typical Latency
+  printf("%s WCL: %lf\n", side, 1000.0*WCL/hz); // Worst Case Latency
+  if ( !frame_timeout ) {
+    PDV = D99_9th_perc - Dmin;
+    printf("Info: %s D99_9th_perc: %lf\n", side, 1000.0*D99_9th_perc/hz);
+    printf("Info: %s Dmin: %lf\n", side, 1000.0*Dmin/hz);
+    printf("Info: %s Dmax: %lf\n", side, 1000.0*Dmax/hz);
+    printf("%s PDV: %lf\n", side, 1000.0*PDV/hz);
+  }
 }
@@ -31,7 +31,12 @@ class Pdv : public Throughput {
 public:
   uint16_t frame_timeout;       // if 0, normal PDV measurement is done; if >0, then frames with higher delay then frame_timeout are considered as lost 
 
-  Pdv() : Throughput() { }; // default constructor
+  // kept for the repetitions of the measurement
+  uint64_t *left_send_ts, *right_send_ts, *left_receive_ts, *right_receive_ts; // timestamp arrays (0: not yet allocated)
+  class delayHistogram *left_delays, *right_delays;	// delay histograms of the combined measurement (Combined 1)
+  clearParameters left_clear, right_clear;		// the receive timestamps to be zeroed by the Left and Right receivers
+
+  Pdv() : Throughput() { left_send_ts = right_send_ts = left_receive_ts = right_receive_ts = 0; left_delays = right_delays = 0; }; // default constructor
   int readCmdLine(int argc, const char *argv[]);	// reads further one argument: frame_timeout
   virtual int senderPoolSize(int numDestNets, int varport);
   virtual int senderPoolSize(int numDestNets, int varport, int ip_varies);
@@ -55,6 +60,65 @@ struct rte_mbuf *mkPdvFrame6(uint16_t length, rte_mempool *pkt_pool, const char
                                 const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                                 const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned var_sport, unsigned var_dport);
 
+// log-linear histogram of the delays of the frames for the combined measurement ('Combined 1') with bounded memory:
+// delays below 2^(DELAY_SUB_BITS+1) TSC cycles have their own bins, and each further power of two range is divided
+// into 2^DELAY_SUB_BITS bins, thus the relative error of a percentile is less than 2^-(DELAY_SUB_BITS+1)
+class delayHistogram {
+  public:
+  uint64_t bins[(64-DELAY_SUB_BITS+1) << DELAY_SUB_BITS];
+  uint64_t frames;	// number of the delays recorded
+  uint64_t in_time;	// number of the delays not exceeding frame_to
+  uint64_t min, max;	// the smallest and the largest delay (TSC cycles)
+  uint64_t corrected;	// number of negative delays corrected to 0
+  uint64_t frame_to;	// frame timeout (TSC cycles), 0: not used
+
+  // returns the index of the bin of the delay
+  static inline unsigned index(uint64_t delay) {
+    if ( delay < (2u << DELAY_SUB_BITS) )
+      return delay;
+    int e = 63 - __builtin_clzll(delay); // e > DELAY_SUB_BITS
+    return ((e-DELAY_SUB_BITS+1) << DELAY_SUB_BITS) + ((delay >> (e-DELAY_SUB_BITS)) & ((1u << DELAY_SUB_BITS)-1));
+  }
+  // records the delay of a received frame (TSC cycles, it may be negative due to the TSC offset)
+  inline void add(int64_t delay) {
+    if ( unlikely( delay < 0 ) ) {
+      delay = 0;
+      corrected++;
+    }
+    add((uint64_t)delay, 1);
+  }
+  inline void add(uint64_t delay, uint64_t count) {
+    bins[index(delay)] += count;
+    frames += count;
+    if ( !frame_to || delay <= frame_to )
+      in_time += count;
+    if ( delay < min )
+      min = delay;
+    if ( delay > max )
+      max = delay;
+  }
+  uint64_t percentile(double p);	// returns the p-quantile (0 < p <= 1) of the recorded delays (TSC cycles)
+};
+
+// parameters of the receivers for the combined measurement: the delay of a frame is computed from its receive timestamp
+// and its scheduled sending time, which is derived from its counter exactly as the sender does
+class combinedParameters {
+  public:
+  delayHistogram **delays;	// the address of the histogram allocated by the receiver is returned here (0: no combined measurement)
+  uint64_t start_tsc;		// scheduled sending time of the first frame
+  uint32_t frame_rate;		// number of frames per second
+  uint64_t hz;			// number of TSC cycles per second
+  int64_t tsc_offset;		// TSC offset of the receiver relative to the sender, measured before the test
+  uint64_t frame_to;		// frame timeout (TSC cycles), 0: not used
+
+  combinedParameters(delayHistogram **delays_, uint64_t start_tsc_, uint32_t frame_rate_, uint64_t hz_, int64_t tsc_offset_, uint64_t frame_to_);
+  combinedParameters() { delays = 0; };
+  // returns the delay of the frame with the given counter received at the given TSC of the receiver
+  inline int64_t delay(uint64_t counter, uint64_t timestamp) {
+    return timestamp - tsc_offset - (start_tsc + counter*hz/frame_rate);
+  }
+};
+
 class senderParametersPdv : public senderParameters {
 public:
   uint64_t **send_ts;
@@ -83,6 +147,7 @@ class receiverParametersPdv : public receiverParameters {
   uint64_t num_frames;	// number of all frames, needed for the rte_zmalloc call for allocating receive_ts
   uint16_t frame_timeout;
   uint64_t **receive_ts;
+  combinedParameters cmb;	// used instead of receive_ts, if cmb.delays is not 0
   receiverParametersPdv();
   receiverParametersPdv(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, 
                             uint64_t num_frames_, uint16_t frame_timeout_, uint64_t **receive_ts_);
@@ -93,6 +158,7 @@ class rReceiverParametersPdv : public rReceiverParameters {
   uint64_t num_frames;  // number of all frames, needed for the rte_zmalloc call for allocating receive_ts
   uint16_t frame_timeout;
   uint64_t **receive_ts;
+  combinedParameters cmb;	// used instead of receive_ts, if cmb.delays is not 0
   rReceiverParametersPdv();
   rReceiverParametersPdv(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, unsigned state_table_size_,
                         unsigned *valid_entries_, atomicFourTuple **stateTable_,
@@ -100,5 +166,6 @@ class rReceiverParametersPdv : public rReceiverParameters {
 };
 
 void evaluatePdv(uint64_t num_timestamps, uint64_t *send_ts, uint64_t *receive_ts, uint64_t hz, uint16_t frame_timeout, int penalty, const char *side);
+void evaluateCombined(uint64_t num_frames, delayHistogram *delays, int64_t correction, uint64_t hz, uint16_t frame_timeout, int penalty, const char *side);
 
 #endif
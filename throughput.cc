@@ -31,6 +31,7 @@
 
 char coresList[101]; // buffer for preparing the list of lcores for DPDK init (like a command line argument)
 char numChannels[11]; // buffer for printing the number of memory channels into a string for DPDK init (like a command line argument)
+liveCounters live[RTE_MAX_LCORE]; // live counters of the worker lcores (see telemetryLive())
 
 Throughput::Throughput(){
   // initialize some data members to default or invalid values
@@ -43,6 +44,15 @@ Throughput::Throughput(){
   cpu_right_receiver = -1; 	// MUST be set in the config file if forward != 0
   cpu_right_sender = -1; 	// MUST be set in the config file if reverse != 0
   cpu_left_receiver = -1; 	// MUST be set in the config file if reverse != 0
+  cpu_placement = 0;		// default value: the lcores are set in the config file
+  port_pairs = 1;		// default value: a single port pair
+  for ( int i=0; i<MAX_PORT_PAIRS; i++ )
+    for ( int j=0; j<4; j++ )
+      pair_cpu[i][j] = -1;	// MUST be set in the config file for the additional port pairs 
+  memset(pair_mac, 0, sizeof(pair_mac)); // MUST be set in the config file for the additional port pairs
+  max_lateness = 0;		// default value: the lateness of the frames is reported, but not checked
+  noise_check = 0;		// default value: no host noise check, as it adds NOISE_CHECK_MS to each run
+  max_frame_rate = 0;		// will be set by init()
   memory_channels = 1; 		// default value, this value will be set, if not specified in the config file
   num_left_nets = 1;		// default value: single destination network
   num_right_nets = 1;		// default value: single destination network
@@ -60,16 +70,50 @@ Throughput::Throughput(){
   rev_dport_max = 49151;	// default value: use maximum range recommended by RFC 4814
   ip_left_varies = 0;          	// default value: use hard coded fix source IP address of RFC 2544
   ip_right_varies = 0;         	// default value: use hard coded fix source IP address of RFC 2544
+  ip_left_bits = 16;		// default value: 16 bits of the left side IP address may vary
+  ip_right_bits = 16;		// default value: 16 bits of the right side IP address may vary
 
   stateful = 0;			// default value: perform stateless test
   enumerate_ports = 0;		// default value: do not enumerate ports
   enumerate_ips = 0;		// default value: do not enumerate IP addresses
   responder_tuples = 0;		// default value: use a single four tuple (like fix port numbers)
+  responder_echo = 0;		// default value: the Responder uses its state table
+  tcp = 0;			// default value: the test frames carry UDP datagrams
   stateTable = 0;  		// to cause segmentation fault if not initialized
   valid_entries = 0;   		// to indicate that state table is empty (used by rsend)
+  echo_ring = 0;		// to indicate that no ring was created
+  pipeline_ring[0] = pipeline_ring[1] = 0; // to indicate that no ring was created
   uniquePortComb = 0;		// to indicate that no memory was allocated
   uniqueIpComb = 0;		// to indicate that no memory was allocated
   uniqueFtComb = 0;		// to indicate that no memory was allocated
+
+  search_mode = 0;		// default value: perform a single measurement
+  search_alpha = 100;		// default value: the validation rate is equal with R
+  search_beta = 20;		// default value: 20% of RS is the lowest acceptable rate during the exponential search
+  search_gamma = 40;		// default value: 40% of RS is the lowest acceptable rate during the final binary search
+  search_r_error = 100000;	// default value: binary search for R stops, when the interval is not wider than this
+  search_c_error = 1;		// default value: final binary search for C stops, when the interval is not wider than this
+  search_sleep = 0;		// default value: no sleeping between the steps of the searches
+  dut_reset[0] = 0;		// default value: no DUT reset command
+  popularity = popularityParameters(0,1.0,10,90); // default value: uniform distribution (Zipf-s 1.0, Hot-values 10, Hot-share 90 are not used)
+  schedule = 0;			// default value: the senders compute the varying fields during sending
+  schedule_memory = 1024;	// default value: a schedule of up to 64Mi frames (1024MB) is pre-built by the sender
+  pipeline = 0;			// default value: each sender prepares its own frames
+  cpu_left_helper = -1;		// MAY be set in the config file if schedule != 0, MUST be set if pipeline != 0 and forward != 0
+  cpu_right_helper = -1;	// MAY be set in the config file if schedule != 0, MUST be set if pipeline != 0 and reverse != 0
+  calibrate = 0;		// default value: the network ports and the DUT are used
+  cpu_forwarder = -1;		// MUST be set in the config file if calibrate != 0
+  combined = 0;			// default value: separate throughput, latency and PDV measurements
+  repetitions = 1;		// default value: a single measurement
+  repetition = 1;
+  for ( int i=0; i<4; i++ )
+    calibration_ring[i] = 0;	// to indicate that no ring was created
+  // imix is initialized by its own constructor: IMIX is not used
+  pre_received = 0;		// no measurement was performed yet
+  val_received = 0;		// no measurement was performed yet
+  fwd_received = 0;		// no measurement was performed yet
+  rev_received = 0;		// no measurement was performed yet
+  slow_senders = 0;		// no measurement was performed yet
 };
 
 // finds a 'key' (name of a parameter) in the 'line' string
@@ -128,6 +172,22 @@ int nonComment(const char *line) {
   return 1;
 }
 
+// reads an unsigned 64-bit value in decimal or hexa (in 0x... format)
+// return: 1, if a value was read; 0 otherwise
+int readUint64(const char *s, uint64_t *value) {
+  char *end;
+
+  *value = strtoull(s, &end, 0);
+  return end != s;
+}
+
+// multiplies the sizes of two ranges (0 means 2^64), the result saturates at UINT64_MAX
+static inline uint64_t mulSat(uint64_t a, uint64_t b) {
+  if ( !a || !b || a > UINT64_MAX/b )
+    return UINT64_MAX;
+  return a*b;
+}
+
 // reads the configuration file and stores the information in data members of class Throughput
 int Throughput::readConfigFile(const char *filename) {
   FILE *f; 	// file descriptor
@@ -142,7 +202,15 @@ int Throughput::readConfigFile(const char *filename) {
     return -1;
   }
   for ( line_no=1; fgets(line, LINELEN+1, f); line_no++ ) {
-    if ( (pos = findKey(line, "IP-L-Vers")) >= 0 ) {
+    if ( (pos = findKey(line, "DUT-reset")) >= 0 ) {
+      // it is checked first, because the command may contain the name of any other key
+      // the rest of the line is the command (no comment is allowed at the end of the line)
+      while ( line[pos]==' ' || line[pos]=='\t' )
+        pos++;
+      strcpy(dut_reset, line+pos);
+      if ( (pos = strlen(dut_reset)) && dut_reset[pos-1]=='\n' )
+        dut_reset[pos-1] = 0;
+    } else if ( (pos = findKey(line, "IP-L-Vers")) >= 0 ) {
       sscanf(line+pos, "%d", &ip_left_version);
       if ( ip_left_version!=4 && ip_left_version!=6 ) {
         std::cerr << "Input Error: 'IP-L-Vers' must be 4 or 6." << std::endl;
@@ -219,15 +287,22 @@ int Throughput::readConfigFile(const char *filename) {
         return -1;
       }
     } else if ( (pos = findKey(line, "Num-L-Nets")) >= 0 ) {
-      sscanf(line+pos, "%hu", &num_left_nets);
-      if ( num_left_nets < 1 || num_left_nets > 256 ) {
-        std::cerr << "Input Error: 'Num-L-Nets' must be >= 1 and <= 256." << std::endl;
+      sscanf(line+pos, "%u", &num_left_nets);
+      if ( num_left_nets < 1 || num_left_nets > MAX_DEST_NETS ) {
+        std::cerr << "Input Error: 'Num-L-Nets' must be >= 1 and <= " << MAX_DEST_NETS << "." << std::endl;
         return -1;
       }
     } else if ( (pos = findKey(line, "Num-R-Nets")) >= 0 ) {
-      sscanf(line+pos, "%hu", &num_right_nets);
-      if ( num_right_nets < 1 || num_right_nets > 256 ) {
-        std::cerr << "Input Error: 'Num-R-Nets' must be >= 1 and <= 256." << std::endl;
+      sscanf(line+pos, "%u", &num_right_nets);
+      if ( num_right_nets < 1 || num_right_nets > MAX_DEST_NETS ) {
+        std::cerr << "Input Error: 'Num-R-Nets' must be >= 1 and <= " << MAX_DEST_NETS << "." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "CPU-Forwarder")) >= 0 ) {
+      // it must be checked before "Forward", because findKey() would find that key in this line, too
+      sscanf(line+pos, "%d", &cpu_forwarder);
+      if ( cpu_forwarder < 0 || cpu_forwarder >= RTE_MAX_LCORE ) {
+        std::cerr << "Input Error: 'CPU-Forwarder' must be >= 0 and < RTE_MAX_LCORE." << std::endl;
         return -1;
       }
     } else if ( (pos = findKey(line, "Forward")) >= 0 ) {
@@ -266,6 +341,24 @@ int Throughput::readConfigFile(const char *filename) {
         std::cerr << "Input Error: 'MEM-Channels' must be > 0." << std::endl;
         return -1;
       }
+    } else if ( (pos = findKey(line, "Max-lateness")) >= 0 ) {
+      sscanf(line+pos, "%u", &max_lateness);
+      if ( max_lateness > 1000000 ) {
+        std::cerr << "Input Error: 'Max-lateness' must be between 0 and 1000000 (microseconds)." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "CPU-placement")) >= 0 ) {
+      sscanf(line+pos, "%u", &cpu_placement);
+      if ( cpu_placement > 1 ) {
+        std::cerr << "Input Error: 'CPU-placement' must be 0 or 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Noise-check")) >= 0 ) {
+      sscanf(line+pos, "%u", &noise_check);
+      if ( noise_check > 2 ) {
+        std::cerr << "Input Error: 'Noise-check' must be 0, 1, or 2." << std::endl;
+        return -1;
+      }
     } else if ( (pos = findKey(line, "Fwd-var-sport")) >= 0 ) {
       sscanf(line+pos, "%u", &fwd_var_sport);
       if ( fwd_var_sport > 3 ) {
@@ -343,29 +436,41 @@ int Throughput::readConfigFile(const char *filename) {
         return -1;
       }
     } else if ( (pos = findKey(line, "IP-L-min")) >= 0 ) {
-      if ( sscanf(line+pos, "%i", &ip_left_min) < 1 ) {	// read decimal or hexa (in 0x... format)
+      if ( readUint64(line+pos, &ip_left_min) < 1 ) { // read decimal or hexa (in 0x... format)
         std::cerr << "Input Error: Unable to read 'IP-L-min' value." << std::endl;
         return -1;
       }
     } else if ( (pos = findKey(line, "IP-L-max")) >= 0 ) {
-      if ( sscanf(line+pos, "%i", &ip_left_max) < 1 ) { // read decimal or hexa (in 0x... format)
+      if ( readUint64(line+pos, &ip_left_max) < 1 ) { // read decimal or hexa (in 0x... format)
         std::cerr << "Input Error: Unable to read 'IP-L-max' value." << std::endl;
         return -1;
       }
     } else if ( (pos = findKey(line, "IP-R-min")) >= 0 ) {
-      if ( sscanf(line+pos, "%i", &ip_right_min) < 1 ) { // read decimal or hexa (in 0x... format)
+      if ( readUint64(line+pos, &ip_right_min) < 1 ) { // read decimal or hexa (in 0x... format)
         std::cerr << "Input Error: Unable to read 'IP-R-min' value." << std::endl;
         return -1;
       }
     } else if ( (pos = findKey(line, "IP-R-max")) >= 0 ) {
-      if ( sscanf(line+pos, "%i", &ip_right_max) < 1 ) { // read decimal or hexa (in 0x... format)
+      if ( readUint64(line+pos, &ip_right_max) < 1 ) { // read decimal or hexa (in 0x... format)
         std::cerr << "Input Error: Unable to read 'IP-R-max' value." << std::endl;
         return -1;
       }
+    } else if ( (pos = findKey(line, "IP-L-bits")) >= 0 ) {
+      sscanf(line+pos, "%u", &ip_left_bits);
+      if ( ip_left_bits != 16 && ip_left_bits != 32 && ip_left_bits != 64 ) {
+        std::cerr << "Input Error: 'IP-L-bits' must be 16, 32, or 64." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "IP-R-bits")) >= 0 ) {
+      sscanf(line+pos, "%u", &ip_right_bits);
+      if ( ip_right_bits != 16 && ip_right_bits != 32 && ip_right_bits != 64 ) {
+        std::cerr << "Input Error: 'IP-R-bits' must be 16, 32, or 64." << std::endl;
+        return -1;
+      }
     } else if ( (pos = findKey(line, "IPv4-L-offset")) >= 0 ) {
       sscanf(line+pos, "%u", &ipv4_left_offset);
-      if ( ipv4_left_offset < 1 || ipv4_left_offset > 2 ) {
-        std::cerr << "Input Error: 'IPv4-L-offset' must be 1 or 2." << std::endl;
+      if ( ipv4_left_offset > 2 ) {
+        std::cerr << "Input Error: 'IPv4-L-offset' must be 0, 1, or 2." << std::endl;
         return -1;
       }
     } else if ( (pos = findKey(line, "IPv6-L-offset")) >= 0 ) {
@@ -376,8 +481,8 @@ int Throughput::readConfigFile(const char *filename) {
       }
     } else if ( (pos = findKey(line, "IPv4-R-offset")) >= 0 ) {
       sscanf(line+pos, "%u", &ipv4_right_offset);
-      if ( ipv4_right_offset < 1 || ipv4_right_offset > 2 ) {
-        std::cerr << "Input Error: 'IPv4-R-offset' must be 1 or 2." << std::endl;
+      if ( ipv4_right_offset > 2 ) {
+        std::cerr << "Input Error: 'IPv4-R-offset' must be 0, 1, or 2." << std::endl;
         return -1;
       }
     } else if ( (pos = findKey(line, "IPv6-R-offset")) >= 0 ) {
@@ -398,6 +503,198 @@ int Throughput::readConfigFile(const char *filename) {
         std::cerr << "Input Error: 'Responder-tuples' must be 0, 1, 2, or 3." << std::endl;
         return -1;
       }
+    } else if ( (pos = findKey(line, "Responder-echo")) >= 0 ) {
+      sscanf(line+pos, "%u", &responder_echo);
+      if ( responder_echo > 1 ) {
+        std::cerr << "Input Error: 'Responder-echo' must be 0 or 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "TCP")) >= 0 ) {
+      sscanf(line+pos, "%u", &tcp);
+      if ( tcp > 1 ) {
+        std::cerr << "Input Error: 'TCP' must be 0 or 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Port-pairs")) >= 0 ) {
+      sscanf(line+pos, "%u", &port_pairs);
+      if ( port_pairs < 1 || port_pairs > MAX_PORT_PAIRS ) {
+        std::cerr << "Input Error: 'Port-pairs' must be between 1 and " << MAX_PORT_PAIRS << "." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Pair-CPUs")) >= 0 ) {
+      unsigned i;	// index of the port pair
+      int c[4];		// lcores
+      if ( sscanf(line+pos, "%u %d %d %d %d", &i, &c[0], &c[1], &c[2], &c[3]) < 5 || i < 1 || i >= MAX_PORT_PAIRS ) {
+        std::cerr << "Input Error: 'Pair-CPUs' needs a port pair index between 1 and " << MAX_PORT_PAIRS-1 << " and four lcores." << std::endl;
+        return -1;
+      }
+      for ( int j=0; j<4; j++ ) {
+        if ( c[j] < 0 || c[j] >= RTE_MAX_LCORE ) {
+          std::cerr << "Input Error: The lcores of 'Pair-CPUs' must be >= 0 and < RTE_MAX_LCORE." << std::endl;
+          return -1;
+        }
+        pair_cpu[i][j] = c[j];
+      }
+    } else if ( (pos = findKey(line, "Pair-MACs")) >= 0 ) {
+      unsigned i;	// index of the port pair
+      int len;		// number of characters consumed by sscanf
+      if ( sscanf(line+pos, "%u%n", &i, &len) < 1 || i < 1 || i >= MAX_PORT_PAIRS ) {
+        std::cerr << "Input Error: 'Pair-MACs' needs a port pair index between 1 and " << MAX_PORT_PAIRS-1 << " and four MAC addresses." << std::endl;
+        return -1;
+      }
+      for ( int j=0; j<4; j++ ) {
+        pos += len;
+        m=pair_mac[i][j];
+        if ( sscanf(line+pos, " %hhx:%hhx:%hhx:%hhx:%hhx:%hhx%n", &m[0], &m[1], &m[2], &m[3], &m[4], &m[5], &len) < 6 ) {
+          std::cerr << "Input Error: Bad MAC address in 'Pair-MACs'." << std::endl;
+          return -1;
+        }
+      }
+    } else if ( (pos = findKey(line, "Popularity")) >= 0 ) {
+      sscanf(line+pos, "%u", &popularity.type);
+      if ( popularity.type > 2 ) {
+        std::cerr << "Input Error: 'Popularity' must be 0, 1, or 2." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Zipf-s")) >= 0 ) {
+      sscanf(line+pos, "%lf", &popularity.zipf_s);
+      if ( popularity.zipf_s <= 0 || popularity.zipf_s > 10 ) {
+        std::cerr << "Input Error: 'Zipf-s' must be higher than 0 and not higher than 10." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Hot-values")) >= 0 ) {
+      sscanf(line+pos, "%u", &popularity.hot_values);
+      if ( popularity.hot_values < 1 || popularity.hot_values > 99 ) {
+        std::cerr << "Input Error: 'Hot-values' must be between 1 and 99." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Hot-share")) >= 0 ) {
+      sscanf(line+pos, "%u", &popularity.hot_share);
+      if ( popularity.hot_share < 1 || popularity.hot_share > 99 ) {
+        std::cerr << "Input Error: 'Hot-share' must be between 1 and 99." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Schedule-memory")) >= 0 ) {
+      sscanf(line+pos, "%u", &schedule_memory);
+      if ( schedule_memory < 1 || schedule_memory > 1048576 ) {
+        std::cerr << "Input Error: 'Schedule-memory' must be between 1 and 1048576 (MB)." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Schedule")) >= 0 ) {
+      sscanf(line+pos, "%u", &schedule);
+      if ( schedule > 1 ) {
+        std::cerr << "Input Error: 'Schedule' must be 0 or 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Pipeline")) >= 0 ) {
+      sscanf(line+pos, "%u", &pipeline);
+      if ( pipeline > 1 ) {
+        std::cerr << "Input Error: 'Pipeline' must be 0 or 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "CPU-L-Helper")) >= 0 ) {
+      sscanf(line+pos, "%d", &cpu_left_helper);
+      if ( cpu_left_helper < 0 || cpu_left_helper >= RTE_MAX_LCORE ) {
+        std::cerr << "Input Error: 'CPU-L-Helper' must be >= 0 and < RTE_MAX_LCORE." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "CPU-R-Helper")) >= 0 ) {
+      sscanf(line+pos, "%d", &cpu_right_helper);
+      if ( cpu_right_helper < 0 || cpu_right_helper >= RTE_MAX_LCORE ) {
+        std::cerr << "Input Error: 'CPU-R-Helper' must be >= 0 and < RTE_MAX_LCORE." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "IMIX-bps")) >= 0 ) {
+      sscanf(line+pos, "%u", &imix.bps);
+      if ( imix.bps > 1 ) {
+        std::cerr << "Input Error: 'IMIX-bps' must be 0 or 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "IMIX")) >= 0 ) {
+      int len;		// number of characters consumed by sscanf
+      unsigned size, weight;	// values of the current class
+      for ( imix.sizes = 0, imix.period = 0; sscanf(line+pos, " %u:%u%n", &size, &weight, &len) == 2; pos += len ) {
+        if ( imix.sizes == IMIX_MAX_SIZES ) {
+          std::cerr << "Input Error: 'IMIX' may contain at most " << IMIX_MAX_SIZES << " frame sizes." << std::endl;
+          return -1;
+        }
+        if ( size < 84 || size > MAX_FRAME_SIZE+20 || weight < 1 ) {
+          std::cerr << "Input Error: The frame sizes of 'IMIX' must be between 84 and " << MAX_FRAME_SIZE+20 << ", and their weights must be at least 1." << std::endl;
+          return -1;
+        }
+        for ( unsigned i=0; i<imix.sizes; i++ )
+          if ( imix.size[i] == size ) {
+            std::cerr << "Input Error: The frame sizes of 'IMIX' must be different." << std::endl;
+            return -1;
+          }
+        imix.size[imix.sizes] = size;
+        imix.weight[imix.sizes++] = weight;
+        imix.period += weight;
+      }
+      if ( !imix.sizes || imix.period > IMIX_PERIOD ) {
+        std::cerr << "Input Error: 'IMIX' needs a list of 'size:weight' pairs, the sum of the weights must be at most " << IMIX_PERIOD << "." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Search-mode")) >= 0 ) {
+      sscanf(line+pos, "%u", &search_mode);
+      if ( search_mode > 2 ) {
+        std::cerr << "Input Error: 'Search-mode' must be 0, 1, or 2." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Search-alpha")) >= 0 ) {
+      sscanf(line+pos, "%u", &search_alpha);
+      if ( search_alpha < 1 || search_alpha > 1000 ) {
+        std::cerr << "Input Error: 'Search-alpha' must be between 1 and 1000." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Search-beta")) >= 0 ) {
+      sscanf(line+pos, "%u", &search_beta);
+      if ( search_beta > 100 ) {
+        std::cerr << "Input Error: 'Search-beta' must be between 0 and 100." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Search-gamma")) >= 0 ) {
+      sscanf(line+pos, "%u", &search_gamma);
+      if ( search_gamma > 100 ) {
+        std::cerr << "Input Error: 'Search-gamma' must be between 0 and 100." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Search-R-error")) >= 0 ) {
+      sscanf(line+pos, "%u", &search_r_error);
+      if ( search_r_error < 1 ) {
+        std::cerr << "Input Error: 'Search-R-error' must be at least 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Search-C-error")) >= 0 ) {
+      sscanf(line+pos, "%u", &search_c_error);
+      if ( search_c_error < 1 ) {
+        std::cerr << "Input Error: 'Search-C-error' must be at least 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Search-sleep")) >= 0 ) {
+      sscanf(line+pos, "%u", &search_sleep);
+      if ( search_sleep > 3600 ) {
+        std::cerr << "Input Error: 'Search-sleep' must be between 0 and 3600." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Calibrate")) >= 0 ) {
+      sscanf(line+pos, "%u", &calibrate);
+      if ( calibrate > 1 ) {
+        std::cerr << "Input Error: 'Calibrate' must be 0 or 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Combined")) >= 0 ) {
+      sscanf(line+pos, "%u", &combined);
+      if ( combined > 1 ) {
+        std::cerr << "Input Error: 'Combined' must be 0 or 1." << std::endl;
+        return -1;
+      }
+    } else if ( (pos = findKey(line, "Repetitions")) >= 0 ) {
+      sscanf(line+pos, "%u", &repetitions);
+      if ( repetitions < 1 || repetitions > 1000 ) {
+        std::cerr << "Input Error: 'Repetitions' must be between 1 and 1000." << std::endl;
+        return -1;
+      }
     } else if ( (pos = findKey(line, "Enumerate-ports")) >= 0 ) {
       sscanf(line+pos, "%u", &enumerate_ports);
       if ( enumerate_ports > 3 ) {
@@ -423,10 +720,55 @@ int Throughput::readConfigFile(const char *filename) {
       std::cerr << "Input Error: No active direction was specified." << std::endl;
       return -1;
     }
+    if ( responder_echo ) {
+      std::cerr << "Input Error: 'Responder-echo' is available with stateful tests only." << std::endl;
+      return -1;
+    }
+    if ( tcp ) {
+      std::cerr << "Input Error: 'TCP' is available with stateful tests only." << std::endl;
+      return -1;
+    }
   } 
+  if ( search_mode ) {
+    if ( !stateful ) {
+      std::cerr << "Input Error: 'Search-mode' is available with stateful tests only." << std::endl;
+      return -1;
+    }
+    // the test frames sent by the Responder are used for validation
+    if ( search_mode == 1 && (stateful == 1 && !reverse || stateful == 2 && !forward) ) {
+      std::cerr << "Input Error: 'Search-mode' requires the direction of the Responder to be active." << std::endl;
+      return -1;
+    }
+    if ( responder_echo ) {
+      std::cerr << "Input Error: 'Search-mode' and 'Responder-echo' may not be used together." << std::endl;
+      return -1;
+    }
+    // the preliminary frames must belong to different connections to be counted as distinct 4-tuples
+    if ( search_mode == 2 && !enumerate_ports && !enumerate_ips ) {
+      std::cerr << "Input Error: 'Search-mode 2' requires 'Enumerate-ports' or 'Enumerate-ips'." << std::endl;
+      return -1;
+    }
+  }
+  if ( responder_echo ) {
+    // echo requests are sent by the Initiator, echo replies are sent by the Responder
+    if ( forward == 0 || reverse == 0 ) {
+      std::cerr << "Input Error: 'Responder-echo' requires both directions to be active." << std::endl;
+      return -1;
+    }
+    // the fixed port implementation of the Initiator sends the very same mbuf again and again, it cannot carry time stamps
+    if ( !ip_left_varies && !ip_right_varies && (stateful == 1 && !fwd_var_sport && !fwd_var_dport || stateful == 2 && !rev_var_sport && !rev_var_dport) ) {
+      std::cerr << "Input Error: 'Responder-echo' requires varying port numbers or IP addresses for the Initiator." << std::endl;
+      return -1;
+    }
+    // the echo replies are built from UDP datagrams
+    if ( tcp ) {
+      std::cerr << "Input Error: 'Responder-echo' and 'TCP' may not be used together." << std::endl;
+      return -1;
+    }
+  }
   
-  // check if the necessary lcores were specified
-  if ( stateful==1 || forward ) {
+  // check if the necessary lcores were specified (the unset ones are chosen by placeLcores(), if 'CPU-placement' is 1)
+  if ( !cpu_placement && (stateful==1 || forward) ) {
     if ( cpu_left_sender < 0 ) {
       std::cerr << "Input Error: No 'CPU-L-Send' was specified." << std::endl;
       return -1;
@@ -436,7 +778,7 @@ int Throughput::readConfigFile(const char *filename) {
       return -1;
     }
   }
-  if ( stateful==2 || reverse ) {
+  if ( !cpu_placement && (stateful==2 || reverse) ) {
     if ( cpu_right_sender < 0 ) {
       std::cerr << "Input Error: No 'CPU-R-Send' was specified." << std::endl;
       return -1;
@@ -446,6 +788,140 @@ int Throughput::readConfigFile(const char *filename) {
       return -1;
     }
   }
+  // check the additional port pairs
+  if ( port_pairs > 1 ) {
+    if ( stateful ) {
+      std::cerr << "Input Error: Multiple port pairs are supported with stateless tests only." << std::endl;
+      return -1;
+    }
+    for ( unsigned i=1; i<port_pairs; i++ ) {
+      if ( !cpu_placement && (forward && (pair_cpu[i][0] < 0 || pair_cpu[i][1] < 0) || reverse && (pair_cpu[i][2] < 0 || pair_cpu[i][3] < 0)) ) {
+        std::cerr << "Input Error: No 'Pair-CPUs' was specified for port pair " << i << "." << std::endl;
+        return -1;
+      }
+      static const uint8_t zero_mac[6] = {0};
+      for ( int j=0; j<4; j++ )
+        if ( !memcmp(pair_mac[i][j], zero_mac, 6) ) {
+          std::cerr << "Input Error: No 'Pair-MACs' was specified for port pair " << i << "." << std::endl;
+          return -1;
+        }
+    }
+  }
+  // check the pre-materialized traffic schedule
+  if ( schedule ) {
+    if ( stateful ) {
+      std::cerr << "Input Error: 'Schedule' is available with stateless tests only." << std::endl;
+      return -1;
+    }
+    if ( port_pairs > 1 ) {
+      std::cerr << "Input Error: 'Schedule' is available with a single port pair only." << std::endl;
+      return -1;
+    }
+    if ( num_left_nets > 1 || num_right_nets > 1 ) {
+      std::cerr << "Input Error: 'Schedule' is available with a single destination network only." << std::endl;
+      return -1;
+    }
+  }
+  // check the frame preparation pipeline
+  if ( pipeline ) {
+    if ( stateful ) {
+      std::cerr << "Input Error: 'Pipeline' is available with stateless tests only." << std::endl;
+      return -1;
+    }
+    if ( port_pairs > 1 ) {
+      std::cerr << "Input Error: 'Pipeline' is available with a single port pair only." << std::endl;
+      return -1;
+    }
+    if ( num_left_nets > 1 || num_right_nets > 1 ) {
+      std::cerr << "Input Error: 'Pipeline' is available with a single destination network only." << std::endl;
+      return -1;
+    }
+    if ( schedule ) {
+      std::cerr << "Input Error: 'Pipeline' and 'Schedule' may not be used together." << std::endl;
+      return -1;
+    }
+    if ( !cpu_placement && forward && cpu_left_helper < 0 ) {
+      std::cerr << "Input Error: 'Pipeline' requires 'CPU-L-Helper' for the forward direction." << std::endl;
+      return -1;
+    }
+    if ( !cpu_placement && reverse && cpu_right_helper < 0 ) {
+      std::cerr << "Input Error: 'Pipeline' requires 'CPU-R-Helper' for the reverse direction." << std::endl;
+      return -1;
+    }
+  }
+  // check the helper lcores: an lcore can run a single worker, the launch of the helper would fail on an lcore already used
+  // (lcore 0 is the main lcore, see init(), and a single port pair is used with 'Schedule' and 'Pipeline')
+  if ( schedule || pipeline ) {
+    int helper[2] = { forward ? cpu_left_helper : -1, reverse ? cpu_right_helper : -1 };
+    int worker[4] = { cpu_left_sender, cpu_right_receiver, cpu_right_sender, cpu_left_receiver };
+    for ( int h=0; h<2; h++ ) {
+      if ( helper[h] < 0 )
+        continue;
+      bool used = !helper[h] || h && helper[h] == helper[0];
+      for ( int j=0; j<4; j++ )
+        used |= (j < 2 ? forward || stateful==1 : reverse || stateful==2) && worker[j] == helper[h];
+      if ( used ) {
+        std::cerr << "Input Error: '" << (h ? "CPU-R-Helper" : "CPU-L-Helper") << "' must differ from the main lcore (0), the other helper, "
+                  << "and the lcores of the senders and receivers." << std::endl;
+        return -1;
+      }
+    }
+  }
+  // check the frame size mix
+  if ( imix.sizes ) {
+    if ( stateful ) {
+      std::cerr << "Input Error: 'IMIX' is available with stateless tests only." << std::endl;
+      return -1;
+    }
+    if ( !schedule && !pipeline ) {
+      std::cerr << "Input Error: 'IMIX' requires 'Schedule 1' or 'Pipeline 1'." << std::endl;
+      return -1;
+    }
+    imix.prepare();
+  } else if ( imix.bps ) {
+    std::cerr << "Input Error: 'IMIX-bps' may be used with 'IMIX' only." << std::endl;
+    return -1;
+  }
+  // check the self-calibration
+  if ( calibrate ) {
+    if ( !cpu_placement && cpu_forwarder < 0 ) {
+      std::cerr << "Input Error: 'Calibrate' requires 'CPU-Forwarder'." << std::endl;
+      return -1;
+    }
+    if ( port_pairs > 1 ) {
+      std::cerr << "Input Error: 'Calibrate' is available with a single port pair only." << std::endl;
+      return -1;
+    }
+    if ( search_mode ) {
+      std::cerr << "Input Error: 'Calibrate' and 'Search-mode' may not be used together." << std::endl;
+      return -1;
+    }
+    // an lcore can run a single worker (lcore 0 is the main lcore, see init())
+    if ( cpu_forwarder >= 0 ) {
+      int other[6] = { cpu_left_sender, cpu_right_receiver, cpu_left_helper, cpu_right_sender, cpu_left_receiver, cpu_right_helper };
+      bool used = !cpu_forwarder;
+      for ( int j=0; j<6; j++ )
+        used |= (j < 3 ? forward || stateful==1 : reverse || stateful==2) && other[j] == cpu_forwarder;
+      if ( used ) {
+        std::cerr << "Input Error: 'CPU-Forwarder' must differ from the main lcore (0), and the lcores of the senders, receivers and helpers." << std::endl;
+        return -1;
+      }
+    }
+    if ( responder_echo ) {
+      std::cerr << "Input Error: 'Calibrate' and 'Responder-echo' may not be used together." << std::endl;
+      return -1;
+    }
+    // the frame rate is searched for, but it does not control the pacing of the senders
+    if ( imix.bps ) {
+      std::cerr << "Input Error: 'Calibrate' and 'IMIX-bps' may not be used together." << std::endl;
+      return -1;
+    }
+    // the forwarder does not translate the frames, and the Responder learns the 4-tuples from IPv4 frames
+    if ( stateful && ( ip_left_version != 4 || ip_right_version != 4 ) ) {
+      std::cerr << "Input Error: 'Calibrate' requires IPv4 on both sides with stateful tests." << std::endl;
+      return -1;
+    }
+  }
   // calculate the derived values, if any port numbers or IP addresses have to be changed
   fwd_varport = fwd_var_sport || fwd_var_dport;
   rev_varport = rev_var_sport || rev_var_dport;
@@ -481,6 +957,11 @@ int Throughput::readConfigFile(const char *filename) {
     std::cerr << "Input Error: Usage of multiple IP address is available with a single destination network only." << std::endl;
     return -1;
   }
+  // the preliminary frames of the Initiator are pre-generated for each destination network, the Responder uses any number of them
+  if ( stateful==1 && num_right_nets > MAX_PREGEN_NETS || stateful==2 && num_left_nets > MAX_PREGEN_NETS ) {
+    std::cerr << "Input Error: At most " << MAX_PREGEN_NETS << " destination networks of the Initiator are supported by stateful tests." << std::endl;
+    return -1;
+  }
 
   // checking the constraints for "Enumerate-ips" and "Enumerate-ports"
   if ( stateful && enumerate_ips && enumerate_ports && enumerate_ips != enumerate_ports ) {
@@ -506,24 +987,70 @@ int Throughput::readConfigFile(const char *filename) {
     return -1;
   }
 
-  // perform masking of the proper 16 bits of the IPv4 / IPv6 addresses
+  // sanity checks regarding the width of the varying fields of the IP addresses
+  if ( ip_varies && ( ip_left_bits > 16 || ip_right_bits > 16 ) ) {
+    if ( ( ip_left_bits == 64 || ip_right_bits == 64 ) && ( ip_left_version == 4 || ip_right_version == 4 ) ) {
+      std::cerr << "Input Error: 64-bit varying IP address fields require IPv6 on both sides." << std::endl;
+      return -1;
+    }
+    if ( schedule || pipeline ) {
+      std::cerr << "Input Error: 'Schedule' and 'Pipeline' support 16-bit varying IP address fields only." << std::endl;
+      return -1;
+    }
+    if ( popularity.type && ( ip_left_varies == 3 && ip_left_bits > 16 || ip_right_varies == 3 && ip_right_bits > 16 ) ) {
+      std::cerr << "Input Error: 'Popularity' supports 16-bit pseudorandom IP address fields only." << std::endl;
+      return -1;
+    }
+  }
+  if ( ip_left_varies ) {
+    if ( ( ip_left_version == 4 || ip_right_version == 4 ) && ipv4_left_offset + ip_left_bits/8 > 4 ) {
+      std::cerr << "Input Error: The varying field of the left side IPv4 address does not fit into the address ('IPv4-L-offset', 'IP-L-bits')." << std::endl;
+      return -1;
+    }
+    if ( ipv6_left_offset + ip_left_bits/8 > 16 ) {
+      std::cerr << "Input Error: The varying field of the left side IPv6 address does not fit into the address ('IPv6-L-offset', 'IP-L-bits')." << std::endl;
+      return -1;
+    }
+    if ( ip_left_min > ip_left_max || ip_left_bits < 64 && ip_left_max >> ip_left_bits ) {
+      std::cerr << "Input Error: 'IP-L-min' and 'IP-L-max' must satisfy 'IP-L-min' <= 'IP-L-max' < 2^'IP-L-bits'." << std::endl;
+      return -1;
+    }
+  }
+  if ( ip_right_varies ) {
+    if ( ( ip_left_version == 4 || ip_right_version == 4 ) && ipv4_right_offset + ip_right_bits/8 > 4 ) {
+      std::cerr << "Input Error: The varying field of the right side IPv4 address does not fit into the address ('IPv4-R-offset', 'IP-R-bits')." << std::endl;
+      return -1;
+    }
+    if ( ipv6_right_offset + ip_right_bits/8 > 16 ) {
+      std::cerr << "Input Error: The varying field of the right side IPv6 address does not fit into the address ('IPv6-R-offset', 'IP-R-bits')." << std::endl;
+      return -1;
+    }
+    if ( ip_right_min > ip_right_max || ip_right_bits < 64 && ip_right_max >> ip_right_bits ) {
+      std::cerr << "Input Error: 'IP-R-min' and 'IP-R-max' must satisfy 'IP-R-min' <= 'IP-R-max' < 2^'IP-R-bits'." << std::endl;
+      return -1;
+    }
+  }
+
+  // perform masking of the varying fields of the IPv4 / IPv6 addresses (an IPv4 address is not used, if its field does not fit)
   if ( ip_left_varies ) {
-    uint32_t ipv4mask = htonl(0xffffffff & ~(0xffffu<<((2-ipv4_left_offset)*8)));
-    ipv4_left_real &= ipv4mask;
-    ipv4_left_virtual &= ipv4mask;
-    ipv6_left_real.s6_addr[ipv6_left_offset]=0;
-    ipv6_left_real.s6_addr[ipv6_left_offset+1]=0;
-    ipv6_left_virtual.s6_addr[ipv6_left_offset]=0;
-    ipv6_left_virtual.s6_addr[ipv6_left_offset+1]=0;
+    for ( unsigned i=0; i<ip_left_bits/8; i++ ) {
+      if ( ipv4_left_offset+i < 4 ) {
+        ((uint8_t *)&ipv4_left_real)[ipv4_left_offset+i]=0;
+        ((uint8_t *)&ipv4_left_virtual)[ipv4_left_offset+i]=0;
+      }
+      ipv6_left_real.s6_addr[ipv6_left_offset+i]=0;
+      ipv6_left_virtual.s6_addr[ipv6_left_offset+i]=0;
+    }
   }
   if ( ip_right_varies ) {
-    uint32_t ipv4mask = htonl(0xffffffff & ~(0xffffu<<((2-ipv4_left_offset)*8)));
-    ipv4_right_real &= ipv4mask;
-    ipv4_right_virtual &= ipv4mask;
-    ipv6_right_real.s6_addr[ipv6_right_offset]=0;
-    ipv6_right_real.s6_addr[ipv6_right_offset+1]=0;
-    ipv6_right_virtual.s6_addr[ipv6_right_offset]=0;
-    ipv6_right_virtual.s6_addr[ipv6_right_offset+1]=0;
+    for ( unsigned i=0; i<ip_right_bits/8; i++ ) {
+      if ( ipv4_right_offset+i < 4 ) {
+        ((uint8_t *)&ipv4_right_real)[ipv4_right_offset+i]=0;
+        ((uint8_t *)&ipv4_right_virtual)[ipv4_right_offset+i]=0;
+      }
+      ipv6_right_real.s6_addr[ipv6_right_offset+i]=0;
+      ipv6_right_virtual.s6_addr[ipv6_right_offset+i]=0;
+    }
   }
   return 0;
 }
@@ -535,15 +1062,20 @@ int Throughput::readCmdLine(int argc, const char *argv[]) {
     std::cerr << "Input Error: Too few command line arguments." << std::endl;
     return -1;
   }
-  if ( sscanf(argv[1], "%hu", &ipv6_frame_size) != 1 || ipv6_frame_size < 84 || ipv6_frame_size > 1538 ) {
-    std::cerr << "Input Error: IPv6 frame size must be between 84 and 1538." << std::endl;
+  if ( sscanf(argv[1], "%hu", &ipv6_frame_size) != 1 || ipv6_frame_size < 84 || ipv6_frame_size > MAX_FRAME_SIZE+20 ) {
+    std::cerr << "Input Error: IPv6 frame size must be between 84 and " << MAX_FRAME_SIZE+20 << "." << std::endl;
+    return -1;
+  }
+  if ( tcp && ipv6_frame_size < 86 ) {
+    // the TCP header is 12 bytes longer than the UDP header, and the data field must contain the 8 bytes of 'IDENTIFY'
+    std::cerr << "Input Error: IPv6 frame size must be at least 86 with TCP." << std::endl;
     return -1;
   }
   // Further checking of the frame size will be done, when n and m are read.
   ipv4_frame_size=ipv6_frame_size-20;
-  if ( sscanf(argv[2], "%u", &frame_rate) != 1 || frame_rate < 1 || frame_rate > 14880952 ) { 
-    // 14,880,952 is the maximum frame rate for 10Gbps Ethernet using 64-byte frame size
-    std::cerr << "Input Error: Frame rate must be between 1 and 14880952." << std::endl;
+  if ( sscanf(argv[2], "%u", &frame_rate) != 1 || frame_rate < 1 || frame_rate > MAX_FRAME_RATE ) { 
+    // the maximum frame rate of the actual links is checked by init(), when the link speeds are known
+    std::cerr << "Input Error: Frame rate must be between 1 and " << MAX_FRAME_RATE << "." << std::endl;
     return -1;
   }
   if ( sscanf(argv[3], "%hu", &duration) != 1 || duration < 1 || duration > 3600 ) {
@@ -563,9 +1095,33 @@ int Throughput::readCmdLine(int argc, const char *argv[]) {
     return -1;
   }
 
-  if ( ipv6_frame_size > 1518 && ( forward && ip_left_version == 6 || reverse && ip_right_version == 6 || m < n ) ) {
-    std::cerr << "Input Error: IPv6 frame sizes between 1518 and 1538 are allowed for pure IPv4 traffic only (as IPv4 frames are 20 bytes shorter)." << std::endl;
-    return -1;
+  // the largest frame on the wire determines, whether jumbo frames are needed
+  max_frame_size = ipv6_frame_size;
+  for ( unsigned i=0; i<imix.sizes; i++ ) // if IMIX is used, the frame size command line parameter is not used
+    max_frame_size = i ? std::max(max_frame_size, imix.size[i]) : imix.size[i];
+  if ( forward && ip_left_version == 6 || reverse && ip_right_version == 6 || m < n ) { // IPv6 frames are also sent
+    if ( max_frame_size > MAX_FRAME_SIZE ) {
+      std::cerr << "Input Error: IPv6 frame sizes above " << MAX_FRAME_SIZE << " are allowed for pure IPv4 traffic only (as IPv4 frames are 20 bytes shorter)." << std::endl;
+      return -1;
+    }
+  } else {
+    max_frame_size -= 20; // only IPv4 frames are sent
+  }
+  if ( max_frame_size > 1518 )
+    std::cout << "Info: Jumbo frames are used, the MTU of the ports is set to " << max_frame_size-RTE_ETHER_HDR_LEN-RTE_ETHER_CRC_LEN << "." << std::endl;
+  if ( imix.sizes ) {
+    if ( imix.bps ) {
+      // the frame rate parameter is a bit rate: it is converted to the frame rate of whole IMIX periods
+      imix.bit_rate = frame_rate;
+      frame_rate = (uint64_t)imix.bit_rate*1000000*imix.period/imix.periodBits();
+      if ( frame_rate < 1 ) {
+        std::cerr << "Input Error: The bit rate is too low for the IMIX." << std::endl;
+        return -1;
+      }
+      std::cout << "Info: IMIX bit rate " << imix.bit_rate << " Mbps is sent as " << frame_rate << " fps." << std::endl;
+      if ( m && (forward && ip_left_version == 4 || reverse && ip_right_version == 4) )
+        std::cout << "Info: The senders of IPv4 foreground frames send " << senderFrameRate(4) << " fps." << std::endl;
+    }
   }
   if ( stateful ) {
     if ( sscanf(argv[7], "%u", &pre_frames) != 1 || pre_frames < 1 ) {
@@ -576,8 +1132,8 @@ int Throughput::readCmdLine(int argc, const char *argv[]) {
       std::cerr << "Input Error: 'M' (the size of the state table of the Responder) must be between 1 and 2^32-1." << std::endl;
       return -1;
     }
-    if ( sscanf(argv[9], "%u", &pre_rate) != 1 || frame_rate < 1 || frame_rate > 14880952 ) {
-      std::cerr << "Input Error: Preliminary frame rate 'R' must be between 1 and 14880952." << std::endl;
+    if ( sscanf(argv[9], "%u", &pre_rate) != 1 || pre_rate < 1 || pre_rate > MAX_FRAME_RATE ) {
+      std::cerr << "Input Error: Preliminary frame rate 'R' must be between 1 and " << MAX_FRAME_RATE << "." << std::endl;
       return -1;
     }
     if ( sscanf(argv[10], "%u", &pre_timeout) != 1 || pre_timeout < 1 || pre_timeout > 2000 ) {
@@ -618,8 +1174,8 @@ int Throughput::readCmdLine(int argc, const char *argv[]) {
     if ( enumerate_ips == 3 && enumerate_ports != 3 ) {
       // unique IP address combinations are required for each foreground preliminary frame
       // check if there are enough of them
-      uint64_t ipAddressCombinations;  // theoretically may be equal with 2**32, thus uint32_t is not enough
-        ipAddressCombinations = (ip_left_max-ip_left_min+1)*(ip_right_max-ip_right_min+1);
+      uint64_t ipAddressCombinations;  // saturates at UINT64_MAX with wide varying IP address fields
+        ipAddressCombinations = mulSat(ip_left_max-ip_left_min+1, ip_right_max-ip_right_min+1);
       std::cout << "Info: number of unique IP address combinations: " <<  ipAddressCombinations << std::endl;
       std::cout << "Info: number of foreground preliminary frames: " << eff_pre_frames << std::endl;
       if ( ipAddressCombinations < eff_pre_frames ) {
@@ -631,11 +1187,11 @@ int Throughput::readCmdLine(int argc, const char *argv[]) {
     if ( enumerate_ips == 3 && enumerate_ports == 3 ) {
       // unique IP address and port number combinations are required for each foreground preliminary frame
       // check if there are enough of them
-      uint64_t c;  
+      uint64_t c;  // saturates at UINT64_MAX with wide varying IP address fields
       if ( stateful == 1 )
-        c = (ip_left_max-ip_left_min+1)*(ip_right_max-ip_right_min+1)*(fwd_sport_max-fwd_sport_min+1)*(fwd_dport_max-fwd_dport_min+1);
+        c = mulSat(mulSat(ip_left_max-ip_left_min+1, ip_right_max-ip_right_min+1), (uint64_t)(fwd_sport_max-fwd_sport_min+1)*(fwd_dport_max-fwd_dport_min+1));
       else // sateful is 2
-        c = (ip_left_max-ip_left_min+1)*(ip_right_max-ip_right_min+1)*(rev_sport_max-rev_sport_min+1)*(rev_dport_max-rev_dport_min+1);
+        c = mulSat(mulSat(ip_left_max-ip_left_min+1, ip_right_max-ip_right_min+1), (uint64_t)(rev_sport_max-rev_sport_min+1)*(rev_dport_max-rev_dport_min+1));
       std::cout << "Info: number of unique IP address and port number combinations: " <<  c << std::endl;
       std::cout << "Info: number of foreground preliminary frames: " << eff_pre_frames << std::endl;
       if ( c < eff_pre_frames ) {
@@ -649,6 +1205,11 @@ int Throughput::readCmdLine(int argc, const char *argv[]) {
       return -1;
     }
 
+    if ( search_mode && m < n ) {
+      std::cerr << "Input Error: in-process searches require m == n (N and M are set to the same value in each step)." << std::endl;
+      return -1;
+    }
+
   std::cout << "Info: Stateful test cmdline parameteres: N: " << pre_frames << ", M: " << state_table_size << 
                ", R: " << pre_rate << ", T: " << pre_timeout << ", D: " << pre_delay << std::endl;
   }
@@ -658,8 +1219,8 @@ int Throughput::readCmdLine(int argc, const char *argv[]) {
 // Initializes DPDK EAL, starts network ports, creates and sets up TX/RX queues, checks NUMA localty and TSC synchronization of lcores
 // sets the values of some variables (Throughput data members)
 int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
-  const char *rte_argv[6]; // parameters for DPDK EAL init, e.g.: {NULL, "-l", "4,5,6,7", "-n", "2", NULL};
-  int rte_argc = static_cast<int>(sizeof(rte_argv) / sizeof(rte_argv[0])) - 1; // argc value for DPDK EAL init
+  const char *rte_argv[7]; // parameters for DPDK EAL init, e.g.: {NULL, "-l", "4,5,6,7", "-n", "2", NULL};
+  int rte_argc = 5; // argc value for DPDK EAL init
   struct rte_eth_conf cfg_port;		// for configuring the Ethernet ports
   struct rte_eth_link link_info;	// for retrieving link info by rte_eth_link_get()
   int trials; 	// cycle variable for port state checking
@@ -675,17 +1236,57 @@ int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
     snprintf(coresList, 101, "0,%d,%d", cpu_left_sender, cpu_right_receiver); // only forward (left to right) is active 
   else 
     snprintf(coresList, 101, "0,%d,%d", cpu_right_sender, cpu_left_receiver); // only reverse (right to left) is active
+  for ( unsigned i=1; i<port_pairs; i++ ) { // add the lcores of the additional port pairs (stateless tests only)
+    int len = strlen(coresList);
+    if ( forward )
+      len += snprintf(coresList+len, 101-len, ",%d,%d", pair_cpu[i][0], pair_cpu[i][1]);
+    if ( reverse )
+      snprintf(coresList+len, 101-len, ",%d,%d", pair_cpu[i][2], pair_cpu[i][3]);
+  }
+  if ( schedule || pipeline ) { // add the helper lcores, if any
+    int len = strlen(coresList);
+    if ( forward && cpu_left_helper >= 0 )
+      len += snprintf(coresList+len, 101-len, ",%d", cpu_left_helper);
+    if ( reverse && cpu_right_helper >= 0 )
+      snprintf(coresList+len, 101-len, ",%d", cpu_right_helper);
+  }
+  if ( calibrate ) { // add the lcore of the forwarder
+    int len = strlen(coresList);
+    snprintf(coresList+len, 101-len, ",%d", cpu_forwarder);
+  }
+  if ( cpu_placement ) {
+    // all online CPUs are given to the EAL, the lcores are chosen by placeLcores() when the sockets of the ports are known
+    if ( onlineCpuList(coresList, 101) < 0 ) {
+      std::cerr << "Error: Cannot read the list of the online CPUs for 'CPU-placement 1', Tester exits." << std::endl;
+      return -1;
+    }
+  }
   rte_argv[2]=coresList;
   rte_argv[3]="-n";
   snprintf(numChannels, 11, "%hhu", memory_channels);
   rte_argv[4]=numChannels;
-  rte_argv[5]=0;
+  if ( calibrate )
+    rte_argv[rte_argc++]="--no-pci";	// the network ports are not used, the software loopback ports get the port IDs from 0
+  rte_argv[rte_argc]=0;
 
   if ( rte_eal_init(rte_argc, const_cast<char **>(rte_argv)) < 0 ) {
     std::cerr << "Error: DPDK RTE initialization failed, Tester exits." << std::endl;
     return -1;
   }
 
+  // the lcores not set in the config file are placed on the NUMA nodes of their ports (the pools, rings, state tables
+  // and timestamp arrays are allocated on the NUMA nodes of their lcores)
+  if ( cpu_placement && placeLcores(leftport, rightport) < 0 )
+    return -1;
+
+  if ( calibrate && mkCalibrationPorts(leftport, rightport) < 0 )
+    return -1;
+
+  // the live counters of the senders and receivers can be queried through the telemetry socket of DPDK during the tests
+  if ( rte_telemetry_register_cmd("/siitperf/live", telemetryLive,
+                                  "Returns the live counters of the senders and receivers of siitperf. Takes no parameters") < 0 )
+    printf("Warning: The live counters of siitperf cannot be published through the telemetry socket.\n");
+
   if ( !rte_eth_dev_is_valid_port(leftport) ) {
     std::cerr << "Error: Network port #" << leftport << " provided as Left Port is not available, Tester exits." << std::endl;
     return -1;
@@ -700,6 +1301,11 @@ int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
   memset(&cfg_port, 0, sizeof(cfg_port)); 	// e.g. no CRC generation offloading, etc. (May be improved later!)
   cfg_port.txmode.mq_mode = RTE_ETH_MQ_TX_NONE;	// no multi queues 
   cfg_port.rxmode.mq_mode = RTE_ETH_MQ_RX_NONE;	// no multi queues 
+  if ( max_frame_size > 1518 ) // jumbo frames: the frames fit into a single mbuf, see mbufSize()
+    cfg_port.rxmode.mtu = max_frame_size-RTE_ETHER_HDR_LEN-RTE_ETHER_CRC_LEN;
+
+  if ( checkMtu(leftport, &cfg_port) < 0 || checkMtu(rightport, &cfg_port) < 0 )
+    return -1;
 
   if ( rte_eth_dev_configure(leftport, 1, 1, &cfg_port) < 0 ) {
     std::cerr << "Error: Cannot configure network port #" << leftport << " provided as Left Port, Tester exits." << std::endl;
@@ -716,36 +1322,54 @@ int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
   // Sender pool size calculation uses 0 instead of num_{left,right}_nets, when no actual frame sending is needed. 
 
   // calculate packet pool sizes and then create the pools
-  int effective_right_nets = (stateful==1 ? num_right_nets : 0) + (forward ? num_right_nets : 0); // preliminary traffic of stateful test + normal traffic
+  // send() and rsend() use the same frames for any number of destination networks, only the other senders pre-generate them for each network
+  int effective_right_nets = (stateful==1 ? num_right_nets : 0) + (forward ? std::min(num_right_nets, (uint32_t)MAX_PREGEN_NETS) : 0); // preliminary traffic of stateful test + normal traffic
   int effective_forward_varport = fwd_varport || stateful==1 && enumerate_ports || stateful==2 && responder_tuples;
   int left_sender_pool_size = senderPoolSize( effective_right_nets, effective_forward_varport, ip_varies );
-  int effective_left_nets = (stateful==2 ? num_left_nets : 0) + (reverse ? num_left_nets : 0); // preliminary traffic of stateful test + normal traffic
+  int effective_left_nets = (stateful==2 ? num_left_nets : 0) + (reverse ? std::min(num_left_nets, (uint32_t)MAX_PREGEN_NETS) : 0); // preliminary traffic of stateful test + normal traffic
   int effective_reverse_varport = rev_varport || stateful==2 && enumerate_ports || stateful==1 && responder_tuples;
   int right_sender_pool_size = senderPoolSize( effective_left_nets, effective_reverse_varport, ip_varies );
+  if ( imix.sizes > 1 ) {
+    // the fg. and bg. frames exist in N copies for each further frame size class
+    left_sender_pool_size += 2*(imix.sizes-1)*N;
+    right_sender_pool_size += 2*(imix.sizes-1)*N;
+  }
+  if ( pipeline ) {
+    // the prepared frames may wait in the ring, and in the burst and in the mempool cache of the producer
+    left_sender_pool_size += PIPELINE_RING_SIZE + MAX_PKT_BURST + 2*PKTPOOL_CACHE;
+    right_sender_pool_size += PIPELINE_RING_SIZE + MAX_PKT_BURST + 2*PKTPOOL_CACHE;
+    if ( calibrate ) {
+      // the frames sent may also wait in the rings of the software loopback ports and in the burst of the forwarder
+      left_sender_pool_size += 2*CALIBRATION_RING_SIZE + MAX_PKT_BURST;
+      right_sender_pool_size += 2*CALIBRATION_RING_SIZE + MAX_PKT_BURST;
+    }
+  }
 
   int receiver_pool_size = PORT_RX_QUEUE_SIZE + 2 * MAX_PKT_BURST + 100; // While one of them is processed, the other one is being filled. 
+  if ( responder_echo )
+    receiver_pool_size += ECHO_RING_SIZE + PORT_TX_QUEUE_SIZE; // received frames are sent back as echo replies: they may wait in the ring and in the TX queue
 
   pkt_pool_left_sender = rte_pktmbuf_pool_create ( "pp_left_sender", left_sender_pool_size, PKTPOOL_CACHE, 0, 
-                                                   RTE_MBUF_DEFAULT_BUF_SIZE, rte_lcore_to_socket_id(cpu_left_sender));
+                                                   mbufSize(), rte_lcore_to_socket_id(cpu_left_sender));
   if ( !pkt_pool_left_sender ) {
     std::cerr << "Error: Cannot create packet pool for Left Sender, Tester exits." << std::endl;
     return -1;
   }
   pkt_pool_right_receiver = rte_pktmbuf_pool_create ( "pp_right_receiver", receiver_pool_size, PKTPOOL_CACHE, 0, 
-                                                      RTE_MBUF_DEFAULT_BUF_SIZE, rte_lcore_to_socket_id(cpu_right_receiver));
+                                                      mbufSize(), rte_lcore_to_socket_id(cpu_right_receiver));
   if ( !pkt_pool_right_receiver ) {
     std::cerr << "Error: Cannot create packet pool for Right Receiver, Tester exits." << std::endl;
     return -1;
   }
 
   pkt_pool_right_sender = rte_pktmbuf_pool_create ( "pp_right_sender", right_sender_pool_size, PKTPOOL_CACHE, 0,
-                                                    RTE_MBUF_DEFAULT_BUF_SIZE, rte_lcore_to_socket_id(cpu_right_sender));
+                                                    mbufSize(), rte_lcore_to_socket_id(cpu_right_sender));
   if ( !pkt_pool_right_sender ) {
     std::cerr << "Error: Cannot create packet pool for Right Sender, Tester exits." << std::endl;
     return -1;
   }
   pkt_pool_left_receiver = rte_pktmbuf_pool_create ( "pp_left_receiver", receiver_pool_size, PKTPOOL_CACHE, 0,
-                                                     RTE_MBUF_DEFAULT_BUF_SIZE, rte_lcore_to_socket_id(cpu_left_receiver));
+                                                     mbufSize(), rte_lcore_to_socket_id(cpu_left_receiver));
   if ( !pkt_pool_left_receiver ) {
     std::cerr << "Error: Cannot create packet pool for Left Receiver, Tester exits." << std::endl;
     return -1;
@@ -802,6 +1426,34 @@ int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
   rte_eth_link_get(rightport, &link_info);
   } while ( link_info.link_status == RTE_ETH_LINK_DOWN );
 
+  // port pair 0 is the one set up above
+  pair_port[0][0] = leftport;
+  pair_port[0][1] = rightport;
+  pair_cpu[0][0] = cpu_left_sender;
+  pair_cpu[0][1] = cpu_right_receiver;
+  pair_cpu[0][2] = cpu_right_sender;
+  pair_cpu[0][3] = cpu_left_receiver;
+  memcpy(pair_mac[0][0], mac_left_tester, 6);
+  memcpy(pair_mac[0][1], mac_right_tester, 6);
+  memcpy(pair_mac[0][2], mac_left_dut, 6);
+  memcpy(pair_mac[0][3], mac_right_dut, 6);
+  pair_pool[0][0] = pkt_pool_left_sender;
+  pair_pool[0][1] = pkt_pool_right_receiver;
+  pair_pool[0][2] = pkt_pool_right_sender;
+  pair_pool[0][3] = pkt_pool_left_receiver;
+
+  // set up the additional port pairs (stateless tests only)
+  for ( unsigned i=1; i<port_pairs; i++ ) {
+    pair_port[i][0] = leftport+2*i;
+    pair_port[i][1] = rightport+2*i;
+    if ( initPortPair(i, left_sender_pool_size, right_sender_pool_size, receiver_pool_size) < 0 )
+      return -1;
+  }
+
+  // the frame rates can be checked now, as the link speeds are known (the speed reported by the software loopback ports is meaningless)
+  if ( !calibrate && checkFrameRates() < 0 )
+    return -1;
+
   // Some sanity checks: NUMA node of the cores and of the NICs are matching or not...
   if ( numa_available() == -1 )
     std::cout << "Info: This computer does not support NUMA." << std::endl;
@@ -849,6 +1501,28 @@ int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
   // prepare further values for testing
   hz = rte_get_timer_hz();		// number of clock cycles per second
 
+  if ( responder_echo ) {
+    // the ring is allocated from the memory of the NUMA node of the Responder's Sender
+    echo_ring = rte_ring_create("echo_ring", ECHO_RING_SIZE, rte_lcore_to_socket_id(stateful==1 ? cpu_right_sender : cpu_left_sender), 
+                                RING_F_SP_ENQ | RING_F_SC_DEQ);
+    if ( !echo_ring ) {
+      std::cerr << "Error: Cannot create ring for echo replies, Tester exits." << std::endl;
+      return -1;
+    }
+  }
+
+  if ( pipeline ) {
+    // the rings are allocated from the memory of the NUMA nodes of the senders
+    if ( forward )
+      pipeline_ring[0] = rte_ring_create("pipeline_ring_left", PIPELINE_RING_SIZE, rte_lcore_to_socket_id(cpu_left_sender), RING_F_SP_ENQ | RING_F_SC_DEQ);
+    if ( reverse )
+      pipeline_ring[1] = rte_ring_create("pipeline_ring_right", PIPELINE_RING_SIZE, rte_lcore_to_socket_id(cpu_right_sender), RING_F_SP_ENQ | RING_F_SC_DEQ);
+    if ( forward && !pipeline_ring[0] || reverse && !pipeline_ring[1] ) {
+      std::cerr << "Error: Cannot create ring for the frame preparation pipeline, Tester exits." << std::endl;
+      return -1;
+    }
+  }
+
   if ( stateful && enumerate_ports == 3 && enumerate_ips != 3 ) {
     // Pre-generation of unique source and destination port numbers is required
 
@@ -886,9 +1560,10 @@ int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
     rte_eal_wait_lcore(cpu_isend);
   }
 
-  if ( stateful && enumerate_ips == 3 && enumerate_ports != 3 ) {
+  if ( stateful && enumerate_ips == 3 && enumerate_ports != 3 && ip_left_bits == 16 && ip_right_bits == 16 ) {
     // Pre-generation of unique source and destination IP addresses is required
     // Note: not full IP addresses, but only their critical 16-bit parts are generated
+    // (wider fields are permuted on the fly by imsend, see randomPermutation)
 
     // collect IP addresses and lcore info
     uint16_t src_min, src_max, dst_min, dst_max;	// IP address (part) ranges
@@ -923,9 +1598,10 @@ int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
     rte_eal_wait_lcore(cpu_isend);
   }
 
-  if ( stateful && enumerate_ips == 3 && enumerate_ports == 3 ) {
+  if ( stateful && enumerate_ips == 3 && enumerate_ports == 3 && ip_left_bits == 16 && ip_right_bits == 16 ) {
     // Pre-generation of unique source and destination IP addresses and port numbers is required
     // Note: not full IP addresses, but only their critical 16-bit parts are generated
+    // (wider fields are permuted on the fly by imsend, see randomPermutation)
 
     // collect IP addresses, port numbers and lcore info
     uint16_t si_min, si_max, di_min, di_max;      // ranges for IP address parts
@@ -973,38 +1649,227 @@ int Throughput::init(const char *argv0, uint16_t leftport, uint16_t rightport) {
     rte_eal_wait_lcore(cpu_isend);
   }
 
-  if ( !stateful) {
-    // for stateless tests:
-    start_tsc = rte_rdtsc()+hz*START_DELAY/1000;	// Each active sender starts sending at this time
-    finish_receiving = start_tsc + hz*duration + hz*global_timeout/1000; // Each receiver stops at this time
-  }
-  else 
-  {
-    // for stateful tests:
-    // the sender of the Initiator starts sending preliminary frames at this time:
-    start_tsc_pre = rte_rdtsc() + hz*START_DELAY/1000; 
-    // the receiver of the Responder stops receiving preliminary frames at this time:
-    finish_receiving_pre = start_tsc_pre + hz*pre_frames/pre_rate + hz*pre_timeout/1000; 
-    // production test starts at this time:
-    start_tsc = start_tsc_pre + hz*pre_delay/1000;
-    // productions test receivers stop at this time:
-    finish_receiving = start_tsc + hz*duration + hz*global_timeout/1000; 
-  }
-  return 0;
-}
+  // preflight check of the host noise on the lcores
+  if ( noise_check && hostNoiseCheck() < 0 )
+    return -1;
 
-// calculates sender pool size, it is a virtual member function, redefined in derived classes
-int Throughput::senderPoolSize(int num_dest_nets, int varport) {
-  return 2*num_dest_nets*(varport ? N : 1) + PORT_TX_QUEUE_SIZE + 100; // 2*: fg. and bg. Test Frames
-  // if varport then everything exists in N copies, see the definition of N
+  setTimestamps();
+  return 0;
 }
 
-// calculates sender pool size, it is a virtual member function, will be redefined in derived classes
-int Throughput::senderPoolSize(int num_dest_nets, int varport, int ip_varies) {
-  return 2*num_dest_nets*(varport||ip_varies ? N : 1) + PORT_TX_QUEUE_SIZE + 100; // 2*: fg. and bg. Test Frames
-  // if varport then everything exists in N copies, see the definition of N
-  // note: if ip_varies then num_dest_nets is surely 1 (enforced by input checking)
-}
+// sets up an additional port pair (stateless tests only): configures and starts its ports, creates its packet pools
+// and TX/RX queues, waits for its links to come up, and checks the NUMA localty and TSC synchronization of its lcores
+int Throughput::initPortPair(unsigned i, int left_sender_pool_size, int right_sender_pool_size, int receiver_pool_size) {
+  struct rte_eth_conf cfg_port;		// for configuring the Ethernet ports
+  struct rte_eth_link link_info;	// for retrieving link info by rte_eth_link_get()
+  const char *pool_name[4] = { "pp_left_sender", "pp_right_receiver", "pp_right_sender", "pp_left_receiver" };
+  const char *cpu_name[4] = { "Left Sender", "Right Receiver", "Right Sender", "Left Receiver" };
+  int pool_size[4] = { left_sender_pool_size, receiver_pool_size, right_sender_pool_size, receiver_pool_size };
+  char name[RTE_MEMPOOL_NAMESIZE];	// name of the packet pool
+  int trials; 	// cycle variable for port state checking
+
+  memset(&cfg_port, 0, sizeof(cfg_port));
+  cfg_port.txmode.mq_mode = RTE_ETH_MQ_TX_NONE;	// no multi queues 
+  cfg_port.rxmode.mq_mode = RTE_ETH_MQ_RX_NONE;	// no multi queues 
+  if ( max_frame_size > 1518 ) // jumbo frames, see init()
+    cfg_port.rxmode.mtu = max_frame_size-RTE_ETHER_HDR_LEN-RTE_ETHER_CRC_LEN;
+
+  for ( int s=0; s<2; s++ ) { // left and right port
+    if ( !rte_eth_dev_is_valid_port(pair_port[i][s]) ) {
+      std::cerr << "Error: Network port #" << pair_port[i][s] << " of port pair " << i << " is not available, Tester exits." << std::endl;
+      return -1;
+    }
+    if ( checkMtu(pair_port[i][s], &cfg_port) < 0 )
+      return -1;
+    if ( rte_eth_dev_configure(pair_port[i][s], 1, 1, &cfg_port) < 0 ) {
+      std::cerr << "Error: Cannot configure network port #" << pair_port[i][s] << " of port pair " << i << ", Tester exits." << std::endl;
+      return -1;
+    }
+  }
+
+  // the packet pools are created even for the inactive direction, see the remark in init()
+  for ( int j=0; j<4; j++ ) {
+    int cpu = pair_cpu[i][j] >= 0 ? pair_cpu[i][j] : pair_cpu[i][j^2]; // lcores of the inactive direction may be unset
+    snprintf(name, RTE_MEMPOOL_NAMESIZE, "%s_%u", pool_name[j], i);
+    pair_pool[i][j] = rte_pktmbuf_pool_create(name, pool_size[j], PKTPOOL_CACHE, 0, mbufSize(), rte_lcore_to_socket_id(cpu));
+    if ( !pair_pool[i][j] ) {
+      std::cerr << "Error: Cannot create packet pool for " << cpu_name[j] << " of port pair " << i << ", Tester exits." << std::endl;
+      return -1;
+    }
+  }
+
+  // set up the TX/RX queues: pair_pool[i][1] and pair_pool[i][3] belong to the receivers
+  for ( int s=0; s<2; s++ ) { // left and right port
+    uint16_t port = pair_port[i][s];
+    if ( rte_eth_tx_queue_setup(port, 0, PORT_TX_QUEUE_SIZE, rte_eth_dev_socket_id(port), NULL) < 0 ||
+         rte_eth_rx_queue_setup(port, 0, PORT_RX_QUEUE_SIZE, rte_eth_dev_socket_id(port), NULL, pair_pool[i][s ? 1 : 3]) < 0 ) {
+      std::cerr << "Error: Cannot setup TX/RX queues for network port #" << port << " of port pair " << i << ", Tester exits." << std::endl;
+      return -1;
+    }
+    if ( rte_eth_dev_start(port) < 0 ) {
+      std::cerr << "Error: Cannot start network port #" << port << " of port pair " << i << ", Tester exits." << std::endl;
+      return -1;
+    }
+    if ( promisc )
+      rte_eth_promiscuous_enable(port);
+  }
+
+  // check links' states (wait for coming up), try maximum MAX_PORT_TRIALS times
+  for ( int s=0; s<2; s++ ) {
+    trials=0;
+    do {
+      if ( trials++ == MAX_PORT_TRIALS ) { 
+        std::cerr << "Error: Ethernet port #" << pair_port[i][s] << " of port pair " << i << " is DOWN, Tester exits." << std::endl;
+        return -1;
+      }
+      rte_eth_link_get(pair_port[i][s], &link_info);
+    } while ( link_info.link_status == RTE_ETH_LINK_DOWN );
+  }
+
+  // Some sanity checks: NUMA localty and TSC synchronization of the lcores of the active directions
+  for ( int j=0; j<4; j++ ) 
+    if ( j < 2 ? forward : reverse ) {
+      if ( numa_available() != -1 && numa_num_configured_nodes() > 1 )
+        numaCheck(pair_port[i][j == 0 || j == 3 ? 0 : 1], j == 0 || j == 3 ? "Left" : "Right", pair_cpu[i][j], cpu_name[j]);
+      check_tsc(pair_cpu[i][j], cpu_name[j]);
+    }
+  return 0;
+}
+
+// returns the highest frame rate that the link of the port can carry with the given frame size (0, if the link speed is unknown)
+// an Ethernet frame occupies the link for further 20 bytes: preamble and SFD (8) plus inter-frame gap (12)
+static uint32_t linkFrameRate(uint16_t port, uint16_t frame_size) {
+  struct rte_eth_link link_info;	// for retrieving link info by rte_eth_link_get()
+
+  if ( rte_eth_link_get_nowait(port, &link_info) < 0 || !link_info.link_speed || link_info.link_speed == RTE_ETH_SPEED_NUM_UNKNOWN )
+    return 0;
+  return (uint64_t)link_info.link_speed*1000000/((frame_size+20)*8); // link speed is given in Mbps
+}
+
+// checks the frame rates against the speed of the links of all sending ports, and sets max_frame_rate
+// the shortest frames of the direction are considered (foreground IPv4 frames are 20 bytes shorter than IPv6 ones)
+int Throughput::checkFrameRates() {
+  max_frame_rate = 0;
+  for ( unsigned i=0; i<port_pairs; i++ )
+    for ( int s=0; s<2; s++ ) {
+      // the left port sends in the forward direction, including the preliminary frames of stateful==1 and the echo replies of stateful==2
+      if ( !(s ? reverse || stateful==2 : forward || stateful==1) )
+        continue;
+      uint16_t frame_size = (s ? ip_right_version : ip_left_version) == 4 ? ipv4_frame_size : ipv6_frame_size;
+      if ( imix.sizes ) // the average IPv6 frame size of the IMIX (rounded up), background frames are ignored
+        frame_size = (imix.periodBits()/8 + imix.period-1)/imix.period - 20 - ((s ? ip_right_version : ip_left_version) == 4 ? 20 : 0);
+      uint32_t rate = linkFrameRate(pair_port[i][s], frame_size);
+      if ( !rate ) {
+        printf("Warning: The speed of network port #%u is unknown, the frame rate cannot be checked.\n", pair_port[i][s]);
+        continue;
+      }
+      if ( !max_frame_rate || rate < max_frame_rate )
+        max_frame_rate = rate;
+    }
+  if ( max_frame_rate ) {
+    std::cout << "Info: The maximum frame rate of the links is " << max_frame_rate << " fps." << std::endl;
+    if ( frame_rate > max_frame_rate ) {
+      std::cerr << "Input Error: Frame rate " << frame_rate << " exceeds the maximum frame rate of the links (" << max_frame_rate << ")." << std::endl;
+      return -1;
+    }
+    if ( stateful && pre_rate > max_frame_rate ) {
+      std::cerr << "Input Error: Preliminary frame rate 'R' " << pre_rate << " exceeds the maximum frame rate of the links (" << max_frame_rate << ")." << std::endl;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+// creates the software loopback ports of the self-calibration (Calibrate 1) from rte_rings, which are cross-connected by the forwarder:
+// what the Left Sender sends to the left port is forwarded to the right port, and vice versa (see calibrationForwarder())
+// the ports are created right after the EAL initialization, thus they get the IDs of the Left and Right Ports
+int Throughput::mkCalibrationPorts(uint16_t leftport, uint16_t rightport) {
+  const char *ring_name[4] = { "cal_left_tx", "cal_right_rx", "cal_right_tx", "cal_left_rx" };
+  int socket = rte_lcore_to_socket_id(cpu_forwarder);	// the rings are allocated from the memory of the NUMA node of the forwarder
+  int left, right;	// port IDs of the created ports
+
+  for ( int i=0; i<4; i++ ) {
+    // each ring has a single producer and a single consumer: a sender or a receiver, and the forwarder
+    calibration_ring[i] = rte_ring_create(ring_name[i], CALIBRATION_RING_SIZE, socket, RING_F_SP_ENQ | RING_F_SC_DEQ);
+    if ( !calibration_ring[i] ) {
+      std::cerr << "Error: Cannot create ring for the self-calibration, Tester exits." << std::endl;
+      return -1;
+    }
+  }
+  left = rte_eth_from_rings("cal_left", &calibration_ring[3], 1, &calibration_ring[0], 1, socket);
+  right = rte_eth_from_rings("cal_right", &calibration_ring[1], 1, &calibration_ring[2], 1, socket);
+  if ( left < 0 || right < 0 ) {
+    std::cerr << "Error: Cannot create software loopback ports for the self-calibration, Tester exits." << std::endl;
+    return -1;
+  }
+  if ( left != leftport || right != rightport ) {
+    std::cerr << "Error: The software loopback ports got the port IDs #" << left << " and #" << right << " instead of #" << leftport 
+              << " and #" << rightport << ", Tester exits." << std::endl;
+    return -1;
+  }
+  std::cout << "Info: Self-calibration: the network ports are replaced by software loopback ports, the DUT by lcore " << cpu_forwarder << "." << std::endl;
+  return 0;
+}
+
+// sets the starting times of sending and the finishing times of receiving for the next measurement
+// called by init(), and also before each step of the in-process searches
+void Throughput::setTimestamps() {
+  if ( !stateful) {
+    // for stateless tests:
+    start_tsc = rte_rdtsc()+hz*START_DELAY/1000;	// Each active sender starts sending at this time
+    finish_receiving = start_tsc + hz*duration + hz*global_timeout/1000; // Each receiver stops at this time
+  }
+  else 
+  {
+    // for stateful tests:
+    // the sender of the Initiator starts sending preliminary frames at this time:
+    start_tsc_pre = rte_rdtsc() + hz*START_DELAY/1000; 
+    // the receiver of the Responder stops receiving preliminary frames at this time:
+    finish_receiving_pre = start_tsc_pre + hz*pre_frames/pre_rate + hz*pre_timeout/1000; 
+    // production test starts at this time:
+    start_tsc = start_tsc_pre + hz*pre_delay/1000;
+    // productions test receivers stop at this time:
+    finish_receiving = start_tsc + hz*duration + hz*global_timeout/1000; 
+  }
+}
+
+// checks, if the port can receive the frames with the MTU set in cfg_port (only jumbo frames need checking)
+int Throughput::checkMtu(uint16_t port, const struct rte_eth_conf *cfg_port) {
+  struct rte_eth_dev_info dev_info;	// for retrieving the MTU limit of the port
+
+  if ( !cfg_port->rxmode.mtu )
+    return 0; // the default MTU is used
+  if ( rte_eth_dev_info_get(port, &dev_info) < 0 ) {
+    std::cerr << "Error: Cannot get device info of network port #" << port << ", Tester exits." << std::endl;
+    return -1;
+  }
+  if ( dev_info.max_mtu < cfg_port->rxmode.mtu ) {
+    std::cerr << "Error: Network port #" << port << " supports at most " << dev_info.max_mtu << " bytes MTU, but " << cfg_port->rxmode.mtu 
+              << " bytes are needed for the frame size, Tester exits." << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+// the data room size of the mbufs of the packet pools: jumbo frames are stored in a single, larger mbuf, thus no frame is segmented
+uint16_t Throughput::mbufSize() {
+  if ( max_frame_size > 1518 )
+    return RTE_PKTMBUF_HEADROOM + max_frame_size;
+  return RTE_MBUF_DEFAULT_BUF_SIZE;
+}
+
+// calculates sender pool size, it is a virtual member function, redefined in derived classes
+int Throughput::senderPoolSize(int num_dest_nets, int varport) {
+  return 2*num_dest_nets*(varport ? N : 1) + PORT_TX_QUEUE_SIZE + 100; // 2*: fg. and bg. Test Frames
+  // if varport then everything exists in N copies, see the definition of N
+}
+
+// calculates sender pool size, it is a virtual member function, will be redefined in derived classes
+int Throughput::senderPoolSize(int num_dest_nets, int varport, int ip_varies) {
+  return 2*num_dest_nets*(varport||ip_varies ? N : 1) + PORT_TX_QUEUE_SIZE + 100; // 2*: fg. and bg. Test Frames
+  // if varport then everything exists in N copies, see the definition of N
+  // note: if ip_varies then num_dest_nets is surely 1 (enforced by input checking)
+}
 
 //checks NUMA localty: is the NUMA node of network port and CPU the same?
 void Throughput::numaCheck(uint16_t port, const char *port_side, int cpu, const char *cpu_name) {
@@ -1018,6 +1883,279 @@ void Throughput::numaCheck(uint16_t port, const char *port_side, int cpu, const
       n_port << ", " << n_cpu << ", respectively." << std::endl; 
 }
 
+// host noise preflight check: all lcores of the active directions run noiseProbe() concurrently for NOISE_CHECK_MS,
+// and their gaps are reported together with the cpufreq governor and the isolation state of their CPU cores.
+// A sender having a gap longer than the frame interval would be late, and a receiver having a gap longer than the time
+// needed to fill its RX ring (PORT_RX_QUEUE_SIZE frame intervals) would drop frames during the test,
+// thus it results in a warning ('Noise-check 1') or in an error ('Noise-check 2').
+int Throughput::hostNoiseCheck() {
+  static const char *role_name[4] = { "Left Sender", "Right Receiver", "Right Sender", "Left Receiver" };
+  int cpu[4*MAX_PORT_PAIRS+2];			// lcores to be checked
+  char cpu_name[4*MAX_PORT_PAIRS+2][32];	// their names
+  int critical[4*MAX_PORT_PAIRS+2];		// 1 for senders, 2 for receivers, 0 for the helpers and the forwarder
+  uint64_t threshold[4*MAX_PORT_PAIRS+2];	// gaps longer than this are harmful (TSC cycles)
+  noiseProbeParameters pars[4*MAX_PORT_PAIRS+2];
+  int n = 0, noisy = 0;
+  int fwd_active = forward || stateful==1;	// the same conditions are used for building the list of lcores for the EAL
+  int rev_active = reverse || stateful==2;
+  uint64_t frame_interval = hz/frame_rate;	// frame_rate is already in frames per second (also with 'IMIX-bps')
+  char path[128], governor[32], isolated[256], nohz_full[256];
+
+  for ( unsigned i=0; i<port_pairs; i++ )
+    for ( int j=0; j<4; j++ )
+      if ( j < 2 ? fwd_active : rev_active ) {
+        cpu[n] = i ? pair_cpu[i][j] : j==0 ? cpu_left_sender : j==1 ? cpu_right_receiver : j==2 ? cpu_right_sender : cpu_left_receiver;
+        if ( i )
+          snprintf(cpu_name[n], 32, "Pair %u %s", i, role_name[j]);
+        else
+          snprintf(cpu_name[n], 32, "%s", role_name[j]);
+        threshold[n] = j%2 ? PORT_RX_QUEUE_SIZE*frame_interval : frame_interval; // a receiver may be late until its RX ring is full
+        critical[n++] = j%2 ? 2 : 1;
+      }
+  if ( schedule || pipeline ) {
+    if ( forward && cpu_left_helper >= 0 ) {
+      cpu[n] = cpu_left_helper;
+      snprintf(cpu_name[n], 32, "Left Helper");
+      threshold[n] = frame_interval;
+      critical[n++] = 0;
+    }
+    if ( reverse && cpu_right_helper >= 0 ) {
+      cpu[n] = cpu_right_helper;
+      snprintf(cpu_name[n], 32, "Right Helper");
+      threshold[n] = frame_interval;
+      critical[n++] = 0;
+    }
+  }
+  if ( calibrate ) {
+    cpu[n] = cpu_forwarder;
+    snprintf(cpu_name[n], 32, "Forwarder");
+    threshold[n] = frame_interval;
+    critical[n++] = 0;
+  }
+
+  // the probes run concurrently, like the senders and receivers during the test
+  for ( int k=0; k<n; k++ ) {
+    pars[k] = noiseProbeParameters(hz*NOISE_CHECK_MS/1000, threshold[k]);
+    if ( rte_eal_remote_launch(noiseProbe, &pars[k], cpu[k]) )
+      rte_exit(EXIT_FAILURE, "Error: could not start host noise probe on core #%i for %s!\n", cpu[k], cpu_name[k]);
+  }
+  for ( int k=0; k<n; k++ )
+    rte_eal_wait_lcore(cpu[k]);
+
+  if ( readSysfs("/sys/devices/system/cpu/isolated", isolated, 256) < 0 )
+    isolated[0] = 0;
+  if ( readSysfs("/sys/devices/system/cpu/nohz_full", nohz_full, 256) < 0 )
+    nohz_full[0] = 0;
+  for ( int k=0; k<n; k++ ) {
+    int cpu_id = rte_lcore_to_cpu_id(cpu[k]);
+    int iso = inCpuList(isolated, cpu_id), nohz = inCpuList(nohz_full, cpu_id);
+    snprintf(path, 128, "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cpu_id);
+    if ( readSysfs(path, governor, 32) < 0 )
+      snprintf(governor, 32, "unknown");
+    printf("Info: Host noise of lcore %d (%s, CPU %d): max. gap: %.3lf us, %lu gaps longer than %.3lf us "
+           "taking %.4lf%% of the time; governor: %s, isolated: %s, nohz_full: %s\n", cpu[k], cpu_name[k], cpu_id,
+           1000000.0*pars[k].max_gap/hz, pars[k].gaps, 1000000.0*threshold[k]/hz, 100.0*pars[k].gap_cycles/pars[k].duration,
+           governor, iso ? "yes" : "no", nohz ? "yes" : "no");
+    if ( !critical[k] )
+      continue;
+    if ( strcmp(governor, "performance") && strcmp(governor, "unknown") )
+      printf("Warning: The cpufreq governor of the CPU core of the %s is '%s' instead of 'performance'.\n", cpu_name[k], governor);
+    if ( !iso )
+      printf("Warning: The CPU core of the %s is not isolated ('isolcpus' kernel parameter), other tasks may preempt it.\n", cpu_name[k]);
+    if ( pars[k].gaps ) {
+      noisy++;
+      if ( critical[k] == 1 )
+        printf("Warning: The %s had gaps longer than the frame interval, it may be late during the test.\n", cpu_name[k]);
+      else
+        printf("Warning: The %s had gaps longer than the time needed to fill its RX ring, it may drop frames during the test.\n", cpu_name[k]);
+    }
+  }
+  if ( noisy && noise_check == 2 ) {
+    std::cerr << "Error: " << noisy << " sender or receiver lcore(s) are too noisy for the requested frame rate ('Noise-check 2'), Tester exits." << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+// automatic NUMA-aware placement ('CPU-placement 1'): each sender, receiver and helper lcore not set in the config file
+// is chosen from the enabled lcores on the NUMA node of its port (preferring isolated CPU cores), excluding the main lcore,
+// the lcores already chosen or set, and their hyper-threading siblings; the placement of all lcores is logged.
+int Throughput::placeLcores(uint16_t leftport, uint16_t rightport) {
+  static const char *role_name[4] = { "Left Sender", "Right Receiver", "Right Sender", "Left Receiver" };
+  int *cpu[4*MAX_PORT_PAIRS+2];			// lcores to be placed
+  char cpu_name[4*MAX_PORT_PAIRS+2][32];	// their names
+  int socket[4*MAX_PORT_PAIRS+2];		// NUMA nodes of their ports (-1: unknown or software loopback port)
+  int used[RTE_MAX_LCORE] = {0};
+  int n = 0;
+  int fwd_active = forward || stateful==1;	// the same conditions are used for building the list of lcores for the EAL
+  int rev_active = reverse || stateful==2;
+  char isolated[256];
+
+  for ( unsigned i=0; i<port_pairs; i++ )
+    for ( int j=0; j<4; j++ )
+      if ( j < 2 ? fwd_active : rev_active ) {
+        cpu[n] = i ? &pair_cpu[i][j] : j==0 ? &cpu_left_sender : j==1 ? &cpu_right_receiver : j==2 ? &cpu_right_sender : &cpu_left_receiver;
+        if ( i )
+          snprintf(cpu_name[n], 32, "Pair %u %s", i, role_name[j]);
+        else
+          snprintf(cpu_name[n], 32, "%s", role_name[j]);
+        socket[n++] = calibrate ? -1 : rte_eth_dev_socket_id(j == 0 || j == 3 ? leftport+2*i : rightport+2*i);
+      }
+  if ( pipeline || schedule ) { // the helpers are optional with 'Schedule 1', only the ones set in the config file are used
+    if ( forward && (pipeline || cpu_left_helper >= 0) ) {
+      cpu[n] = &cpu_left_helper;
+      snprintf(cpu_name[n], 32, "Left Helper");
+      socket[n++] = calibrate ? -1 : rte_eth_dev_socket_id(leftport);
+    }
+    if ( reverse && (pipeline || cpu_right_helper >= 0) ) {
+      cpu[n] = &cpu_right_helper;
+      snprintf(cpu_name[n], 32, "Right Helper");
+      socket[n++] = calibrate ? -1 : rte_eth_dev_socket_id(rightport);
+    }
+  }
+  if ( calibrate ) {
+    cpu[n] = &cpu_forwarder;
+    snprintf(cpu_name[n], 32, "Forwarder");
+    socket[n++] = -1;
+  }
+
+  // the main lcore and the lcores set in the config file are not available
+  markSiblings(rte_get_main_lcore(), used);
+  for ( int k=0; k<n; k++ )
+    if ( *cpu[k] >= 0 ) {
+      if ( !rte_lcore_is_enabled(*cpu[k]) ) {
+        std::cerr << "Error: Lcore " << *cpu[k] << " set for the " << cpu_name[k] << " is not available, Tester exits." << std::endl;
+        return -1;
+      }
+      markSiblings(*cpu[k], used);
+    }
+
+  if ( readSysfs("/sys/devices/system/cpu/isolated", isolated, 256) < 0 )
+    isolated[0] = 0;
+  for ( int k=0; k<n; k++ ) {
+    if ( *cpu[k] >= 0 ) {
+      printf("Info: Placement: %s on lcore %d (NUMA node %u) as set in the config file.\n", cpu_name[k], *cpu[k], rte_lcore_to_socket_id(*cpu[k]));
+      continue;
+    }
+    // score: 2 for being on the NUMA node of the port, 1 for being isolated
+    int best = -1, best_score = -1;
+    for ( int l=0; l<RTE_MAX_LCORE; l++ ) {
+      if ( !rte_lcore_is_enabled(l) || used[l] )
+        continue;
+      int score = 2*(socket[k] < 0 || (int)rte_lcore_to_socket_id(l) == socket[k]) + inCpuList(isolated, rte_lcore_to_cpu_id(l));
+      if ( score > best_score ) {
+        best = l;
+        best_score = score;
+      }
+    }
+    if ( best < 0 ) {
+      std::cerr << "Error: No free lcore is left for the " << cpu_name[k] << ", Tester exits." << std::endl;
+      return -1;
+    }
+    *cpu[k] = best;
+    markSiblings(best, used);
+    printf("Info: Placement: %s on lcore %d (NUMA node %u) was chosen automatically.\n", cpu_name[k], best, rte_lcore_to_socket_id(best));
+    if ( best_score < 2 )
+      printf("Warning: No free lcore is left on NUMA node %d of the port of the %s.\n", socket[k], cpu_name[k]);
+  }
+  return 0;
+}
+
+// sets the duration and the threshold, the results are zeroed
+noiseProbeParameters::noiseProbeParameters(uint64_t duration_, uint64_t threshold_) {
+  duration = duration_;
+  threshold = threshold_;
+  max_gap = 0;
+  gaps = 0;
+  gap_cycles = 0;
+}
+
+// reads the TSC in a tight loop for the given duration and records the gaps between the consecutive reads
+int noiseProbe(void *par) {
+  noiseProbeParameters *p = (noiseProbeParameters *)par;
+  uint64_t prev, now, gap, finish;
+
+  prev = rte_rdtsc();
+  finish = prev + p->duration;
+  while ( (now = rte_rdtsc()) < finish ) {
+    gap = now - prev;
+    if ( unlikely( gap > p->threshold ) ) {
+      p->gaps++;
+      p->gap_cycles += gap;
+    }
+    if ( unlikely( gap > p->max_gap ) )
+      p->max_gap = gap;
+    prev = now;
+  }
+  return 0;
+}
+
+// reads the first line of a (sysfs) file without the trailing newline, returns -1 if it cannot be read
+int readSysfs(const char *path, char *buf, int size) {
+  FILE *f = fopen(path, "r");
+  if ( !f )
+    return -1;
+  if ( !fgets(buf, size, f) ) {
+    fclose(f);
+    return -1;
+  }
+  fclose(f);
+  buf[strcspn(buf, "\n")] = 0;
+  return 0;
+}
+
+// checks if the CPU is in a cpulist of the kernel (e.g. "2-7,10")
+int inCpuList(const char *list, int cpu) {
+  int first, last, len;
+  while ( sscanf(list, "%d%n", &first, &len) == 1 ) {
+    list += len;
+    last = first;
+    if ( *list == '-' && sscanf(list+1, "%d%n", &last, &len) == 1 )
+      list += 1+len;
+    if ( cpu >= first && cpu <= last )
+      return 1;
+    if ( *list != ',' )
+      break;
+    list++;
+  }
+  return 0;
+}
+
+// prepares the list of the online CPUs (below RTE_MAX_LCORE) for the EAL, returns -1 if it cannot be done
+int onlineCpuList(char *buf, int size) {
+  char online[256];
+  int len = 0, first = -1;
+
+  if ( readSysfs("/sys/devices/system/cpu/online", online, 256) < 0 )
+    return -1;
+  buf[0] = 0;
+  for ( int cpu=0; cpu<=RTE_MAX_LCORE; cpu++ ) {
+    int on = cpu < RTE_MAX_LCORE && inCpuList(online, cpu);
+    if ( on && first < 0 )
+      first = cpu;
+    if ( !on && first >= 0 ) { // a range of online CPUs ends
+      len += snprintf(buf+len, size-len, first == cpu-1 ? "%s%d" : "%s%d-%d", len ? "," : "", first, cpu-1);
+      if ( len >= size )
+        return -1;
+      first = -1;
+    }
+  }
+  return len ? 0 : -1;
+}
+
+// marks the lcore and its hyper-threading siblings as used
+void markSiblings(int lcore, int *used) {
+  char path[128], siblings[256];
+
+  used[lcore] = 1;
+  snprintf(path, 128, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", rte_lcore_to_cpu_id(lcore));
+  if ( readSysfs(path, siblings, 256) < 0 )
+    return;
+  for ( int l=0; l<RTE_MAX_LCORE; l++ )
+    if ( rte_lcore_is_enabled(l) && inCpuList(siblings, rte_lcore_to_cpu_id(l)) )
+      used[l] = 1;
+}
+
 // reports the TSC of the core (in the variable pointed by the input parameter), on which it is running
 int report_tsc(void *par) {
    *(uint64_t *)par = rte_rdtsc();
@@ -1038,15 +2176,118 @@ void check_tsc(int cpu, const char *cpu_name) {
     rte_exit(EXIT_FAILURE, "Error: TSC of core #%i for %s is not synchronized with that of the main core!\n", cpu, cpu_name);
 }
 
+// sets the lcores, the offset is measured by measure()
+tscOffset::tscOffset(int sender_, int receiver_) {
+  sender = sender_;
+  receiver = receiver_;
+  offset = offset_before = 0;
+  error = error_before = 0;
+}
+
+// the sender side of the ping-pong: keeps the result of the round with the shortest round-trip time
+int tscPing(void *par) {
+  class tscOffset *p = (class tscOffset *)par;
+  uint64_t t1, t3, rtt, best_rtt = UINT64_MAX;
+
+  for ( uint64_t r=1; r<=TSC_PINGPONG_ROUNDS; r++ ) {
+    t1 = rte_rdtsc();
+    p->round.store(r, std::memory_order_release);
+    while ( p->reply.load(std::memory_order_acquire) != r ); // Beware: an "empty" loop
+    t3 = rte_rdtsc();
+    rtt = t3 - t1;
+    if ( rtt < best_rtt ) {
+      best_rtt = rtt;
+      p->offset = (int64_t)(p->tsc.load(std::memory_order_relaxed) - t1 - rtt/2);
+      p->error = (rtt+1)/2;
+    }
+  }
+  return 0;
+}
+
+// the receiver side of the ping-pong: replies with its TSC to each round
+int tscPong(void *par) {
+  class tscOffset *p = (class tscOffset *)par;
+
+  for ( uint64_t r=1; r<=TSC_PINGPONG_ROUNDS; r++ ) {
+    while ( p->round.load(std::memory_order_acquire) != r ); // Beware: an "empty" loop
+    p->tsc.store(rte_rdtsc(), std::memory_order_relaxed);
+    p->reply.store(r, std::memory_order_release);
+  }
+  return 0;
+}
+
+// measures the offset of the TSC of the receiver lcore relative to that of the sender lcore (both of them must be idle)
+void tscOffset::measure() {
+  round.store(0);
+  reply.store(0);
+  if ( rte_eal_remote_launch(tscPong, this, receiver) )
+    rte_exit(EXIT_FAILURE, "Error: could not start TSC offset measurement on core #%i!\n", receiver);
+  if ( rte_eal_remote_launch(tscPing, this, sender) )
+    rte_exit(EXIT_FAILURE, "Error: could not start TSC offset measurement on core #%i!\n", sender);
+  rte_eal_wait_lcore(sender);
+  rte_eal_wait_lcore(receiver);
+}
+
+// zeroes the receive timestamps for the next repetition of the measurement
+int clearTimestamps(void *par) {
+  class clearParameters *p = (class clearParameters *)par;
+  memset(p->ts, 0, p->num*sizeof(uint64_t));
+  return 0;
+}
+
+// measures the offset again after the test, and corrects the receive timestamps (0 means lost) by the average of the offset
+// before and after the test, thus a linear drift during the test is also compensated for on average
+void tscOffset::correct(uint64_t num_timestamps, uint64_t *receive_ts, uint64_t hz, const char *side) {
+  int64_t correction;
+  uint64_t max_error;	// maximum error of the correction: that of the measurements plus half of the drift
+
+  offset_before = offset;
+  error_before = error;
+  measure();
+  correction = (offset_before + offset) / 2;
+  max_error = (error_before > error ? error_before : error) + (offset > offset_before ? offset-offset_before : offset_before-offset)/2;
+  printf("Info: %s TSC offset of the receiver: %.3lf us before, %.3lf us after the test, correction: %.3lf us (max. error: %.3lf us)\n",
+         side, 1000000.0*offset_before/hz, 1000000.0*offset/hz, 1000000.0*correction/hz, 1000000.0*max_error/hz);
+  if ( correction )
+    for ( uint64_t i=0; i<num_timestamps; i++ )
+      if ( receive_ts[i] )
+        receive_ts[i] -= correction;
+}
+
+// checks, whether the PMD of the port supports cleaning up its TX descriptors on request
+frameReuse::frameReuse(uint16_t eth_id_, const char *side) {
+  eth_id = eth_id_;
+  cleanup = rte_eth_tx_done_cleanup(eth_id, 0, 0) != -ENOTSUP;
+  copies = cleanup ? FRAME_COPIES : N;
+  if ( !cleanup )
+    printf("Warning: %s sender: the PMD of port %u cannot clean up TX descriptors on request, %d copies are reused without waiting.\n", 
+           side, eth_id, N);
+}
+
+// waits until the PMD releases the copy: the TX descriptors are cleaned up once per REUSE_POLLS reads of the reference count,
+// as a PMD freeing its mbufs lazily would otherwise be forced to run a cleanup for each read
+void frameReuse::reclaim(struct rte_mbuf *m) {
+  for ( unsigned polls=0; rte_mbuf_refcnt_read(m) > 1; polls++ )
+    if ( polls % REUSE_POLLS == 0 )
+      rte_eth_tx_done_cleanup(eth_id, 0, 0);
+}
+
+// releases the references of the sender, the mbufs are returned to the pool when the PMD also released them
+frameReuse::~frameReuse() {
+  for ( struct rte_mbuf *m : frames )
+    rte_pktmbuf_free(m);
+}
+
 // Several functions follow to create IPv4 or IPv6 Test Frames
 // Please refer to RFC 2544 Appendix C.2.6.4 "Test Frames" for the values to be set in the test frames.
 
 // creates an IPv4 Test Frame using several helper functions
 // BEHAVIOR: If both port numbers are nonzero, then it really creates a FINAL test frame, however,
 // if any of the port numbers are zero, it only includes a "raw", uncomplemented checksum to support further processing.
+// If tcp_flags is nonzero, then the frame carries a TCP segment with these flags instead of a UDP datagram.
 struct rte_mbuf *mkFinalTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
                               const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
-                              const uint32_t *src_ip, const uint32_t *dst_ip, unsigned sport, unsigned dport) {
+                              const uint32_t *src_ip, const uint32_t *dst_ip, unsigned sport, unsigned dport, uint8_t tcp_flags) {
   struct rte_mbuf *pkt_mbuf=rte_pktmbuf_alloc(pkt_pool); // message buffer for the Test Frame
   if ( !pkt_mbuf )
     rte_exit(EXIT_FAILURE, "Error: %s sender can't allocate a new mbuf for the IPv4 Test Frame! \n", side);
@@ -1055,20 +2296,27 @@ struct rte_mbuf *mkFinalTestFrame4(uint16_t length, rte_mempool *pkt_pool, const
   uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbuf, uint8_t *); // Access the Test Frame in the message buffer
   rte_ether_hdr *eth_hdr = reinterpret_cast<struct rte_ether_hdr *>(pkt); // Ethernet header
   rte_ipv4_hdr *ip_hdr = reinterpret_cast<rte_ipv4_hdr *>(pkt+sizeof(rte_ether_hdr)); // IPv4 header
-  rte_udp_hdr *udp_hd = reinterpret_cast<rte_udp_hdr *>(pkt+sizeof(rte_ether_hdr)+sizeof(rte_ipv4_hdr)); // UDP header
-  uint8_t *udp_data = reinterpret_cast<uint8_t*>(pkt+sizeof(rte_ether_hdr)+sizeof(rte_ipv4_hdr)+sizeof(rte_udp_hdr)); // UDP data
+  rte_udp_hdr *udp_hd = reinterpret_cast<rte_udp_hdr *>(pkt+sizeof(rte_ether_hdr)+sizeof(rte_ipv4_hdr)); // UDP header (or TCP header)
+  rte_tcp_hdr *tcp_hd = reinterpret_cast<rte_tcp_hdr *>(udp_hd); // TCP header (used only if tcp_flags is nonzero)
+  int l4_hdr_length = tcp_flags ? sizeof(rte_tcp_hdr) : sizeof(rte_udp_hdr);
+  uint8_t *udp_data = reinterpret_cast<uint8_t*>(pkt+sizeof(rte_ether_hdr)+sizeof(rte_ipv4_hdr)+l4_hdr_length); // UDP (or TCP) data
+  uint16_t *l4_cksum = tcp_flags ? &tcp_hd->cksum : &udp_hd->dgram_cksum; // UDP or TCP checksum
 
   mkEthHeader(eth_hdr, dst_mac, src_mac, 0x0800); 	// contains an IPv4 packet
   int ip_length = length - sizeof(rte_ether_hdr);
   mkIpv4Header(ip_hdr, ip_length, src_ip, dst_ip); 	// Does not set IPv4 header checksum
   int udp_length = ip_length - sizeof(rte_ipv4_hdr); 	// No IP Options are used
-  mkUdpHeader(udp_hd, udp_length, sport, dport);			
-  int data_legth = udp_length - sizeof(rte_udp_hdr);
+  if ( tcp_flags ) {
+    ip_hdr->next_proto_id = 0x06; // TCP
+    mkTcpHeader(tcp_hd, sport, dport, tcp_flags);
+  } else
+    mkUdpHeader(udp_hd, udp_length, sport, dport);			
+  int data_legth = udp_length - l4_hdr_length;
   mkData(udp_data, data_legth);
   if ( sport && dport ) {
     // The non-zero value of both port numbers means that they have fixed values in the test frame,
     // therefore, final UDP checksum may be calculated and set.
-    udp_hd->dgram_cksum = rte_ipv4_udptcp_cksum( ip_hdr, udp_hd ); // UDP checksum is calculated and set
+    *l4_cksum = rte_ipv4_udptcp_cksum( ip_hdr, udp_hd ); // UDP checksum is calculated and set
   }
   else {
     // At least one of the port numbers will change, thus UDP checksum will need to be manipulated later.
@@ -1076,7 +2324,7 @@ struct rte_mbuf *mkFinalTestFrame4(uint16_t length, rte_mempool *pkt_pool, const
     cksum += rte_ipv4_phdr_cksum(ip_hdr, 0);
     cksum = ((cksum & 0xffff0000) >> 16) + (cksum & 0xffff);
     cksum = ((cksum & 0xffff0000) >> 16) + (cksum & 0xffff);    // twice must be enough
-    udp_hd->dgram_cksum = (uint16_t)cksum;      // The uncomplemented UDP checksum is stored (for further processing).
+    *l4_cksum = (uint16_t)cksum;      // The uncomplemented UDP checksum is stored (for further processing).
   }
   ip_hdr->hdr_checksum = rte_ipv4_cksum(ip_hdr);	// IPv4 header checksum is set now
   return pkt_mbuf;
@@ -1087,8 +2335,15 @@ struct rte_mbuf *mkFinalTestFrame4(uint16_t length, rte_mempool *pkt_pool, const
 struct rte_mbuf *mkTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
                               const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                               const uint32_t *src_ip, const uint32_t *dst_ip, unsigned var_sport, unsigned var_dport) {
+  return mkTestFrame4(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,var_sport,var_dport,0); // 0: UDP
+}
+
+// the same as above, but it creates a TCP segment with the given flags, if tcp_flags is nonzero
+struct rte_mbuf *mkTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
+                              const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
+                              const uint32_t *src_ip, const uint32_t *dst_ip, unsigned var_sport, unsigned var_dport, uint8_t tcp_flags) {
   // sport/dport are set to 0, if they will change, otherwise follow RFC 2544 Test Frame format
-  struct rte_mbuf *pkt_mbuf=mkFinalTestFrame4(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,var_sport ? 0 : 0xC020,var_dport ? 0 : 0x0007);
+  struct rte_mbuf *pkt_mbuf=mkFinalTestFrame4(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,var_sport ? 0 : 0xC020,var_dport ? 0 : 0x0007,tcp_flags);
   // The above function terminated the Tester if it could not allocate memory, thus no error handling is needed here. :-)
   return pkt_mbuf;
 }
@@ -1100,12 +2355,19 @@ struct rte_mbuf *mkTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char
 struct rte_mbuf *mkVaripTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
                                    const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                                    const uint32_t *src_ip, const uint32_t *dst_ip, unsigned var_sport, unsigned var_dport) {
-  struct rte_mbuf *pkt_mbuf=mkFinalTestFrame4(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,0,0);
+  return mkVaripTestFrame4(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,var_sport,var_dport,0); // 0: UDP
+}
+
+// the same as above, but it creates a TCP segment with the given flags, if tcp_flags is nonzero
+struct rte_mbuf *mkVaripTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
+                                   const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
+                                   const uint32_t *src_ip, const uint32_t *dst_ip, unsigned var_sport, unsigned var_dport, uint8_t tcp_flags) {
+  struct rte_mbuf *pkt_mbuf=mkFinalTestFrame4(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,0,0,tcp_flags);
   // The above function terminated the Tester if it could not allocate memory, thus no error handling is needed here. :-)
   uint8_t* pkt = rte_pktmbuf_mtod(pkt_mbuf, uint8_t *); // Access the Test Frame in the message buffer
   uint16_t *udp_sport = (uint16_t *) (pkt + 34);
   uint16_t *udp_dport = (uint16_t *) (pkt + 36);
-  uint16_t *udp_chksum = (uint16_t *) (pkt + 40);
+  uint16_t *udp_chksum = (uint16_t *) (pkt + (tcp_flags ? 50 : 40)); // 14+20+16: TCP checksum, 14+20+6: UDP checksum
   uint32_t chksum = *udp_chksum;
   if ( !var_sport )
     chksum += *udp_sport = htons(0xC020);       // set source port and add to checksum
@@ -1149,6 +2411,19 @@ void mkUdpHeader(struct rte_udp_hdr *udp, uint16_t length, unsigned sport, unsig
   udp->dgram_cksum = 0; // UDP checksum is set to 0 now, it will be calculated later.
 }
 
+// creates a TCP header (no options are used)
+void mkTcpHeader(struct rte_tcp_hdr *tcp, unsigned sport, unsigned dport, uint8_t tcp_flags) {
+  tcp->src_port = htons(sport);
+  tcp->dst_port = htons(dport);
+  tcp->sent_seq = htonl(1);
+  tcp->recv_ack = htonl(tcp_flags & RTE_TCP_ACK_FLAG ? 1 : 0);
+  tcp->data_off = 0x50; // Data offset: 20/4=5
+  tcp->tcp_flags = tcp_flags;
+  tcp->rx_win = htons(0xffff);
+  tcp->cksum = 0; // TCP checksum is set to 0 now, it will be calculated later.
+  tcp->tcp_urp = 0;
+}
+
 // fills the data field of the Test Frame
 void mkData(uint8_t *data, uint16_t length) {
   unsigned i;
@@ -1161,12 +2436,28 @@ void mkData(uint8_t *data, uint16_t length) {
     data[i] = i % 256;
 }
 
+// writes a time stamp into the UDP data of a foreground Test Frame for round-trip time measurement (Responder-echo 1)
+// 'data' points to the UDP data, the 8 bytes following 'IDENTIFY' are overwritten: the low 32 bits of the TSC 
+// and two compensation words, which keep the one's complement sum of these 8 bytes (and the UDP checksum) unchanged
+void stampEcho(uint8_t *data, uint64_t tsc) {
+  static const uint8_t pattern[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };	// the 8 bytes written by mkData
+  static const uint16_t pattern_sum = rte_raw_cksum(pattern, 8);	// their one's complement sum
+  uint16_t *word = (uint16_t *)(data+8);
+  uint32_t sum;
+  *(uint32_t *)word = (uint32_t) tsc;		// words 0 and 1: time stamp
+  word[2] = ~word[0];				// word 0 + word 2 = 0xffff, that is, zero in one's complement arithmetic
+  sum = (uint16_t)~word[1] + pattern_sum;	// word 1 + word 3 = 0xffff + pattern_sum
+  sum = ((sum & 0xffff0000) >> 16) + (sum & 0xffff);
+  word[3] = (uint16_t) sum;
+}
+
 // creates an IPv6 Test Frame using several helper functions
 // BEHAVIOR: If both port numbers are nonzero, then it really creates a FINAL test frame, however,
 // if any of the port numbers are zero, it only includes a "raw", uncomplemented checksum to support further processing.
+// If tcp_flags is nonzero, then the frame carries a TCP segment with these flags instead of a UDP datagram.
 struct rte_mbuf *mkFinalTestFrame6(uint16_t length, rte_mempool *pkt_pool, const char *side,
                               const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
-                              const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned sport, unsigned dport) {
+                              const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned sport, unsigned dport, uint8_t tcp_flags) {
   struct rte_mbuf *pkt_mbuf=rte_pktmbuf_alloc(pkt_pool); // message buffer for the Test Frame
   if ( !pkt_mbuf )
     rte_exit(EXIT_FAILURE, "Error: %s sender can't allocate a new mbuf for the IPv6 Test Frame! \n", side);
@@ -1175,25 +2466,32 @@ struct rte_mbuf *mkFinalTestFrame6(uint16_t length, rte_mempool *pkt_pool, const
   uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbuf, uint8_t *); // Access the Test Frame in the message buffer
   rte_ether_hdr *eth_hdr = reinterpret_cast<struct rte_ether_hdr *>(pkt); // Ethernet header
   rte_ipv6_hdr *ip_hdr = reinterpret_cast<rte_ipv6_hdr *>(pkt+sizeof(rte_ether_hdr)); // IPv6 header
-  rte_udp_hdr *udp_hd = reinterpret_cast<rte_udp_hdr *>(pkt+sizeof(rte_ether_hdr)+sizeof(rte_ipv6_hdr)); // UDP header
-  uint8_t *udp_data = reinterpret_cast<uint8_t*>(pkt+sizeof(rte_ether_hdr)+sizeof(rte_ipv6_hdr)+sizeof(rte_udp_hdr)); // UDP data
+  rte_udp_hdr *udp_hd = reinterpret_cast<rte_udp_hdr *>(pkt+sizeof(rte_ether_hdr)+sizeof(rte_ipv6_hdr)); // UDP header (or TCP header)
+  rte_tcp_hdr *tcp_hd = reinterpret_cast<rte_tcp_hdr *>(udp_hd); // TCP header (used only if tcp_flags is nonzero)
+  int l4_hdr_length = tcp_flags ? sizeof(rte_tcp_hdr) : sizeof(rte_udp_hdr);
+  uint8_t *udp_data = reinterpret_cast<uint8_t*>(pkt+sizeof(rte_ether_hdr)+sizeof(rte_ipv6_hdr)+l4_hdr_length); // UDP (or TCP) data
+  uint16_t *l4_cksum = tcp_flags ? &tcp_hd->cksum : &udp_hd->dgram_cksum; // UDP or TCP checksum
 
   mkEthHeader(eth_hdr, dst_mac, src_mac, 0x86DD); // contains an IPv6 packet
   int ip_length = length - sizeof(rte_ether_hdr);
   mkIpv6Header(ip_hdr, ip_length, src_ip, dst_ip); 
   int udp_length = ip_length - sizeof(rte_ipv6_hdr); // No IP Options are used
-  mkUdpHeader(udp_hd, udp_length, sport, dport);
-  int data_legth = udp_length - sizeof(rte_udp_hdr);
+  if ( tcp_flags ) {
+    ip_hdr->proto = 0x06; // TCP
+    mkTcpHeader(tcp_hd, sport, dport, tcp_flags);
+  } else
+    mkUdpHeader(udp_hd, udp_length, sport, dport);
+  int data_legth = udp_length - l4_hdr_length;
   mkData(udp_data, data_legth);
   uint16_t cksum = rte_ipv6_udptcp_cksum( ip_hdr, udp_hd ); // UDP checksum is calculated
   if ( sport && dport ) {
     // The non-zero value of both port numbers means that they have fixed values in the test frame,
     // therefore, final UDP checksum may be set.
-    udp_hd->dgram_cksum = cksum;        // The final UDP checksum is set.
+    *l4_cksum = cksum;        // The final UDP checksum is set.
   }
   else {
     // At least one of the port numbers will change, thus UDP checksum will need to be manipulated later.
-    udp_hd->dgram_cksum = ~cksum;      // The uncomplemented UDP checksum is stored (for further processing).
+    *l4_cksum = ~cksum;      // The uncomplemented UDP checksum is stored (for further processing).
   }
 
   return pkt_mbuf;
@@ -1204,8 +2502,16 @@ struct rte_mbuf *mkFinalTestFrame6(uint16_t length, rte_mempool *pkt_pool, const
 struct rte_mbuf *mkTestFrame6(uint16_t length, rte_mempool *pkt_pool, const char *side,
                               const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                               const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned var_sport, unsigned var_dport) {
+  return mkTestFrame6(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,var_sport,var_dport,0); // 0: UDP
+}
+
+// the same as above, but it creates a TCP segment with the given flags, if tcp_flags is nonzero
+struct rte_mbuf *mkTestFrame6(uint16_t length, rte_mempool *pkt_pool, const char *side,
+                              const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
+                              const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned var_sport, unsigned var_dport,
+                              uint8_t tcp_flags) {
   // sport/dport are set to 0, if they will change, otherwise follow RFC 2544 Test Frame format
-  struct rte_mbuf *pkt_mbuf=mkFinalTestFrame6(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,var_sport ? 0 : 0xC020,var_dport ? 0 : 0x0007);
+  struct rte_mbuf *pkt_mbuf=mkFinalTestFrame6(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,var_sport ? 0 : 0xC020,var_dport ? 0 : 0x0007,tcp_flags);
   // The above function terminated the Tester if it could not allocate memory, thus no error handling is needed here. :-)
   return pkt_mbuf;
 }
@@ -1218,12 +2524,20 @@ struct rte_mbuf *mkVaripTestFrame6(uint16_t length, rte_mempool *pkt_pool, const
                                    const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                                    const struct in6_addr *src_ip, const struct in6_addr *dst_ip,
                                    unsigned var_sport, unsigned var_dport) {
-  struct rte_mbuf *pkt_mbuf=mkFinalTestFrame6(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,0,0);
+  return mkVaripTestFrame6(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,var_sport,var_dport,0); // 0: UDP
+}
+
+// the same as above, but it creates a TCP segment with the given flags, if tcp_flags is nonzero
+struct rte_mbuf *mkVaripTestFrame6(uint16_t length, rte_mempool *pkt_pool, const char *side,
+                                   const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
+                                   const struct in6_addr *src_ip, const struct in6_addr *dst_ip,
+                                   unsigned var_sport, unsigned var_dport, uint8_t tcp_flags) {
+  struct rte_mbuf *pkt_mbuf=mkFinalTestFrame6(length,pkt_pool,side,dst_mac,src_mac,src_ip,dst_ip,0,0,tcp_flags);
   // The above function terminated the Tester if it could not allocate memory, thus no error handling is needed here. :-)
   uint8_t* pkt = rte_pktmbuf_mtod(pkt_mbuf, uint8_t *); // Access the Test Frame in the message buffer
   uint16_t *udp_sport = (uint16_t *) (pkt + 54);
   uint16_t *udp_dport = (uint16_t *) (pkt + 56);
-  uint16_t *udp_chksum = (uint16_t *) (pkt + 60);
+  uint16_t *udp_chksum = (uint16_t *) (pkt + (tcp_flags ? 70 : 60)); // 14+40+16: TCP checksum, 14+40+6: UDP checksum
   uint32_t chksum = *udp_chksum;
   if ( !var_sport )
     chksum += *udp_sport = htons(0xC020);       // set source port and add to checksum
@@ -1247,6 +2561,143 @@ void mkIpv6Header(struct rte_ipv6_hdr *ip, uint16_t length, const struct in6_add
   rte_mov16((uint8_t *)&ip->dst_addr,(uint8_t *)dst_ip);
 }
 
+// computes the fields of the Test Frames for each destination network from the Test Frames of network 0
+// the destination address field of network k is the configured one with its low byte cleared plus k (see destNetFields),
+// and the checksums are updated
+// incrementally: with fixed ports the final ones, with varying ports the uncomplemented ones are stored
+// the table is allocated from the memory of the NUMA node of the sender, it is to be released by rte_free()
+destNetFields *mkDestNets(struct rte_mbuf *fg_pkt_mbuf, struct rte_mbuf *bg_pkt_mbuf, int ip_version, uint32_t num_dest_nets,
+                          unsigned varport, uint8_t tcp_flags, const char *side) {
+  destNetFields *nets = (destNetFields *) rte_malloc("Sender's destination network table", sizeof(destNetFields)*num_dest_nets, 64);
+  if ( !nets )
+    rte_exit(EXIT_FAILURE, "Error: %s sender can't allocate memory for the destination network table!\n", side);
+  uint8_t *fg = rte_pktmbuf_mtod(fg_pkt_mbuf, uint8_t *);
+  uint8_t *bg = rte_pktmbuf_mtod(bg_pkt_mbuf, uint8_t *);
+  // the 16-bit field starts at offset 14+16+1=31 (IPv4) or 14+24+6=44 (IPv6), the checksums cover the 32-bit aligned words
+  // starting at offset 30 or 44, respectively
+  unsigned fg_words = ip_version == 4 ? 30 : 44, fg_field = ip_version == 4 ? 1 : 0;
+  uint16_t fg_chksum_offset = ip_version == 4 ? (tcp_flags ? 50 : 40) : (tcp_flags ? 70 : 60);
+  uint16_t bg_chksum_offset = tcp_flags ? 70 : 60;
+  uint16_t fg_base = fg[fg_words+fg_field] << 8; // the field of network 0 in host byte order: the low byte is cleared
+  uint16_t bg_base = bg[44] << 8;
+  uint16_t fg_chksum = *(uint16_t *)(fg+fg_chksum_offset), bg_chksum = *(uint16_t *)(bg+bg_chksum_offset);
+  uint16_t fg_ipv4_chksum = ~*(uint16_t *)(fg+24); // not used for IPv6
+  uint8_t fg_new[4], bg_new[4]; // the new values of the words covering the field
+
+  if ( !varport ) {
+    // the final checksums are converted to raw ones
+    fg_chksum = ~fg_chksum;
+    bg_chksum = ~bg_chksum;
+  }
+  memcpy(fg_new, fg+fg_words, 4);
+  memcpy(bg_new, bg+44, 4);
+  for ( uint32_t k=0; k<num_dest_nets; k++ ) {
+    uint16_t fg_field_value = fg_base+k, bg_field_value = bg_base+k; // overflow is intended
+    fg_new[fg_field] = fg_field_value >> 8;
+    fg_new[fg_field+1] = fg_field_value & 0xff;
+    bg_new[0] = bg_field_value >> 8;
+    bg_new[1] = bg_field_value & 0xff;
+    nets[k].fg_dst = *(uint16_t *)(fg_new+fg_field);
+    nets[k].bg_dst = *(uint16_t *)bg_new;
+    nets[k].fg_chksum = adjustChksum(fg_chksum, fg+fg_words, fg_new);
+    nets[k].bg_chksum = adjustChksum(bg_chksum, bg+44, bg_new);
+    if ( !varport ) {
+      nets[k].fg_chksum = ~nets[k].fg_chksum;
+      nets[k].bg_chksum = ~nets[k].bg_chksum;
+      if ( ip_version == 4 && !tcp_flags && nets[k].fg_chksum == 0 )
+        nets[k].fg_chksum = 0xffff;	// over IPv4, UDP checksum should not be 0 (0 means, no checksum is used)
+    }
+    nets[k].fg_ipv4_chksum = ~adjustChksum(fg_ipv4_chksum, fg+fg_words, fg_new);
+  }
+  return nets;
+}
+
+// called by a worker before its sending or receiving cycle: the counters of the previous worker of this lcore are reset
+void liveCounters::start(const char *side_, const char *role_, uint16_t port_) {
+  frames.store(0, std::memory_order_relaxed);
+  max_lateness.store(0, std::memory_order_relaxed);
+  state_entries.store(0, std::memory_order_relaxed);
+  port.store(port_, std::memory_order_relaxed);
+  role.store(role_, std::memory_order_relaxed);
+  side.store(side_, std::memory_order_release);
+}
+
+// callback of the "/siitperf/live" telemetry command: returns a dictionary with an entry for each lcore used by a worker
+// (e.g. "lcore_2"), containing its side and role; the imissed counter of the ports of the receivers is also included
+int telemetryLive(const char *cmd, const char *params, struct rte_tel_data *d) {
+  char name[32];		// name of the entry of a worker
+  struct rte_eth_stats stats;	// statistics of the port of a receiver
+  uint64_t hz = rte_get_timer_hz();
+
+  rte_tel_data_start_dict(d);
+  for ( unsigned i=0; i<RTE_MAX_LCORE; i++ ) {
+    liveCounters *lc = &live[i];
+    const char *side = lc->side.load(std::memory_order_acquire);
+    if ( !side )
+      continue;
+    const char *role = lc->role.load(std::memory_order_relaxed);
+    struct rte_tel_data *w = rte_tel_data_alloc();
+    if ( !w )
+      return -ENOMEM;
+    rte_tel_data_start_dict(w);
+    rte_tel_data_add_dict_string(w, "side", side);
+    rte_tel_data_add_dict_string(w, "role", role);
+    rte_tel_data_add_dict_int(w, "port", lc->port.load(std::memory_order_relaxed));
+    if ( !strcmp(role, "sender") ) {
+      rte_tel_data_add_dict_u64(w, "frames_sent", lc->frames.load(std::memory_order_relaxed));
+      rte_tel_data_add_dict_u64(w, "max_lateness_ns", (uint64_t)(1e9*lc->max_lateness.load(std::memory_order_relaxed)/hz));
+    } else {
+      rte_tel_data_add_dict_u64(w, "frames_received", lc->frames.load(std::memory_order_relaxed));
+      rte_tel_data_add_dict_u64(w, "state_entries", lc->state_entries.load(std::memory_order_relaxed));
+      if ( rte_eth_stats_get(lc->port.load(std::memory_order_relaxed), &stats) == 0 )
+        rte_tel_data_add_dict_u64(w, "imissed", stats.imissed);
+    }
+    snprintf(name, sizeof(name), "lcore_%u", i);
+    if ( rte_tel_data_add_dict_container(d, name, w, 0) < 0 )
+      rte_tel_data_free(w);
+  }
+  return 0;
+}
+
+// prints the lateness histogram of a sender in a single line (the non-empty bins as <k>:<frames>, where the frames of bin k
+// were late by less than 2^k TSC cycles), the maximum lateness and the cycle accounting of the sender (the cycles not spent
+// by busy waiting were spent preparing and sending the frames); the test is invalid, if the maximum exceeds 'bound'
+int latenessHistogram::report(const char *side, uint64_t hz, uint64_t bound) {
+  char line[LATENESS_BINS*24+1];	// the bins of the histogram
+  int len = 0;
+  uint64_t total_cycles = rte_rdtsc() - begin;
+
+  lc->frames.store(frames, std::memory_order_relaxed);
+  for ( int k=0; k<LATENESS_BINS; k++ )
+    if ( bins[k] )
+      len += snprintf(line+len, sizeof(line)-len, " %d:%lu", k, bins[k]);
+  line[len] = 0;
+  printf("Info: %s sender's lateness histogram (log2 of TSC cycles:frames):%s\n", side, line);
+  printf("Info: %s sender's maximum lateness: %.3lf us (%lu TSC cycles)\n", side, 1000000.0*max/hz, max);
+  if ( frames )
+    printf("Info: %s sender: %.1lf cycles/frame busy (preparing and sending), %.1lf cycles/frame idle (pacing), %.2lf%% busy\n",
+           side, (double)(total_cycles-idle)/frames, (double)idle/frames, 100.0*(total_cycles-idle)/total_cycles);
+  if ( bound && max > bound ) {
+    printf("Warning: %s sender was late by more than %.3lf us ('Max-lateness'), the test is invalid.\n", side, 1000000.0*bound/hz);
+    return 1;
+  }
+  return 0;
+}
+
+// prints the cycle accounting of a receiver, and warns if it is close to its limit
+void pollCounters::report(const char *side) {
+  uint64_t total_cycles = rx_cycles + work_cycles + idle_cycles;
+
+  if ( !polls || !total_cycles )
+    return;
+  printf("Info: %s receiver: %lu polls, %.2lf%% empty, %.2lf%% full bursts; cycles: %.2lf%% receiving, %.2lf%% processing, %.2lf%% idle\n",
+         side, polls, 100.0*empty_polls/polls, 100.0*full_bursts/polls,
+         100.0*rx_cycles/total_cycles, 100.0*work_cycles/total_cycles, 100.0*idle_cycles/total_cycles);
+  if ( full_bursts*100 > polls*FULL_BURSTS_WARNING )
+    printf("Warning: %s receiver got full bursts in %.2lf%% of its polls, it is close to its limit (frames may be dropped).\n",
+           side, 100.0*full_bursts/polls);
+}
+
 // sends Test Frames for throughput (or frame loss rate) measurement
 int send(void *par) {
   // collecting input parameters:
@@ -1262,6 +2713,8 @@ int send(void *par) {
   uint32_t m = cp->m;
   uint64_t hz = cp->hz;
   uint64_t start_tsc = cp->start_tsc;
+  uint8_t tcp_flags = cp->tcp_flags;
+  unsigned responder_echo = cp->responder_echo;
 
   // parameters which are different for the Left sender and the Right sender
   int ip_version = p->ip_version;
@@ -1270,7 +2723,7 @@ int send(void *par) {
   const char *side = p->side;
   struct ether_addr *dst_mac = p->dst_mac;
   struct ether_addr *src_mac = p->src_mac;
-  uint16_t num_dest_nets = p->num_dest_nets;
+  uint32_t num_dest_nets = p->num_dest_nets;
   uint32_t *src_ipv4 = p->src_ipv4;
   uint32_t *dst_ipv4 = p->dst_ipv4;
   struct in6_addr *src_ipv6 = p->src_ipv6;
@@ -1288,10 +2741,21 @@ int send(void *par) {
   // further local variables
   uint64_t frames_to_send = duration * frame_rate;	// Each active sender sends this number of frames
   uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
+  uint64_t *net_sent = 0; // counts the number of frames sent to each destination network (multiple destination networks only)
   double elapsed_seconds; // for checking the elapsed seconds during sending
+  uint16_t echo_data_offset = ip_version == 4 ? 42 : 62; // UDP data of foreground frames: time stamp is written here (Responder-echo 1)
 
   bool fg_frame, ipv4_frame; // when sending IPv4 traffic, background frames are IPv6: their UDP checksum may be 0.
 
+  if ( num_dest_nets > 1 ) {
+    // the counters are allocated from the memory of the NUMA node of the sender
+    net_sent = (uint64_t *) rte_zmalloc("Sender's per network counters", sizeof(uint64_t)*num_dest_nets, 64);
+    if ( !net_sent )
+      rte_exit(EXIT_FAILURE, "Error: %s sender can't allocate memory for the per network counters!\n", side);
+  }
+
   if ( !varport ) {
     // optimized code for using hard coded fix port numbers as defined in RFC 2544 https://tools.ietf.org/html/rfc2544#appendix-C.2.6.4
     if ( num_dest_nets == 1 ) { 	
@@ -1299,16 +2763,16 @@ int send(void *par) {
       struct rte_mbuf *fg_pkt_mbuf, *bg_pkt_mbuf; // message buffers for fg. and bg. Test Frames
       // create foreground Test Frame
       if ( ip_version == 4 )
-        fg_pkt_mbuf = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0);
+        fg_pkt_mbuf = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0, tcp_flags);
       else  // IPv6
-        fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0);
+        fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0, tcp_flags);
   
       // create backround Test Frame (always IPv6)
-      bg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0);
+      bg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0, tcp_flags);
   
       // naive sender version: it is simple and fast
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further two will come!
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
         if ( sent_frames % n  < m )
           while ( !rte_eth_tx_burst(eth_id, 0, &fg_pkt_mbuf, 1) ); // send foreground frame
         else
@@ -1316,50 +2780,71 @@ int send(void *par) {
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
     else {
-      // optimized code for multiple destination networks: foreground and background frames are generated for each network and pointers are stored in arrays
-      // assertion: num_dest_nets <= 256 
-      struct rte_mbuf *fg_pkt_mbuf[256], *bg_pkt_mbuf[256]; // message buffers for fg. and bg. Test Frames
-      uint32_t curr_dst_ipv4; 	// IPv4 destination address, which will be changed
-      in6_addr curr_dst_ipv6; 	// foreground IPv6 destination address, which will be changed
-      in6_addr curr_dst_bg; 	// backround IPv6 destination address, which will be changed
-      int i; 			// cycle variable for grenerating different destination network addresses
-      if ( ip_version == 4 )
-        curr_dst_ipv4 = *dst_ipv4;
-      else // IPv6
-        curr_dst_ipv6 = *dst_ipv6;
-      curr_dst_bg = *dst_bg;
-  
-      for ( i=0; i<num_dest_nets; i++ ) { 
+      // optimized code for multiple destination networks: the same foreground and background frames are used for each network,
+      // their destination address field carrying the network and their checksums are set from a compact table before sending
+      // the frames exist in several copies to resolve the write after send problem
+      int j; // cycle variable to index the copies: takes {0..fr.copies-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
+      struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
+      uint8_t *pkt; // working pointer to the current frame (in the message buffer)
+      uint8_t *fg_dst[N], *fg_chksum[N], *fg_ipv4_chksum[N], *bg_dst[N], *bg_chksum[N]; // pointers to the given fields
+      destNetFields *nets, *net; // fields of the frames for each destination network, and working pointer to the current one
+
+      for ( j=0; j<fr.copies; j++ ) {
         // create foreground Test Frame
         if ( ip_version == 4 ) {
-          ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) i; // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-          fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, 0, 0);
+          fg_pkt_mbuf[j] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0, tcp_flags));
+          pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
+          fg_dst[j] = pkt + 31;
+          fg_chksum[j] = pkt + (tcp_flags ? 50 : 40);
+          fg_ipv4_chksum[j] = pkt + 24;
+        } else { // IPv6
+          fg_pkt_mbuf[j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0, tcp_flags));
+          pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
+          fg_dst[j] = pkt + 44;
+          fg_chksum[j] = pkt + (tcp_flags ? 70 : 60);
+          fg_ipv4_chksum[j] = 0; // IPv6 has no header checksum
         }
-        else { // IPv6
-          ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-          fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, 0, 0);
-        } 
         // create backround Test Frame (always IPv6)
-        ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, 0, 0);
+        bg_pkt_mbuf[j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0, tcp_flags));
+        pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
+        bg_dst[j] = pkt + 44;
+        bg_chksum[j] = pkt + (tcp_flags ? 70 : 60);
       }
+      nets = mkDestNets(fg_pkt_mbuf[0], bg_pkt_mbuf[0], ip_version, num_dest_nets, 0, tcp_flags, side);
    
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis(0, num_dest_nets-1);	// uniform distribution in [0, num_dest_nets-1]
+      thread_local fastRandom gen(rd());
+      randomRange uni_dis(0, num_dest_nets-1);	// uniform distribution in [0, num_dest_nets-1]
   
       // naive sender version: it is simple and fast
+      j=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        int index = uni_dis(gen);	// index of the pre-generated frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further two will come!
-        if ( sent_frames % n  < m )
-          while ( !rte_eth_tx_burst(eth_id, 0, &fg_pkt_mbuf[index], 1) ); // send foreground frame
-        else
-           while ( !rte_eth_tx_burst(eth_id, 0, &bg_pkt_mbuf[index], 1) ); // send background frame
+        int index = uni_dis(gen);	// index of the destination network
+        net_sent[index]++;
+        net = nets + index;
+        if ( sent_frames % n  < m ) {
+          // foreground frame is to be sent
+          pkt_mbuf = fg_pkt_mbuf[j];
+          fr.wait(pkt_mbuf); // its previous transmission must be completed
+          *(uint16_t *)fg_dst[j] = net->fg_dst;
+          *(uint16_t *)fg_chksum[j] = net->fg_chksum;
+          if ( ip_version == 4 )
+            *(uint16_t *)fg_ipv4_chksum[j] = net->fg_ipv4_chksum;
+        } else {
+          // background frame is to be sent
+          pkt_mbuf = bg_pkt_mbuf[j];
+          fr.wait(pkt_mbuf); // its previous transmission must be completed
+          *(uint16_t *)bg_dst[j] = net->bg_dst;
+          *(uint16_t *)bg_chksum[j] = net->bg_chksum;
+        }
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        j = (j+1) % fr.copies;
       } // this is the end of the sending cycle
+      rte_free(nets);
     } // end of optimized code for multiple destination networks
   } // end of optimized code for fixed port numbers
   else {
@@ -1370,6 +2855,7 @@ int send(void *par) {
       // source and/or destination port number(s) and UDP checksum are updated
       // N size arrays are used to resolve the write after send problem
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N]; // pointers to the given fields
@@ -1379,28 +2865,28 @@ int send(void *par) {
       uint16_t sport, dport; // values of source and destination port numbers -- to be preserved, when increase or decrease is done 
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
       
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground Test Frame
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, tcp_flags));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[i] = pkt + 34;
           fg_udp_dport[i] = pkt + 36;
-          fg_udp_chksum[i] = pkt + 40;
+          fg_udp_chksum[i] = pkt + (tcp_flags ? 50 : 40);
         } else { // IPv6
-          fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[i] = pkt + 54;
           fg_udp_dport[i] = pkt + 56;
-          fg_udp_chksum[i] = pkt + 60;
+          fg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);
         }
         fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
         // create backround Test Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+        bg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
         bg_udp_sport[i] = pkt + 54;
         bg_udp_dport[i] = pkt  + 56;
-        bg_udp_chksum[i] = pkt + 60;
+        bg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);
         bg_udp_chksum_start = *(uint16_t *)bg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
       } 
 
@@ -1416,16 +2902,17 @@ int send(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);	// uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);	// uniform distribution in [sport_min, sport_max]
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      popularityDistribution uni_dis_sport(sport_min, sport_max, var_sport == 3 ? cp->popularity : 0);	// uniform or skewed distribution in [sport_min, sport_max]
+      popularityDistribution uni_dis_dport(dport_min, dport_max, var_dport == 3 ? cp->popularity : 0);	// uniform or skewed distribution in [sport_min, sport_max]
 
       // naive sender version: it is simple and fast
       i=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n < m ) {
+          fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start;
           udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -1433,6 +2920,7 @@ int send(void *par) {
           udp_chksum = (uint16_t *)fg_udp_chksum[i];
           pkt_mbuf = fg_pkt_mbuf[i];
         } else {
+          fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
           // background frame is to be sent
           chksum = bg_udp_chksum_start;
           udp_sport = (uint16_t *)bg_udp_sport[i];
@@ -1482,67 +2970,59 @@ int send(void *par) {
           chksum = 0xffff;
         *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); 	// Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) ); 		// send out the frame
-        i = (i+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        if ( unlikely( responder_echo && fg_frame ) )
+          stampEcho(rte_pktmbuf_mtod(pkt_mbuf, uint8_t *) + echo_data_offset, rte_rdtsc()); // time stamp for round-trip time measurement
+        fr.send(pkt_mbuf); 		// send out the frame
+        i = (i+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
     else { 
-      // optimized code for multiple destination networks: N copies of foreground or background frames are prepared for each destination network,
+      // optimized code for multiple destination networks: the same foreground and background frames are used for each network,
       // N size arrays are used to resolve the write after send problem
-      // source and/or destination port number(s) and UDP checksum are updated in the actually used copy before sending
-      // assertion: num_dest_nets <= 256
+      // the destination address field carrying the network is set, and the starting value of the UDP checksum is taken from
+      // a compact table, then source and/or destination port number(s) and UDP checksum are updated in the actually used copy before sending
       int j; // cycle variable to index the N size array: takes {0..N-1} values
-      struct rte_mbuf *fg_pkt_mbuf[256][N], *bg_pkt_mbuf[256][N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
+      struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
-      uint8_t *fg_udp_sport[256][N], *fg_udp_dport[256][N], *fg_udp_chksum[256][N]; // pointers to the given fields of the pre-prepared Test Frames
-      uint8_t *bg_udp_sport[256][N], *bg_udp_dport[256][N], *bg_udp_chksum[256][N]; // pointers to the given fields of the pre-prepared Test Frames
+      uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *fg_dst[N], *fg_ipv4_chksum[N]; // pointers to the given fields of the Test Frames
+      uint8_t *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N], *bg_dst[N]; // pointers to the given fields of the Test Frames
       uint16_t *udp_sport, *udp_dport, *udp_chksum; // working pointers to the given fields
-      uint16_t fg_udp_chksum_start[256], bg_udp_chksum_start[256];  // starting values (uncomplemented checksums taken from the original frames)
+      destNetFields *nets, *net; // fields of the frames for each destination network (including the starting values of the checksums), and working pointer
       uint32_t chksum; // temporary variable for checksum calculation
       uint16_t sport, dport; // values of source and destination port numbers -- to be preserved, when increase or decrease is done
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
-      uint32_t curr_dst_ipv4;     // IPv4 destination address, which will be changed
-      in6_addr curr_dst_ipv6;     // foreground IPv6 destination address, which will be changed
-      in6_addr curr_dst_bg;       // backround IPv6 destination address, which will be changed
-      int i;                      // cycle variable for grenerating different destination network addresses
- 
-      if ( ip_version == 4 )
-        curr_dst_ipv4 = *dst_ipv4;
-      else // IPv6
-        curr_dst_ipv6 = *dst_ipv6;
-      curr_dst_bg = *dst_bg;
 
       // create Test Frames
-      for ( j=0; j<N; j++ ) {
-        for ( i=0; i<num_dest_nets; i++ ) {
-          // create foreground Test Frame (IPv4 or IPv6)
-          if ( ip_version == 4 ) {
-            ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) i; // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-            fg_pkt_mbuf[i][j] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport);
-            pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
-            fg_udp_sport[i][j] = pkt + 34;
-            fg_udp_dport[i][j] = pkt + 36;
-            fg_udp_chksum[i][j] = pkt + 40;
-          } else { // IPv6
-            ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-            fg_pkt_mbuf[i][j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport);
-            pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
-            fg_udp_sport[i][j] = pkt + 54;
-            fg_udp_dport[i][j] = pkt + 56;
-            fg_udp_chksum[i][j] = pkt + 60;
-          }
-          fg_udp_chksum_start[i] = *(uint16_t *)fg_udp_chksum[i][j]; // save the uncomplemented checksum value (same for all values of "j")
-          // create backround Test Frame (always IPv6)
-          ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport);
-          pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
-          bg_udp_sport[i][j] = pkt + 54;
-          bg_udp_dport[i][j] = pkt  + 56;
-          bg_udp_chksum[i][j] = pkt + 60;
-          bg_udp_chksum_start[i] = *(uint16_t *)bg_udp_chksum[i][j]; // save the uncomplemented checksum value (same for all values of "j")
+      for ( j=0; j<fr.copies; j++ ) {
+        // create foreground Test Frame (IPv4 or IPv6)
+        if ( ip_version == 4 ) {
+          fg_pkt_mbuf[j] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, tcp_flags));
+          pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
+          fg_udp_sport[j] = pkt + 34;
+          fg_udp_dport[j] = pkt + 36;
+          fg_udp_chksum[j] = pkt + (tcp_flags ? 50 : 40);
+          fg_dst[j] = pkt + 31;
+          fg_ipv4_chksum[j] = pkt + 24;
+        } else { // IPv6
+          fg_pkt_mbuf[j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
+          pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
+          fg_udp_sport[j] = pkt + 54;
+          fg_udp_dport[j] = pkt + 56;
+          fg_udp_chksum[j] = pkt + (tcp_flags ? 70 : 60);
+          fg_dst[j] = pkt + 44;
+          fg_ipv4_chksum[j] = 0; // IPv6 has no header checksum
         }
+        // create backround Test Frame (always IPv6)
+        bg_pkt_mbuf[j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
+        pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
+        bg_udp_sport[j] = pkt + 54;
+        bg_udp_dport[j] = pkt  + 56;
+        bg_udp_chksum[j] = pkt + (tcp_flags ? 70 : 60);
+        bg_dst[j] = pkt + 44;
       }
+      nets = mkDestNets(fg_pkt_mbuf[0], bg_pkt_mbuf[0], ip_version, num_dest_nets, 1, tcp_flags, side);
 
       // set the starting values of port numbers, if they are increased or decreased
       if ( var_sport == 1 )
@@ -1556,32 +3036,40 @@ int send(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_net(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
+      thread_local fastRandom gen_net(rd());
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      popularityDistribution uni_dis_sport(sport_min, sport_max, var_sport == 3 ? cp->popularity : 0);   // uniform or skewed distribution in [sport_min, sport_max]
+      popularityDistribution uni_dis_dport(dport_min, dport_max, var_dport == 3 ? cp->popularity : 0);   // uniform or skewed distribution in [sport_min, sport_max]
 
       // naive sender version: it is simple and fast
       j=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        int index = uni_dis_net(gen_net); // index of the pre-generated Test Frame for the given destination network
-        // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
+        int index = uni_dis_net(gen_net); // index of the destination network
+        net_sent[index]++;
+        net = nets + index;
+        // set the temporary variables (including several pointers) to handle the right Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[j]); // its previous transmission must be completed
           // foreground frame is to be sent
-          chksum = fg_udp_chksum_start[index];
-          udp_sport = (uint16_t *)fg_udp_sport[index][j];
-          udp_dport = (uint16_t *)fg_udp_dport[index][j];
-          udp_chksum = (uint16_t *)fg_udp_chksum[index][j];
-          pkt_mbuf = fg_pkt_mbuf[index][j];
+          *(uint16_t *)fg_dst[j] = net->fg_dst;
+          if ( ip_version == 4 )
+            *(uint16_t *)fg_ipv4_chksum[j] = net->fg_ipv4_chksum;
+          chksum = net->fg_chksum;
+          udp_sport = (uint16_t *)fg_udp_sport[j];
+          udp_dport = (uint16_t *)fg_udp_dport[j];
+          udp_chksum = (uint16_t *)fg_udp_chksum[j];
+          pkt_mbuf = fg_pkt_mbuf[j];
         } else {
+          fr.wait(bg_pkt_mbuf[j]); // its previous transmission must be completed
           // background frame is to be sent
-          chksum = bg_udp_chksum_start[index];
-          udp_sport = (uint16_t *)bg_udp_sport[index][j];
-          udp_dport = (uint16_t *)bg_udp_dport[index][j];
-          udp_chksum = (uint16_t *)bg_udp_chksum[index][j];
-          pkt_mbuf = bg_pkt_mbuf[index][j];
+          *(uint16_t *)bg_dst[j] = net->bg_dst;
+          chksum = net->bg_chksum;
+          udp_sport = (uint16_t *)bg_udp_sport[j];
+          udp_dport = (uint16_t *)bg_udp_dport[j];
+          udp_chksum = (uint16_t *)bg_udp_chksum[j];
+          pkt_mbuf = bg_pkt_mbuf[j];
         }
         ipv4_frame = ip_version == 4 && fg_frame; // precalculated to have it ready when needed
 
@@ -1625,21 +3113,26 @@ int send(void *par) {
           chksum = 0xffff;
         *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        j = (j+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        if ( unlikely( responder_echo && fg_frame ) )
+          stampEcho(rte_pktmbuf_mtod(pkt_mbuf, uint8_t *) + echo_data_offset, rte_rdtsc()); // time stamp for round-trip time measurement
+        fr.send(pkt_mbuf);           // send out the frame
+        j = (j+1) % fr.copies;
       } // this is the end of the sending cycle
+      rte_free(nets);
     } // end of the optimized code for multiple destination networks
   } // end of implementation of varying port numbers 
   // Now, we check the time
   elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
   if ( elapsed_seconds > duration*TOLERANCE )
     printf("Warning: %s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
-  else
+  else if ( !late )
     printf("%s frames sent: %lu\n", side, sent_frames);
+  p->net_sent = net_sent; // per network counters are reported and released by measure() together with the received ones
 
-  return 0;
+  return elapsed_seconds > duration*TOLERANCE || late; // non-zero, if the sending was too slow (used by the self-calibration)
 }
 
 
@@ -1658,6 +3151,8 @@ int msend(void *par) {
   uint32_t m = cp->m;
   uint64_t hz = cp->hz;
   uint64_t start_tsc = cp->start_tsc;
+  uint8_t tcp_flags = cp->tcp_flags;
+  unsigned responder_echo = cp->responder_echo;
 
 
   // parameters which are different for the Left sender and the Right sender
@@ -1677,10 +3172,12 @@ int msend(void *par) {
   unsigned var_sip = p->var_sip;
   unsigned var_dip = p->var_dip;
   unsigned var_ip = var_sip || var_dip; // derived logical value: at least one IP address has to be changed?
-  uint16_t sip_min = p->sip_min;
-  uint16_t sip_max = p->sip_max;
-  uint16_t dip_min = p->dip_min;
-  uint16_t dip_max = p->dip_max;
+  uint64_t sip_min = p->sip_min;
+  uint64_t sip_max = p->sip_max;
+  uint64_t dip_min = p->dip_min;
+  uint64_t dip_max = p->dip_max;
+  unsigned sip_bytes = p->sip_bits/8;	// width of the varying field of the source IP address
+  unsigned dip_bytes = p->dip_bits/8;	// width of the varying field of the destination IP address
   uint16_t src_ipv4_offset = p->src_ipv4_offset;
   uint16_t dst_ipv4_offset = p->dst_ipv4_offset;
   uint16_t src_ipv6_offset = p->src_ipv6_offset;
@@ -1697,7 +3194,10 @@ int msend(void *par) {
   // further local variables
   uint64_t frames_to_send = duration * frame_rate;	// Each active sender sends this number of frames
   uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
   double elapsed_seconds; // for checking the elapsed seconds during sending
+  uint16_t echo_data_offset = ip_version == 4 ? 42 : 62; // UDP data of foreground frames: time stamp is written here (Responder-echo 1)
 
   bool fg_frame, ipv4_frame; // when sending IPv4 traffic, bacground frames are IPv6: they have no IPv4 checksum
 
@@ -1711,45 +3211,47 @@ int msend(void *par) {
     // This code has been written by simplifying the "varport" version.
 
     int i; // cycle variable to index the N size array: takes {0..N-1} values
+    frameReuse fr(eth_id, side); // the copies of the frames are reused safely
     struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
     uint8_t *pkt; // working pointer to the current frame (in the message buffer)
-    uint8_t *fg_src_ip[N], *fg_dst_ip[N], *fg_ipv4_chksum[N], *bg_src_ip[N], *bg_dst_ip[N]; // pointers to the given 16-bit fields to be modified
+    uint8_t *fg_src_ip[N], *fg_dst_ip[N], *fg_ipv4_chksum[N], *bg_src_ip[N], *bg_dst_ip[N]; // pointers to the given fields to be modified
     uint8_t *fg_udp_chksum[N], *bg_udp_chksum[N]; // pointers to the given fields
-    uint16_t *ip_src, *ip_dst, *ipv4_chksum; // working pointers to the given 16-bit fields to be modified
+    uint8_t *ip_src, *ip_dst; // working pointers to the varying fields of the IP addresses
+    uint16_t *ipv4_chksum; // working pointer to the IPv4 header checksum
     uint16_t *udp_chksum; // working pointers to the given fields to be modified
     uint16_t fg_ipv4_chksum_start;  // starting values (uncomplemented checksums taken from the original frames)
     uint16_t fg_udp_chksum_start, bg_udp_chksum_start;  // starting values (uncomplemented checksums taken from the original frames)
     uint32_t v4_chksum; // temporary variable: stores the starting value from the packet
-    uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the 16-bit IP address fields
+    uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the varying IP address fields
     uint32_t chksum; // temporary variable for UDP checksum calculation (store both)
-    uint16_t src_ip, dst_ip; // values of source and destination IP addresses -- to be preserved, when increase or decrease is done 
-    uint16_t sip, dip; // values of source and destination IP addresses -- temporary values
+    uint64_t src_ip, dst_ip; // values of source and destination IP addresses -- to be preserved, when increase or decrease is done 
+    uint64_t sip, dip; // values of source and destination IP addresses -- temporary values
     
-    for ( i=0; i<N; i++ ) {
+    for ( i=0; i<fr.copies; i++ ) {
       // create foreground Test Frame
       if ( ip_version == 4 ) {
-        fg_pkt_mbuf[i] = mkVaripTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport);
+        fg_pkt_mbuf[i] = fr.add(mkVaripTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-        fg_src_ip[i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the 16-bits to be modified
-        fg_dst_ip[i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the 16-bits to be modified
+        fg_src_ip[i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the varying field to be modified
+        fg_dst_ip[i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the varying field to be modified
         fg_ipv4_chksum[i] = pkt + 24;               // 14+10: IPv4 header checksum
-        fg_udp_chksum[i] = pkt + 40;   // 14+20+6: UDP checksum 
+        fg_udp_chksum[i] = pkt + (tcp_flags ? 50 : 40);   // 14+20+16: TCP checksum, 14+20+6: UDP checksum
       } else { // IPv6
-        fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+        fg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-        fg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
-        fg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
-        fg_udp_chksum[i] = pkt + 60;   // 14+40+6: UDP checksum
+        fg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the varying field to be modified
+        fg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the varying field to be modified
+        fg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);   // 14+40+16: TCP checksum, 14+40+6: UDP checksum
       }
       if ( ip_version == 4 )
         fg_ipv4_chksum_start = ~*(uint16_t *)fg_ipv4_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
       fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
       // create backround Test Frame (always IPv6)
-      bg_pkt_mbuf[i] = mkVaripTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+      bg_pkt_mbuf[i] = fr.add(mkVaripTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
       pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-      bg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
-      bg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
-      bg_udp_chksum[i] = pkt + 60;   // 14+40+6: UDP checksum
+      bg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the varying field to be modified
+      bg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the varying field to be modified
+      bg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);   // 14+40+16: TCP checksum, 14+40+6: UDP checksum
       bg_udp_chksum_start = *(uint16_t *)bg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
     } 
 
@@ -1765,28 +3267,32 @@ int msend(void *par) {
 
     // prepare random number infrastructure
     thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-    thread_local std::mt19937_64 gen_sip(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    thread_local std::mt19937_64 gen_dip(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<int> uni_dis_sip(sip_min, sip_max);     // uniform distribution in [sip_min, sip_max]
-    std::uniform_int_distribution<int> uni_dis_dip(dip_min, dip_max);     // uniform distribution in [dip_min, dip_max]
+    thread_local fastRandom gen_sip(rd());
+    thread_local fastRandom gen_dip(rd());
+    popularityDistribution uni_dis_sip(sip_min, sip_max, var_sip == 3 ? cp->popularity : 0);     // uniform or skewed distribution in [sip_min, sip_max]
+    popularityDistribution uni_dis_dip(dip_min, dip_max, var_dip == 3 ? cp->popularity : 0);     // uniform or skewed distribution in [dip_min, dip_max]
+    randomRange64 uni_dis_sip64(sip_min, sip_max);	// uniform distribution for 64-bit fields in [sip_min, sip_max]
+    randomRange64 uni_dis_dip64(dip_min, dip_max);	// uniform distribution for 64-bit fields in [dip_min, dip_max]
 
     // naive sender version: it is simple and fast
     i=0; // increase maunally after each sending
     for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
       // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
       if ( fg_frame = sent_frames % n < m ) {
+        fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
         // foreground frame is to be sent
         v4_chksum = fg_ipv4_chksum_start; // rubbish, if IPv6, but a branch instruction is spared
-        ip_src = (uint16_t *)fg_src_ip[i];
-        ip_dst = (uint16_t *)fg_dst_ip[i];
+        ip_src = fg_src_ip[i];
+        ip_dst = fg_dst_ip[i];
         ipv4_chksum = (uint16_t *)fg_ipv4_chksum[i]; // rubbish, if IPv6, but a branch instruction is spared
         chksum = fg_udp_chksum_start;
         udp_chksum = (uint16_t *)fg_udp_chksum[i];
         pkt_mbuf = fg_pkt_mbuf[i];
       } else {
+        fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
         // background frame is to be sent, it is surely IPv6
-        ip_src = (uint16_t *)bg_src_ip[i];
-        ip_dst = (uint16_t *)bg_dst_ip[i];
+        ip_src = bg_src_ip[i];
+        ip_dst = bg_dst_ip[i];
         chksum = bg_udp_chksum_start;
         udp_chksum = (uint16_t *)bg_udp_chksum[i];
         pkt_mbuf = bg_pkt_mbuf[i];
@@ -1807,9 +3313,9 @@ int msend(void *par) {
               src_ip = sip_max;
             break;
           case 3:                   // pseudorandom 
-            sip = uni_dis_sip(gen_sip);
+            sip = sip_bytes < 8 ? uni_dis_sip(gen_sip) : uni_dis_sip64(gen_sip);
         }
-        ip_chksum += *ip_src = htons(sip);     // set src IP 16-bit field and add to checksum
+        ip_chksum += setIpField(ip_src, sip, sip_bytes);     // set src IP field and add to checksum
       }
       if ( var_dip ) {
         // destination IP is varying
@@ -1823,9 +3329,9 @@ int msend(void *par) {
               dst_ip = dip_max;
             break;
           case 3:                           // pseudorandom
-            dip = uni_dis_dip(gen_dip);
+            dip = dip_bytes < 8 ? uni_dis_dip(gen_dip) : uni_dis_dip64(gen_dip);
         }
-        ip_chksum += *ip_dst = htons(dip);     // set dst IP 16-bit field and add to checksum
+        ip_chksum += setIpField(ip_dst, dip, dip_bytes);     // set dst IP field and add to checksum
       }
       if ( ipv4_frame ) {
         // only the IPv4 header contains IP checksum
@@ -1843,9 +3349,11 @@ int msend(void *par) {
         chksum = 0xffff;
       *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
       // finally, when its time is here, send the frame
-      while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); 	// Beware: an "empty" loop, as well as in the next line
-      while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) ); 		// send out the frame
-      i = (i+1) % N;
+      lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+      if ( unlikely( responder_echo && fg_frame ) )
+        stampEcho(rte_pktmbuf_mtod(pkt_mbuf, uint8_t *) + echo_data_offset, rte_rdtsc()); // time stamp for round-trip time measurement
+      fr.send(pkt_mbuf); 		// send out the frame
+      i = (i+1) % fr.copies;
     } // this is the end of the sending cycle
   } // end of optimized code for fixed port numbers
   else {
@@ -1857,53 +3365,55 @@ int msend(void *par) {
     // varying 16-bit fields of the source and/or destination IP addresses and for IPv4, header checksum,
     // source and/or destination port number(s) and UDP checksum are updated.
     int i; // cycle variable to index the N size array: takes {0..N-1} values
+    frameReuse fr(eth_id, side); // the copies of the frames are reused safely
     struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
     uint8_t *pkt; // working pointer to the current frame (in the message buffer)
-    uint8_t *fg_src_ip[N], *fg_dst_ip[N], *fg_ipv4_chksum[N], *bg_src_ip[N], *bg_dst_ip[N]; // pointers to the given 16-bit fields to be modified
+    uint8_t *fg_src_ip[N], *fg_dst_ip[N], *fg_ipv4_chksum[N], *bg_src_ip[N], *bg_dst_ip[N]; // pointers to the given fields to be modified
     uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N]; // pointers to the given fields
-    uint16_t *ip_src, *ip_dst, *ipv4_chksum; // working pointers to the given 16-bit fields to be modified
+    uint8_t *ip_src, *ip_dst; // working pointers to the varying fields of the IP addresses
+    uint16_t *ipv4_chksum; // working pointer to the IPv4 header checksum
     uint16_t *udp_sport, *udp_dport, *udp_chksum; // working pointers to the given fields to be modified
     uint16_t fg_ipv4_chksum_start;  // starting values (uncomplemented checksums taken from the original frames)
     uint16_t fg_udp_chksum_start, bg_udp_chksum_start;  // starting values (uncomplemented checksums taken from the original frames)
     uint32_t v4_chksum; // temporary variable: stores the starting value from the packet
-    uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the 16-bit IP address fields
+    uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the varying IP address fields
     uint32_t chksum; // temporary variable for UDP checksum calculation (store both)
-    uint16_t src_ip, dst_ip; // values of source and destination IP addresses -- to be preserved, when increase or decrease is done 
+    uint64_t src_ip, dst_ip; // values of source and destination IP addresses -- to be preserved, when increase or decrease is done 
     uint16_t sport, dport; // values of source and destination port numbers -- to be preserved, when increase or decrease is done 
-    uint16_t sip, dip; // values of source and destination IP addresses -- temporary values
+    uint64_t sip, dip; // values of source and destination IP addresses -- temporary values
     uint16_t sp, dp; // values of source and destination port numbers -- temporary values
     
-    for ( i=0; i<N; i++ ) {
+    for ( i=0; i<fr.copies; i++ ) {
       // create foreground Test Frame
       if ( ip_version == 4 ) {
-        fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport);
+        fg_pkt_mbuf[i] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-        fg_src_ip[i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the 16-bits to be modified
-        fg_dst_ip[i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the 16-bits to be modified
+        fg_src_ip[i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the varying field to be modified
+        fg_dst_ip[i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the varying field to be modified
         fg_ipv4_chksum[i] = pkt + 24;               // 14+10: IPv4 header checksum
         fg_udp_sport[i] = pkt + 34;    // 14+20+0: source UDP port 
         fg_udp_dport[i] = pkt + 36;    // 14+20+2: destination UDP port
-        fg_udp_chksum[i] = pkt + 40;   // 14+20+6: UDP checksum 
+        fg_udp_chksum[i] = pkt + (tcp_flags ? 50 : 40);   // 14+20+16: TCP checksum, 14+20+6: UDP checksum
       } else { // IPv6
-        fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+        fg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-        fg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
-        fg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
+        fg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the varying field to be modified
+        fg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the varying field to be modified
         fg_udp_sport[i] = pkt + 54;    // 14+40+0: source UDP port
         fg_udp_dport[i] = pkt + 56;    // 14+40+2: destination UDP port
-        fg_udp_chksum[i] = pkt + 60;   // 14+40+6: UDP checksum
+        fg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);   // 14+40+16: TCP checksum, 14+40+6: UDP checksum
       }
       if ( ip_version == 4 )
         fg_ipv4_chksum_start = ~*(uint16_t *)fg_ipv4_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
       fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
       // create backround Test Frame (always IPv6)
-      bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+      bg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
       pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-      bg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
-      bg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
+      bg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the varying field to be modified
+      bg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the varying field to be modified
       bg_udp_sport[i] = pkt + 54;    // 14+40+0: source UDP port
       bg_udp_dport[i] = pkt + 56;    // 14+40+2: destination UDP port
-      bg_udp_chksum[i] = pkt + 60;   // 14+40+6: UDP checksum
+      bg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);   // 14+40+16: TCP checksum, 14+40+6: UDP checksum
       bg_udp_chksum_start = *(uint16_t *)bg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
     } 
 
@@ -1929,24 +3439,27 @@ int msend(void *par) {
 
     // prepare random number infrastructure
     thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-    thread_local std::mt19937_64 gen_sip(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    thread_local std::mt19937_64 gen_dip(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<int> uni_dis_sip(sip_min, sip_max);     // uniform distribution in [sip_min, sip_max]
-    std::uniform_int_distribution<int> uni_dis_dip(dip_min, dip_max);     // uniform distribution in [dip_min, dip_max]
-    thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);	// uniform distribution in [sport_min, sport_max]
-    std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);	// uniform distribution in [sport_min, sport_max]
+    thread_local fastRandom gen_sip(rd());
+    thread_local fastRandom gen_dip(rd());
+    popularityDistribution uni_dis_sip(sip_min, sip_max, var_sip == 3 ? cp->popularity : 0);     // uniform or skewed distribution in [sip_min, sip_max]
+    popularityDistribution uni_dis_dip(dip_min, dip_max, var_dip == 3 ? cp->popularity : 0);     // uniform or skewed distribution in [dip_min, dip_max]
+    randomRange64 uni_dis_sip64(sip_min, sip_max);	// uniform distribution for 64-bit fields in [sip_min, sip_max]
+    randomRange64 uni_dis_dip64(dip_min, dip_max);	// uniform distribution for 64-bit fields in [dip_min, dip_max]
+    thread_local fastRandom gen_sport(rd());
+    thread_local fastRandom gen_dport(rd());
+    popularityDistribution uni_dis_sport(sport_min, sport_max, var_sport == 3 ? cp->popularity : 0);	// uniform or skewed distribution in [sport_min, sport_max]
+    popularityDistribution uni_dis_dport(dport_min, dport_max, var_dport == 3 ? cp->popularity : 0);	// uniform or skewed distribution in [sport_min, sport_max]
 
     // naive sender version: it is simple and fast
     i=0; // increase maunally after each sending
     for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
       // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
       if ( fg_frame = sent_frames % n < m ) {
+        fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
         // foreground frame is to be sent
         v4_chksum = fg_ipv4_chksum_start; // rubbish, if IPv6, but a branch instruction is spared
-        ip_src = (uint16_t *)fg_src_ip[i];
-        ip_dst = (uint16_t *)fg_dst_ip[i];
+        ip_src = fg_src_ip[i];
+        ip_dst = fg_dst_ip[i];
         ipv4_chksum = (uint16_t *)fg_ipv4_chksum[i]; // rubbish, if IPv6, but a branch instruction is spared
         chksum = fg_udp_chksum_start;
         udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -1954,9 +3467,10 @@ int msend(void *par) {
         udp_chksum = (uint16_t *)fg_udp_chksum[i];
         pkt_mbuf = fg_pkt_mbuf[i];
       } else {
+        fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
         // background frame is to be sent, it is surely IPv6
-        ip_src = (uint16_t *)bg_src_ip[i];
-        ip_dst = (uint16_t *)bg_dst_ip[i];
+        ip_src = bg_src_ip[i];
+        ip_dst = bg_dst_ip[i];
         chksum = bg_udp_chksum_start;
         udp_sport = (uint16_t *)bg_udp_sport[i];
         udp_dport = (uint16_t *)bg_udp_dport[i];
@@ -1979,9 +3493,9 @@ int msend(void *par) {
               src_ip = sip_max;
             break;
           case 3:                   // pseudorandom 
-            sip = uni_dis_sip(gen_sip);
+            sip = sip_bytes < 8 ? uni_dis_sip(gen_sip) : uni_dis_sip64(gen_sip);
         }
-        ip_chksum += *ip_src = htons(sip);     // set src IP 16-bit field and add to checksum
+        ip_chksum += setIpField(ip_src, sip, sip_bytes);     // set src IP field and add to checksum
       }
       if ( var_dip ) {
         // destination IP is varying
@@ -1995,9 +3509,9 @@ int msend(void *par) {
               dst_ip = dip_max;
             break;
           case 3:                           // pseudorandom
-            dip = uni_dis_dip(gen_dip);
+            dip = dip_bytes < 8 ? uni_dis_dip(gen_dip) : uni_dis_dip64(gen_dip);
         }
-        ip_chksum += *ip_dst = htons(dip);     // set dst IP 16-bit field and add to checksum
+        ip_chksum += setIpField(ip_dst, dip, dip_bytes);     // set dst IP field and add to checksum
       }
       if ( ipv4_frame ) {
         // only the IPv4 header contains IP checksum
@@ -2047,23 +3561,427 @@ int msend(void *par) {
         chksum = 0xffff;
       *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
       // finally, when its time is here, send the frame
-      while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); 	// Beware: an "empty" loop, as well as in the next line
-      while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) ); 		// send out the frame
-      i = (i+1) % N;
+      lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+      if ( unlikely( responder_echo && fg_frame ) )
+        stampEcho(rte_pktmbuf_mtod(pkt_mbuf, uint8_t *) + echo_data_offset, rte_rdtsc()); // time stamp for round-trip time measurement
+      fr.send(pkt_mbuf); 		// send out the frame
+      i = (i+1) % fr.copies;
     } // this is the end of the sending cycle
 
   } // end of implementation of varying port numbers 
   // Now, we check the time
   elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
   if ( elapsed_seconds > duration*TOLERANCE )
     printf("Warning: %s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
-  else
+  else if ( !late )
+    printf("%s frames sent: %lu\n", side, sent_frames);
+
+  return elapsed_seconds > duration*TOLERANCE || late; // non-zero, if the sending was too slow (used by the self-calibration)
+}
+
+// sends Test Frames using a pre-materialized traffic schedule (Schedule 1)
+// The frames are pre-generated like in the varport version of msend(), but the values of their varying fields and
+// their checksums are taken from the records of the schedule, thus no random numbers or checksums are computed during sending.
+int ssend(void *par) {
+  // collecting input parameters:
+  class sSenderParameters *p = (class sSenderParameters *)par;
+  class senderCommonParameters *cp = p->cp;
+  class trafficSchedule *s = p->schedule;
+
+  // parameters directly correspond to the data members of class Throughput
+  uint16_t ipv6_frame_size = cp->ipv6_frame_size;
+  uint32_t frame_rate = cp->frame_rate;
+  uint16_t duration = cp->duration;
+  uint64_t hz = cp->hz;
+  uint64_t start_tsc = cp->start_tsc;
+  const imixParameters *imix = cp->imix;
+
+  // parameters which are different for the Left sender and the Right sender
+  int ip_version = p->ip_version;
+  rte_mempool *pkt_pool = p->pkt_pool;
+  uint16_t eth_id = p->eth_id;
+  const char *side = p->side;
+  struct ether_addr *dst_mac = p->dst_mac;
+  struct ether_addr *src_mac = p->src_mac;
+  uint32_t *src_ipv4 = p->src_ipv4;
+  uint32_t *dst_ipv4 = p->dst_ipv4;
+  struct in6_addr *src_ipv6 = p->src_ipv6;
+  struct in6_addr *dst_ipv6 = p->dst_ipv6;
+  struct in6_addr *src_bg= p->src_bg;
+  struct in6_addr *dst_bg = p->dst_bg;
+  unsigned var_sip = p->var_sip;
+  unsigned var_dip = p->var_dip;
+  uint16_t src_ipv4_offset = p->src_ipv4_offset;
+  uint16_t dst_ipv4_offset = p->dst_ipv4_offset;
+  uint16_t src_ipv6_offset = p->src_ipv6_offset;
+  uint16_t dst_ipv6_offset = p->dst_ipv6_offset;
+  unsigned var_sport = p->var_sport;
+  unsigned var_dport = p->var_dport;
+  unsigned varport = var_sport || var_dport; // derived logical value: at least one port has to be changed?
+
+  // further local variables
+  uint64_t frames_to_send = s->frames;	// frames of the schedule (with IMIX-bps, it depends on the IP version)
+  uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
+  double elapsed_seconds; // for checking the elapsed seconds during sending
+  uint64_t ready; // the records of the frames below this index are surely ready
+  uint64_t stalls = 0; // the number of times the sender had to wait for the helper lcore
+  uint64_t slot; // index of the record of the current frame
+  scheduleRecord *r; // the record of the current frame
+  unsigned classes = imix ? imix->sizes : 1; // number of frame size classes
+  uint64_t class_sent[IMIX_MAX_SIZES] = {0}; // number of frames sent of each frame size class
+  double l1_cycles = imix && imix->bps ? 8.0*hz/(imix->bit_rate*1000000.0) : 0; // cycles per byte on the wire, if the bit rate is paced
+  double send_tsc = start_tsc; // sending time of the current frame, if the bit rate is paced
+
+  int i; // cycle variable to index the arrays of the copies of the frames
+  unsigned c; // cycle variable to index the arrays of the frame size classes
+  frameReuse fr(eth_id, side); // the copies of the frames are reused safely
+  struct rte_mbuf *fg_pkt_mbuf[IMIX_MAX_SIZES][N], *bg_pkt_mbuf[IMIX_MAX_SIZES][N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
+  uint8_t *pkt; // working pointer to the current frame (in the message buffer)
+  uint8_t *fg_src_ip[IMIX_MAX_SIZES][N], *fg_dst_ip[IMIX_MAX_SIZES][N], *fg_ipv4_chksum[IMIX_MAX_SIZES][N]; // pointers to the given 16-bit fields to be modified
+  uint8_t *bg_src_ip[IMIX_MAX_SIZES][N], *bg_dst_ip[IMIX_MAX_SIZES][N];
+  uint8_t *fg_udp_sport[IMIX_MAX_SIZES][N], *fg_udp_dport[IMIX_MAX_SIZES][N], *fg_udp_chksum[IMIX_MAX_SIZES][N]; // pointers to the given fields
+  uint8_t *bg_udp_sport[IMIX_MAX_SIZES][N], *bg_udp_dport[IMIX_MAX_SIZES][N], *bg_udp_chksum[IMIX_MAX_SIZES][N];
+  uint16_t *ip_src, *ip_dst, *ipv4_chksum; // working pointers to the given 16-bit fields to be modified
+  uint16_t *udp_sport, *udp_dport, *udp_chksum; // working pointers to the given fields to be modified
+
+  for ( c=0; c<classes; c++ ) {
+    uint16_t ipv6_size = imix ? imix->size[c] : ipv6_frame_size; // IPv6 frame size of the class
+    uint16_t ipv4_size = ipv6_size-20; // IPv4 frames are 20 bytes shorter
+    for ( i=0; i<fr.copies; i++ ) {
+      // create foreground Test Frame (if no port numbers change, then the fixed ones are set, but UDP checksum remains uncomplemented)
+      if ( ip_version == 4 ) {
+        fg_pkt_mbuf[c][i] = fr.add(varport ? mkTestFrame4(ipv4_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport) :
+                                             mkVaripTestFrame4(ipv4_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport));
+        pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[c][i], uint8_t *); // Access the Test Frame in the message buffer
+        fg_src_ip[c][i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the 16-bits to be modified
+        fg_dst_ip[c][i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the 16-bits to be modified
+        fg_ipv4_chksum[c][i] = pkt + 24;               // 14+10: IPv4 header checksum
+        fg_udp_sport[c][i] = pkt + 34;    // 14+20+0: source UDP port 
+        fg_udp_dport[c][i] = pkt + 36;    // 14+20+2: destination UDP port
+        fg_udp_chksum[c][i] = pkt + 40;   // 14+20+6: UDP checksum 
+      } else { // IPv6
+        fg_pkt_mbuf[c][i] = fr.add(varport ? mkTestFrame6(ipv6_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport) :
+                                             mkVaripTestFrame6(ipv6_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport));
+        pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[c][i], uint8_t *); // Access the Test Frame in the message buffer
+        fg_src_ip[c][i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
+        fg_dst_ip[c][i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
+        fg_ipv4_chksum[c][i] = 0;                      // not used
+        fg_udp_sport[c][i] = pkt + 54;    // 14+40+0: source UDP port
+        fg_udp_dport[c][i] = pkt + 56;    // 14+40+2: destination UDP port
+        fg_udp_chksum[c][i] = pkt + 60;   // 14+40+6: UDP checksum
+      }
+      if ( ip_version == 4 )
+        s->fg_ipv4_chksum_start[c] = ~*(uint16_t *)fg_ipv4_chksum[c][i]; // save the uncomplemented checksum value (same for all values of "i") 
+      s->fg_udp_chksum_start[c] = *(uint16_t *)fg_udp_chksum[c][i]; // save the uncomplemented checksum value (same for all values of "i") 
+      // create backround Test Frame (always IPv6)
+      bg_pkt_mbuf[c][i] = fr.add(varport ? mkTestFrame6(ipv6_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport) :
+                                           mkVaripTestFrame6(ipv6_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport));
+      pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[c][i], uint8_t *); // Access the Test Frame in the message buffer
+      bg_src_ip[c][i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
+      bg_dst_ip[c][i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
+      bg_udp_sport[c][i] = pkt + 54;    // 14+40+0: source UDP port
+      bg_udp_dport[c][i] = pkt + 56;    // 14+40+2: destination UDP port
+      bg_udp_chksum[c][i] = pkt + 60;   // 14+40+6: UDP checksum
+      s->bg_udp_chksum_start[c] = *(uint16_t *)bg_udp_chksum[c][i]; // save the uncomplemented checksum value (same for all values of "i")
+    }
+  } 
+  s->started = true; // the helper lcore may start generating the chunks
+
+  if ( !s->chunked ) {
+    // the whole schedule is built now, before sending begins
+    uint64_t gen_start = rte_rdtsc();
+    s->generate(frames_to_send);
+    s->produced = frames_to_send;
+    printf("Info: %s traffic schedule was built in %3.6lf seconds.\n", side, (double)(rte_rdtsc()-gen_start)/hz);
+    if ( rte_rdtsc() > start_tsc )
+      printf("Warning: %s traffic schedule was not ready at the start of sending, the test may be invalid.\n", side);
+  }
+
+  // naive sender version: it is simple and fast
+  i=0; // increase maunally after each sending
+  slot=0; // increase maunally after each sending
+  ready=s->produced;
+  for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
+    if ( unlikely( sent_frames >= ready ) ) {
+      // chunked schedule: the next chunk is to be used
+      if ( (ready = s->produced) <= sent_frames ) {
+        stalls++; // the helper lcore is late
+        while ( (ready = s->produced) <= sent_frames );
+      }
+    }
+    r = s->records + slot;
+    c = r->size;
+    // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
+    if ( r->fg ) {
+      fr.wait(fg_pkt_mbuf[c][i]); // its previous transmission must be completed
+      // foreground frame is to be sent
+      ip_src = (uint16_t *)fg_src_ip[c][i];
+      ip_dst = (uint16_t *)fg_dst_ip[c][i];
+      ipv4_chksum = (uint16_t *)fg_ipv4_chksum[c][i]; // null pointer, if IPv6
+      udp_sport = (uint16_t *)fg_udp_sport[c][i];
+      udp_dport = (uint16_t *)fg_udp_dport[c][i];
+      udp_chksum = (uint16_t *)fg_udp_chksum[c][i];
+      pkt_mbuf = fg_pkt_mbuf[c][i];
+    } else {
+      fr.wait(bg_pkt_mbuf[c][i]); // its previous transmission must be completed
+      // background frame is to be sent, it is surely IPv6
+      ip_src = (uint16_t *)bg_src_ip[c][i];
+      ip_dst = (uint16_t *)bg_dst_ip[c][i];
+      ipv4_chksum = 0;
+      udp_sport = (uint16_t *)bg_udp_sport[c][i];
+      udp_dport = (uint16_t *)bg_udp_dport[c][i];
+      udp_chksum = (uint16_t *)bg_udp_chksum[c][i];
+      pkt_mbuf = bg_pkt_mbuf[c][i];
+    }
+    // copy the pre-computed values into the frame
+    if ( var_sip )
+      *ip_src = r->sip;
+    if ( var_dip )
+      *ip_dst = r->dip;
+    if ( ipv4_chksum )
+      *ipv4_chksum = r->ipv4_chksum;
+    if ( var_sport )
+      *udp_sport = r->sport;
+    if ( var_dport )
+      *udp_dport = r->dport;
+    *udp_chksum = r->udp_chksum;
+    // finally, when its time is here, send the frame
+    if ( l1_cycles ) {
+      // bit rate pacing: the sending time of the next frame depends on the size of this one
+      lateness.wait(send_tsc);	// busy waiting for the sending time of the frame
+      send_tsc += l1_cycles*(pkt_mbuf->pkt_len+RTE_ETHER_CRC_LEN+20); // preamble, SFD and IFG: 20 bytes
+    } else {
+      lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+    }
+    fr.send(pkt_mbuf); 		// send out the frame
+    class_sent[c]++;
+    i = (i+1) % fr.copies;
+    if ( ++slot == s->slots )
+      slot = 0;
+    if ( s->chunked && (sent_frames+1) % SCHEDULE_CHUNK == 0 )
+      s->consumed = sent_frames+1; // the records of this chunk may be overwritten
+  } // this is the end of the sending cycle
+
+  // Now, we check the time
+  elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
+  printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
+  if ( stalls )
+    printf("Warning: %s sender had to wait for its helper lcore %lu times.\n", side, stalls);
+  if ( elapsed_seconds > duration*TOLERANCE )
+    printf("Warning: %s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
+  else if ( !late ) {
     printf("%s frames sent: %lu\n", side, sent_frames);
+    if ( imix )
+      for ( c=0; c<classes; c++ )
+        printf("%s frames sent of size %u: %lu\n", side, imix->size[c], class_sent[c]);
+  }
+
+  return elapsed_seconds > duration*TOLERANCE || late; // non-zero, if the sending was too slow (used by the self-calibration)
+}
+
+// generates the records of a chunked traffic schedule on a helper lcore: it is ahead of the sender by at most two chunks
+int scheduleHelper(void *par) {
+  class trafficSchedule *s = (class trafficSchedule *)par;
+  uint64_t produced = 0; // the records of the frames below this index are ready
+  uint64_t count; // the number of records in the current chunk
+
+  while ( !s->started ); // the sender sets the checksums of its pre-generated frames
+  while ( produced < s->frames ) {
+    count = std::min<uint64_t>(SCHEDULE_CHUNK, s->frames - produced);
+    while ( produced + count > s->consumed + s->slots ); // the records of the chunk to be overwritten must have been sent
+    s->generate(count);
+    s->produced = produced += count;
+  }
+  return 0;
+}
+
+// the first stage of the frame preparation pipeline (Pipeline 1) running on a helper lcore:
+// the values of the varying fields and the checksums are computed by a trafficSchedule in bursts, then each frame is
+// copied from a template into a new mbuf, its fields are set, and the burst is passed to the sender through the ring.
+// The mbufs are freed by the PMD after transmission, thus the write after send problem does not occur.
+int pipelineProducer(void *par) {
+  // collecting input parameters:
+  class pSenderParameters *p = (class pSenderParameters *)par;
+  class senderCommonParameters *cp = p->cp;
+  class trafficSchedule *s = p->schedule;
+  struct rte_ring *ring = p->ring;
+
+  // parameters directly correspond to the data members of class Throughput
+  uint16_t ipv6_frame_size = cp->ipv6_frame_size;
+  uint64_t hz = cp->hz;
+  const imixParameters *imix = cp->imix;
+
+  // parameters which are different for the Left sender and the Right sender
+  int ip_version = p->ip_version;
+  rte_mempool *pkt_pool = p->pkt_pool;
+  const char *side = p->side;
+  unsigned var_sip = p->var_sip;
+  unsigned var_dip = p->var_dip;
+  unsigned var_sport = p->var_sport;
+  unsigned var_dport = p->var_dport;
+  unsigned varport = var_sport || var_dport; // derived logical value: at least one port has to be changed?
+
+  // further local variables
+  uint64_t frames_to_send = s->frames; // the producer prepares this number of frames
+  uint64_t prepared; // counts the number of prepared frames
+  unsigned count, enqueued; // number of frames in the current burst and the number of them already enqueued
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // the current burst of prepared frames
+  struct rte_mbuf *t; // the template of the current frame
+  unsigned classes = imix ? imix->sizes : 1; // number of frame size classes
+  struct rte_mbuf *tmpl[IMIX_MAX_SIZES][2]; // templates of the background (0) and foreground (1) frames of each size class, they are never sent
+  struct {
+    uint16_t sip, dip, ipv4_chksum, sport, dport, udp_chksum;
+  } off[2]; // offsets of the varying fields in the background (0) and foreground (1) frames
+  uint8_t *pkt; // working pointer to the current frame (in the message buffer)
+  scheduleRecord *r; // the record of the current frame
+  uint64_t busy_cycles = 0, full_cycles = 0; // cycles spent with preparing the frames and waiting for free space in the ring
+  uint64_t t0; // beginning of the current measured period
+
+  // the offsets do not depend on the frame size
+  if ( ip_version == 4 )
+    off[1] = { (uint16_t)(26+p->src_ipv4_offset), (uint16_t)(30+p->dst_ipv4_offset), 24, 34, 36, 40 };
+  else
+    off[1] = { (uint16_t)(22+p->src_ipv6_offset), (uint16_t)(38+p->dst_ipv6_offset), 0, 54, 56, 60 };
+  off[0] = { (uint16_t)(22+p->src_ipv6_offset), (uint16_t)(38+p->dst_ipv6_offset), 0, 54, 56, 60 };
+
+  // create the templates and set the starting values of the checksums (see msend)
+  for ( unsigned c=0; c<classes; c++ ) {
+    uint16_t ipv6_size = imix ? imix->size[c] : ipv6_frame_size; // IPv6 frame size of the class
+    uint16_t ipv4_size = ipv6_size-20; // IPv4 frames are 20 bytes shorter
+    if ( ip_version == 4 ) {
+      tmpl[c][1] = varport ? mkTestFrame4(ipv4_size, pkt_pool, side, p->dst_mac, p->src_mac, p->src_ipv4, p->dst_ipv4, var_sport, var_dport) :
+                             mkVaripTestFrame4(ipv4_size, pkt_pool, side, p->dst_mac, p->src_mac, p->src_ipv4, p->dst_ipv4, var_sport, var_dport);
+      s->fg_ipv4_chksum_start[c] = ~*(uint16_t *)(rte_pktmbuf_mtod(tmpl[c][1], uint8_t *) + off[1].ipv4_chksum);
+    } else {
+      tmpl[c][1] = varport ? mkTestFrame6(ipv6_size, pkt_pool, side, p->dst_mac, p->src_mac, p->src_ipv6, p->dst_ipv6, var_sport, var_dport) :
+                             mkVaripTestFrame6(ipv6_size, pkt_pool, side, p->dst_mac, p->src_mac, p->src_ipv6, p->dst_ipv6, var_sport, var_dport);
+    }
+    tmpl[c][0] = varport ? mkTestFrame6(ipv6_size, pkt_pool, side, p->dst_mac, p->src_mac, p->src_bg, p->dst_bg, var_sport, var_dport) :
+                           mkVaripTestFrame6(ipv6_size, pkt_pool, side, p->dst_mac, p->src_mac, p->src_bg, p->dst_bg, var_sport, var_dport);
+    s->fg_udp_chksum_start[c] = *(uint16_t *)(rte_pktmbuf_mtod(tmpl[c][1], uint8_t *) + off[1].udp_chksum);
+    s->bg_udp_chksum_start[c] = *(uint16_t *)(rte_pktmbuf_mtod(tmpl[c][0], uint8_t *) + off[0].udp_chksum);
+  }
+
+  for ( prepared = 0; prepared < frames_to_send; prepared += count ) {
+    t0 = rte_rdtsc();
+    count = std::min<uint64_t>(MAX_PKT_BURST, frames_to_send - prepared);
+    s->generate(count); // the records of this burst are stored in records[0..count-1], as the schedule has MAX_PKT_BURST slots
+    while ( rte_pktmbuf_alloc_bulk(pkt_pool, pkt_mbufs, count) ); // the PMD may not have freed the sent frames yet
+    for ( unsigned j=0; j<count; j++ ) {
+      r = s->records + j;
+      pkt = rte_pktmbuf_mtod(pkt_mbufs[j], uint8_t *);
+      t = tmpl[r->size][r->fg];
+      rte_memcpy(pkt, rte_pktmbuf_mtod(t, uint8_t *), t->data_len);
+      pkt_mbufs[j]->pkt_len = pkt_mbufs[j]->data_len = t->data_len;
+      if ( var_sip )
+        *(uint16_t *)(pkt + off[r->fg].sip) = r->sip;
+      if ( var_dip )
+        *(uint16_t *)(pkt + off[r->fg].dip) = r->dip;
+      if ( ip_version == 4 && r->fg )
+        *(uint16_t *)(pkt + off[1].ipv4_chksum) = r->ipv4_chksum;
+      if ( var_sport )
+        *(uint16_t *)(pkt + off[r->fg].sport) = r->sport;
+      if ( var_dport )
+        *(uint16_t *)(pkt + off[r->fg].dport) = r->dport;
+      *(uint16_t *)(pkt + off[r->fg].udp_chksum) = r->udp_chksum;
+    }
+    busy_cycles += rte_rdtsc()-t0;
+    t0 = rte_rdtsc();
+    for ( enqueued = 0; enqueued < count; )
+      enqueued += rte_ring_sp_enqueue_burst(ring, (void **)pkt_mbufs+enqueued, count-enqueued, NULL);
+    full_cycles += rte_rdtsc()-t0;
+  }
+  for ( unsigned c=0; c<classes; c++ ) {
+    rte_pktmbuf_free(tmpl[c][0]);
+    rte_pktmbuf_free(tmpl[c][1]);
+  }
 
+  printf("Info: %s producer prepared %lu frames: %.1lf cycles/frame preparing, waited %3.6lf seconds for free space in the ring.\n",
+         side, prepared, prepared ? (double)busy_cycles/prepared : 0.0, (double)full_cycles/hz);
   return 0;
 }
 
+// the second stage of the frame preparation pipeline (Pipeline 1): dequeues the prepared frames in bursts, paces and sends them
+int psend(void *par) {
+  // collecting input parameters:
+  class pSenderParameters *p = (class pSenderParameters *)par;
+  class senderCommonParameters *cp = p->cp;
+  struct rte_ring *ring = p->ring;
+
+  // parameters directly correspond to the data members of class Throughput
+  uint32_t frame_rate = cp->frame_rate;
+  uint16_t duration = cp->duration;
+  uint64_t hz = cp->hz;
+  uint64_t start_tsc = cp->start_tsc;
+  const imixParameters *imix = cp->imix;
+
+  // parameters which are different for the Left sender and the Right sender
+  uint16_t eth_id = p->eth_id;
+  const char *side = p->side;
+
+  // further local variables
+  uint64_t frames_to_send = p->schedule->frames;	// frames of the schedule (with IMIX-bps, it depends on the IP version)
+  uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
+  double elapsed_seconds; // for checking the elapsed seconds during sending
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // the current burst of prepared frames
+  unsigned frames = 0, next = 0; // number of frames in the current burst and the index of the next one to be sent
+  uint64_t empty_cycles = 0, idle_cycles = 0, tx_cycles = 0; // cycles spent waiting for the producer, waiting for the sending time and sending
+  uint64_t t0, t1; // time stamps of the measured periods
+  uint64_t total_cycles; // sum of the above ones
+  double l1_cycles = imix && imix->bps ? 8.0*hz/(imix->bit_rate*1000000.0) : 0; // cycles per byte on the wire, if the bit rate is paced
+  double send_tsc = start_tsc; // sending time of the current frame, if the bit rate is paced
+
+  while ( rte_rdtsc() < start_tsc ); // the producer fills the ring in the meantime
+  for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
+    if ( next == frames ) {
+      // the current burst is exhausted, the next one is taken from the ring
+      t0 = rte_rdtsc();
+      while ( !(frames = rte_ring_sc_dequeue_burst(ring, (void **)pkt_mbufs, MAX_PKT_BURST, NULL)) );
+      empty_cycles += rte_rdtsc()-t0;
+      next = 0;
+    }
+    // when its time is here, send the frame
+    t0 = rte_rdtsc();
+    if ( l1_cycles ) {
+      // bit rate pacing: the sending time of the next frame depends on the size of this one
+      t1 = lateness.wait(send_tsc);	// busy waiting for the sending time of the frame
+      send_tsc += l1_cycles*(pkt_mbufs[next]->pkt_len+RTE_ETHER_CRC_LEN+20); // preamble, SFD and IFG: 20 bytes
+    } else {
+      t1 = lateness.wait(start_tsc+sent_frames*hz/frame_rate);	// busy waiting for the sending time of the frame
+    }
+    while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbufs[next], 1) ); 		// send out the frame
+    tx_cycles += rte_rdtsc()-t1;
+    idle_cycles += t1-t0;
+    next++;
+  } // this is the end of the sending cycle
+
+  // Now, we check the time
+  elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
+  printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
+  if ( elapsed_seconds > duration*TOLERANCE )
+    printf("Warning: %s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
+  else if ( !late )
+    printf("%s frames sent: %lu\n", side, sent_frames);
+
+  // report the cycles of the sender stage, the producer stage reports its own cycles
+  total_cycles = empty_cycles + idle_cycles + tx_cycles;
+  if ( sent_frames && total_cycles ) {
+    printf("Info: %s sender: %.1lf cycles/frame sending, %.1lf cycles/frame waiting for the producer, %.1lf cycles/frame idle (pacing).\n",
+           side, (double)tx_cycles/sent_frames, (double)empty_cycles/sent_frames, (double)idle_cycles/sent_frames);
+    printf("Info: %s pipeline bottleneck: %s\n", side, empty_cycles > total_cycles/100 ? "producer" :
+           idle_cycles < total_cycles/100 ? "sender" : "none, both stages can keep up with the frame rate");
+  }
+  return elapsed_seconds > duration*TOLERANCE || late; // non-zero, if the sending was too slow (used by the self-calibration)
+}
+
 // Initiator/Sender: sends Preliminary Frames (no more used for sending real Test Frames)
 int isend(void *par) {
   // collecting input parameters:
@@ -2079,6 +3997,7 @@ int isend(void *par) {
   uint32_t m = cp->m;
   uint64_t hz = cp->hz;
   uint64_t start_tsc = cp->start_tsc;
+  uint8_t tcp_flags = cp->tcp_flags;
 
   // parameters which are different for the Left sender and the Right sender
   int ip_version = p->ip_version;
@@ -2109,6 +4028,8 @@ int isend(void *par) {
   // further local variables
   uint64_t frames_to_send;
   uint64_t sent_frames=0; 	// counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
   bits32 *uniquePC=uniquePortComb;	// working pointer to the current element of uniquePortComb
 
   frames_to_send = p->pre_frames;	// use the specified value for sending preliminary frames
@@ -2122,16 +4043,16 @@ int isend(void *par) {
       struct rte_mbuf *fg_pkt_mbuf, *bg_pkt_mbuf; // message buffers for fg. and bg. Test Frames
       // create foreground Test Frame
       if ( ip_version == 4 )
-        fg_pkt_mbuf = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0);
+        fg_pkt_mbuf = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, 0, 0, tcp_flags);
       else  // IPv6
-        fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0);
+        fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0, tcp_flags);
   
       // create backround Test Frame (always IPv6)
-      bg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0);
+      bg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0, tcp_flags);
   
       // naive sender version: it is simple and fast
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further two will come!
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
         if ( sent_frames % n  < m )
           while ( !rte_eth_tx_burst(eth_id, 0, &fg_pkt_mbuf, 1) ); // send foreground frame
         else
@@ -2156,28 +4077,27 @@ int isend(void *par) {
         // create foreground Test Frame
         if ( ip_version == 4 ) {
           ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) i; // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-          fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, 0, 0);
+          fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, 0, 0, tcp_flags);
         }
         else { // IPv6
           ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-          fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, 0, 0);
+          fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, 0, 0, tcp_flags);
         } 
         // create backround Test Frame (always IPv6)
         ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, 0, 0);
+        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, 0, 0, tcp_flags);
       }
    
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis(0, num_dest_nets-1);	// uniform distribution in [0, num_dest_nets-1]
+      thread_local fastRandom gen(rd());
+      randomRange uni_dis(0, num_dest_nets-1);	// uniform distribution in [0, num_dest_nets-1]
   
       // naive sender version: it is simple and fast
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
         int index = uni_dis(gen);	// index of the pre-generated frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further two will come!
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
         if ( sent_frames % n  < m )
           while ( !rte_eth_tx_burst(eth_id, 0, &fg_pkt_mbuf[index], 1) ); // send foreground frame
         else
@@ -2193,6 +4113,7 @@ int isend(void *par) {
       // source and/or destination port number(s) and UDP checksum are updated
       // N size arrays are used to resolve the write after send problem
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N]; // pointers to the given fields
@@ -2203,28 +4124,28 @@ int isend(void *par) {
       uint16_t e_sport, e_dport; // values of source and destination port numbers -- to be preserved, used for port enumeration of foreground traffic
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
       
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground Test Frame
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, tcp_flags));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[i] = pkt + 34;
           fg_udp_dport[i] = pkt + 36;
-          fg_udp_chksum[i] = pkt + 40;
+          fg_udp_chksum[i] = pkt + (tcp_flags ? 50 : 40);
         } else { // IPv6
-          fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[i] = pkt + 54;
           fg_udp_dport[i] = pkt + 56;
-          fg_udp_chksum[i] = pkt + 60;
+          fg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);
         }
         fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
         // create backround Test Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+        bg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
         bg_udp_sport[i] = pkt + 54;
         bg_udp_dport[i] = pkt  + 56;
-        bg_udp_chksum[i] = pkt + 60;
+        bg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);
         bg_udp_chksum_start = *(uint16_t *)bg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
       } 
 
@@ -2258,16 +4179,17 @@ int isend(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);	// uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);	// uniform distribution in [sport_min, sport_max]
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      randomRange uni_dis_sport(sport_min, sport_max);	// uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);	// uniform distribution in [sport_min, sport_max]
 
       // naive sender version: it is simple and fast
       i=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start;
           udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -2275,6 +4197,7 @@ int isend(void *par) {
           udp_chksum = (uint16_t *)fg_udp_chksum[i];
           pkt_mbuf = fg_pkt_mbuf[i];
         } else {
+          fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
           // background frame is to be sent
           chksum = bg_udp_chksum_start;
           udp_sport = (uint16_t *)bg_udp_sport[i];
@@ -2359,9 +4282,9 @@ int isend(void *par) {
           chksum = 0xffff;
         *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); 	// Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) ); 		// send out the frame
-        i = (i+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf); 		// send out the frame
+        i = (i+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
     else { 
@@ -2370,6 +4293,7 @@ int isend(void *par) {
       // source and/or destination port number(s) and UDP checksum are updated in the actually used copy before sending
       // assertion: num_dest_nets <= 256
       int j; // cycle variable to index the N size array: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[256][N], *bg_pkt_mbuf[256][N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[256][N], *fg_udp_dport[256][N], *fg_udp_chksum[256][N]; // pointers to the given fields of the pre-prepared Test Frames
@@ -2391,32 +4315,32 @@ int isend(void *par) {
       curr_dst_bg = *dst_bg;
 
       // create Test Frames
-      for ( j=0; j<N; j++ ) {
+      for ( j=0; j<fr.copies; j++ ) {
         for ( i=0; i<num_dest_nets; i++ ) {
           // create foreground Test Frame (IPv4 or IPv6)
           if ( ip_version == 4 ) {
             ((uint8_t *)&curr_dst_ipv4)[2] = (uint8_t) i; // bits 16 to 23 of the IPv4 address are rewritten, like in 198.18.x.2
-            fg_pkt_mbuf[i][j] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport);
+            fg_pkt_mbuf[i][j] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, &curr_dst_ipv4, var_sport, var_dport, tcp_flags));
             pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
             fg_udp_sport[i][j] = pkt + 34;
             fg_udp_dport[i][j] = pkt + 36;
-            fg_udp_chksum[i][j] = pkt + 40;
+            fg_udp_chksum[i][j] = pkt + (tcp_flags ? 50 : 40);
           } else { // IPv6
             ((uint8_t *)&curr_dst_ipv6)[7] = (uint8_t) i; // bits 56 to 63 of the IPv6 address are rewritten, like in 2001:2:0:00xx::1
-            fg_pkt_mbuf[i][j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport);
+            fg_pkt_mbuf[i][j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, &curr_dst_ipv6, var_sport, var_dport, tcp_flags));
             pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
             fg_udp_sport[i][j] = pkt + 54;
             fg_udp_dport[i][j] = pkt + 56;
-            fg_udp_chksum[i][j] = pkt + 60;
+            fg_udp_chksum[i][j] = pkt + (tcp_flags ? 70 : 60);
           }
           fg_udp_chksum_start[i] = *(uint16_t *)fg_udp_chksum[i][j]; // save the uncomplemented checksum value (same for all values of "j")
           // create backround Test Frame (always IPv6)
           ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport);
+          bg_pkt_mbuf[i][j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport, tcp_flags));
           pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
           bg_udp_sport[i][j] = pkt + 54;
           bg_udp_dport[i][j] = pkt  + 56;
-          bg_udp_chksum[i][j] = pkt + 60;
+          bg_udp_chksum[i][j] = pkt + (tcp_flags ? 70 : 60);
           bg_udp_chksum_start[i] = *(uint16_t *)bg_udp_chksum[i][j]; // save the uncomplemented checksum value (same for all values of "j")
         }
       }
@@ -2433,12 +4357,12 @@ int isend(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_net(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
+      thread_local fastRandom gen_net(rd());
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      randomRange uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
+      randomRange uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
 
       // naive sender version: it is simple and fast
       j=0; // increase maunally after each sending
@@ -2446,6 +4370,7 @@ int isend(void *par) {
         int index = uni_dis_net(gen_net); // index of the pre-generated Test Frame for the given destination network
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[index][j]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start[index];
           udp_sport = (uint16_t *)fg_udp_sport[index][j];
@@ -2453,6 +4378,7 @@ int isend(void *par) {
           udp_chksum = (uint16_t *)fg_udp_chksum[index][j];
           pkt_mbuf = fg_pkt_mbuf[index][j];
         } else {
+          fr.wait(bg_pkt_mbuf[index][j]); // its previous transmission must be completed
           // background frame is to be sent
           chksum = bg_udp_chksum_start[index];
           udp_sport = (uint16_t *)bg_udp_sport[index][j];
@@ -2502,9 +4428,9 @@ int isend(void *par) {
           chksum = 0xffff;
         *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        j = (j+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        j = (j+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of the optimized code for multiple destination networks
   } // end of implementation of varying port numbers 
@@ -2512,16 +4438,16 @@ int isend(void *par) {
   // Now, we check the time
   uint64_t elapsed_tsc = rte_rdtsc()-start_tsc;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, (double)elapsed_tsc/hz);
+  late = lateness.report(side, hz, cp->max_lateness);
   // this is a preliminary test, 'duration' is not valid
   if ( elapsed_tsc > hz*frames_to_send/frame_rate*TOLERANCE )
     printf("Warning: %s sending was too slow (only %3.10lf percent of required rate), the test is invalid.\n", side,
              100.0*frames_to_send/elapsed_tsc*hz/frame_rate);
-  else
+  else if ( !late )
     printf("%s frames sent: %lu\n", side, sent_frames);
 
-  if ( uniquePortComb ) 
-    rte_free(uniquePortComb);	// free the array for pre-generated unique port number combinations
-  return 0;
+  // the array of pre-generated unique port number combinations is not freed: it is reused by the steps of the searches and calibration
+  return elapsed_tsc > hz*frames_to_send/frame_rate*TOLERANCE || late; // non-zero, if the sending was too slow (used by the self-calibration)
 }
 
 // Initiator/Sender with multi IP: sends Preliminary Frames using multiple source and/or destination IP addresses
@@ -2541,6 +4467,7 @@ int imsend(void *par) {
   uint32_t m = cp->m;
   uint64_t hz = cp->hz;
   uint64_t start_tsc = cp->start_tsc;
+  uint8_t tcp_flags = cp->tcp_flags;
 
   // parameters which are different for the Left sender and the Right sender
   int ip_version = p->ip_version;
@@ -2559,10 +4486,12 @@ int imsend(void *par) {
   unsigned var_sip = p->var_sip;
   unsigned var_dip = p->var_dip;
   // will be defined below: unsigned var_ip = var_sip || var_dip; // derived logical value: at least one IP address has to be changed?
-  uint16_t sip_min = p->sip_min;
-  uint16_t sip_max = p->sip_max;
-  uint16_t dip_min = p->dip_min;
-  uint16_t dip_max = p->dip_max;
+  uint64_t sip_min = p->sip_min;
+  uint64_t sip_max = p->sip_max;
+  uint64_t dip_min = p->dip_min;
+  uint64_t dip_max = p->dip_max;
+  unsigned sip_bytes = p->sip_bits/8;	// width of the varying field of the source IP address
+  unsigned dip_bytes = p->dip_bits/8;	// width of the varying field of the destination IP address
   uint16_t src_ipv4_offset = p->src_ipv4_offset;
   uint16_t dst_ipv4_offset = p->dst_ipv4_offset;
   uint16_t src_ipv6_offset = p->src_ipv6_offset;
@@ -2583,8 +4512,12 @@ int imsend(void *par) {
   // further local variables
   uint64_t frames_to_send = p->pre_frames;	// use the specified value for sending preliminary frames
   uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
   bits32 *uniqueIC=uniqueIpComb;      // working pointer to the current element of uniqueIpComb
   bits64 *uniqueFC=uniqueFtComb;      // working pointer to the current element of uniqueFtComb
+  randomPermutation *perm = 0;        // unique combinations of wide IP address fields are permuted on the fly (Enumerate-ips 3)
+  uint64_t v;                         // the current element of perm
 
   bool fg_frame, ipv4_frame;    // When sending IPv4 traffic, bacground frames are IPv6: they have no header checksum, 
                	                // and they treat UDP checksum differently (0 is an allowed value).
@@ -2593,6 +4526,15 @@ int imsend(void *par) {
   unsigned var_ip = var_sip || var_dip || enumerate_ips; // derived logical value: at least one IP address has to be changed?
   unsigned varport = var_sport || var_dport || enumerate_ports; // derived logical value: at least one port has to be changed?
 
+  if ( enumerate_ips == 3 && ( sip_bytes > 2 || dip_bytes > 2 ) ) {
+    // the combinations of the fields are numbered in mixed radix (dip, sip, dport, sport from the most significant one)
+    // and the numbers are permuted: a saturated size still gives unique combinations, only not all of them are used
+    uint64_t size = mulSat(sip_max-sip_min+1, dip_max-dip_min+1);
+    if ( enumerate_ports == 3 )
+      size = mulSat(size, (uint64_t)(sport_max-sport_min+1)*(dport_max-dport_min+1));
+    perm = new randomPermutation(size, std::random_device()());
+  }
+
   if ( !varport ) {
     // Implementation of multiple IP addresses (own idea) only, 
     // optimized code for using hard coded fix port numbers as defined in RFC 2544 https://tools.ietf.org/html/rfc2544#appendix-C.2.6.4
@@ -2602,46 +4544,48 @@ int imsend(void *par) {
     // Note: even if UDP port numbers do not change, UDP chechsum changes due to the pseudo-header.
 
     int i; // cycle variable to index the N size array: takes {0..N-1} values
+    frameReuse fr(eth_id, side); // the copies of the frames are reused safely
     struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
     uint8_t *pkt; // working pointer to the current frame (in the message buffer)
-    uint8_t *fg_src_ip[N], *fg_dst_ip[N], *fg_ipv4_chksum[N], *bg_src_ip[N], *bg_dst_ip[N]; // pointers to the given 16-bit fields to be modified
+    uint8_t *fg_src_ip[N], *fg_dst_ip[N], *fg_ipv4_chksum[N], *bg_src_ip[N], *bg_dst_ip[N]; // pointers to the given fields to be modified
     uint8_t *fg_udp_chksum[N], *bg_udp_chksum[N]; // pointers to the given fields
-    uint16_t *ip_src, *ip_dst, *ipv4_chksum; // working pointers to the given 16-bit fields to be modified
+    uint8_t *ip_src, *ip_dst; // working pointers to the varying fields of the IP addresses
+    uint16_t *ipv4_chksum; // working pointer to the IPv4 header checksum
     uint16_t *udp_chksum; // working pointers to the given fields to be modified
     uint16_t fg_ipv4_chksum_start;  // starting values (uncomplemented checksums taken from the original frames)
     uint16_t fg_udp_chksum_start, bg_udp_chksum_start;  // starting values (uncomplemented checksums taken from the original frames)
     uint32_t v4_chksum; // temporary variable: stores the starting value from the packet
-    uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the 16-bit IP address fields
+    uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the varying IP address fields
     uint32_t chksum; // temporary variable for UDP checksum calculation (store both)
-    uint16_t src_ip, dst_ip; // values of source and destination IP addresses -- to be preserved, when increase or decrease is done 
-    uint16_t e_sip, e_dip; // values of source and destination IP addresses -- to be preserved, used for IP addresses enumeration of foreground traffic
-    uint16_t sip, dip; // values of source and destination IP addresses -- temporary values
+    uint64_t src_ip, dst_ip; // values of source and destination IP addresses -- to be preserved, when increase or decrease is done 
+    uint64_t e_sip, e_dip; // values of source and destination IP addresses -- to be preserved, used for IP addresses enumeration of foreground traffic
+    uint64_t sip, dip; // values of source and destination IP addresses -- temporary values
     
-    for ( i=0; i<N; i++ ) {
+    for ( i=0; i<fr.copies; i++ ) {
       // create foreground Test Frame
       if ( ip_version == 4 ) {
-        fg_pkt_mbuf[i] = mkVaripTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport);
+        fg_pkt_mbuf[i] = fr.add(mkVaripTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-        fg_src_ip[i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the 16-bits to be modified
-        fg_dst_ip[i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the 16-bits to be modified
+        fg_src_ip[i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the varying field to be modified
+        fg_dst_ip[i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the varying field to be modified
         fg_ipv4_chksum[i] = pkt + 24;               // 14+10: IPv4 header checksum
-        fg_udp_chksum[i] = pkt + 40;   // 14+20+6: UDP checksum 
+        fg_udp_chksum[i] = pkt + (tcp_flags ? 50 : 40);   // 14+20+16: TCP checksum, 14+20+6: UDP checksum
       } else { // IPv6
-        fg_pkt_mbuf[i] = mkVaripTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+        fg_pkt_mbuf[i] = fr.add(mkVaripTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-        fg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
-        fg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
-        fg_udp_chksum[i] = pkt + 60;   // 14+40+6: UDP checksum
+        fg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the varying field to be modified
+        fg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the varying field to be modified
+        fg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);   // 14+40+16: TCP checksum, 14+40+6: UDP checksum
       }
       if ( ip_version == 4 )
         fg_ipv4_chksum_start = *(uint16_t *)fg_ipv4_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
       fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
       // create backround Test Frame (always IPv6)
-      bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+      bg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
       pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-      bg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
-      bg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
-      bg_udp_chksum[i] = pkt + 60;   // 14+40+6: UDP checksum
+      bg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the varying field to be modified
+      bg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the varying field to be modified
+      bg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);   // 14+40+16: TCP checksum, 14+40+6: UDP checksum
       bg_udp_chksum_start = *(uint16_t *)bg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
     } 
 
@@ -2667,7 +4611,7 @@ int imsend(void *par) {
           e_dip = dip_max;
           break;
         case 3:
-          if ( !uniqueIpComb )
+          if ( !uniqueIpComb && !perm )
             rte_exit(EXIT_FAILURE, "Error: Initiator/Sender received a NULL pointer to the array of pre-prepaired unique random IP addresses!\n");
           // unique pseudorandom IP address pairs are guarandteed by pre-prepaired random permutation
           break;
@@ -2675,28 +4619,32 @@ int imsend(void *par) {
 
     // prepare random number infrastructure
     thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-    thread_local std::mt19937_64 gen_sip(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    thread_local std::mt19937_64 gen_dip(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<int> uni_dis_sip(sip_min, sip_max);     // uniform distribution in [sip_min, sip_max]
-    std::uniform_int_distribution<int> uni_dis_dip(dip_min, dip_max);     // uniform distribution in [dip_min, dip_max]
+    thread_local fastRandom gen_sip(rd());
+    thread_local fastRandom gen_dip(rd());
+    randomRange uni_dis_sip(sip_min, sip_max);     // uniform distribution in [sip_min, sip_max]
+    randomRange uni_dis_dip(dip_min, dip_max);     // uniform distribution in [dip_min, dip_max]
+    randomRange64 uni_dis_sip64(sip_min, sip_max);	// uniform distribution for 64-bit fields in [sip_min, sip_max]
+    randomRange64 uni_dis_dip64(dip_min, dip_max);	// uniform distribution for 64-bit fields in [dip_min, dip_max]
 
     // naive sender version: it is simple and fast
     i=0; // increase maunally after each sending
     for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
       // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
       if ( fg_frame = sent_frames % n  < m ) {
+        fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
         // foreground frame is to be sent
         v4_chksum = fg_ipv4_chksum_start; // rubbish, if IPv6, but a branch instruction is spared
-        ip_src = (uint16_t *)fg_src_ip[i];
-        ip_dst = (uint16_t *)fg_dst_ip[i];
+        ip_src = fg_src_ip[i];
+        ip_dst = fg_dst_ip[i];
         ipv4_chksum = (uint16_t *)fg_ipv4_chksum[i]; // rubbish, if IPv6, but a branch instruction is spared
         chksum = fg_udp_chksum_start;
         udp_chksum = (uint16_t *)fg_udp_chksum[i];
         pkt_mbuf = fg_pkt_mbuf[i];
       } else {
+        fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
         // background frame is to be sent, it is surely IPv6
-        ip_src = (uint16_t *)bg_src_ip[i];
-        ip_dst = (uint16_t *)bg_dst_ip[i];
+        ip_src = bg_src_ip[i];
+        ip_dst = bg_dst_ip[i];
         chksum = bg_udp_chksum_start;
         udp_chksum = (uint16_t *)bg_udp_chksum[i];
         pkt_mbuf = bg_pkt_mbuf[i];
@@ -2715,8 +4663,8 @@ int imsend(void *par) {
                  e_dip = dip_min;
             } else
               dip = e_dip;
-            ip_chksum += *ip_src = htons(sip);     // set src IP 16-bit field and add to checksum
-            ip_chksum += *ip_dst = htons(dip);     // set dst IP 16-bit field and add to checksum
+            ip_chksum += setIpField(ip_src, sip, sip_bytes);     // set src IP field and add to checksum
+            ip_chksum += setIpField(ip_dst, dip, dip_bytes);     // set dst IP field and add to checksum
             break;
           case 2: // port numbers are enumerated in decresing order
             // sip is the low order counter, dip is the high order counter
@@ -2726,15 +4674,21 @@ int imsend(void *par) {
                  e_dip = dip_max;
             } else
               dip = e_dip;
-            ip_chksum += *ip_src = htons(sip);     // set src IP 16-bit field and add to checksum
-            ip_chksum += *ip_dst = htons(dip);     // set dst IP 16-bit field and add to checksum
+            ip_chksum += setIpField(ip_src, sip, sip_bytes);     // set src IP field and add to checksum
+            ip_chksum += setIpField(ip_dst, dip, dip_bytes);     // set dst IP field and add to checksum
             break;
           case 3: // the next unique pseudorandom IP address pair is taken
-            sip = uniqueIC->field.src; // read source IP address
-            dip = uniqueIC->field.dst; // read destination IP address
-            uniqueIC++;               // increase pointer: no check needed, we have surely enough
-            ip_chksum += *ip_src = htons(sip);     // set src IP 16-bit field and add to checksum
-            ip_chksum += *ip_dst = htons(dip);     // set dst IP 16-bit field and add to checksum
+            if ( likely( !perm ) ) {
+              sip = uniqueIC->field.src; // read source IP address
+              dip = uniqueIC->field.dst; // read destination IP address
+              uniqueIC++;               // increase pointer: no check needed, we have surely enough
+            } else {
+              v = (*perm)();            // wide fields: split the next element of the permutation
+              sip = nextDigit(v, sip_min, sip_max-sip_min+1);
+              dip = nextDigit(v, dip_min, dip_max-dip_min+1);
+            }
+            ip_chksum += setIpField(ip_src, sip, sip_bytes);     // set src IP field and add to checksum
+            ip_chksum += setIpField(ip_dst, dip, dip_bytes);     // set dst IP field and add to checksum
             break;
         } // end of switch
       } else {
@@ -2751,9 +4705,9 @@ int imsend(void *par) {
                 src_ip = sip_max;
               break;
             case 3:                   // pseudorandom 
-              sip = uni_dis_sip(gen_sip);
+              sip = sip_bytes < 8 ? uni_dis_sip(gen_sip) : uni_dis_sip64(gen_sip);
           }
-          ip_chksum += *ip_src = htons(sip);     // set src IP 16-bit field and add to checksum
+          ip_chksum += setIpField(ip_src, sip, sip_bytes);     // set src IP field and add to checksum
         }
         if ( var_dip ) {
           // destination IP is varying
@@ -2767,9 +4721,9 @@ int imsend(void *par) {
                 dst_ip = dip_max;
               break;
             case 3:                           // pseudorandom
-              dip = uni_dis_dip(gen_dip);
+              dip = dip_bytes < 8 ? uni_dis_dip(gen_dip) : uni_dis_dip64(gen_dip);
           }
-          ip_chksum += *ip_dst = htons(dip);     // set dst IP 16-bit field and add to checksum
+          ip_chksum += setIpField(ip_dst, dip, dip_bytes);     // set dst IP field and add to checksum
         }
       } // end of the else of "if ( enumerate_ips && fg_frame )" 
 
@@ -2789,9 +4743,9 @@ int imsend(void *par) {
         chksum = 0xffff;
       *udp_chksum = (uint16_t) chksum;          // set checksum in the frame
       // finally, when its time is here, send the frame
-      while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); 	// Beware: an "empty" loop, as well as in the next line
-      while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) ); 		// send out the frame
-      i = (i+1) % N;
+      lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+      fr.send(pkt_mbuf); 		// send out the frame
+      i = (i+1) % fr.copies;
     } // this is the end of the sending cycle
   } // end of optimized code for fixed port numbers
   else {
@@ -2803,55 +4757,57 @@ int imsend(void *par) {
     // varying 16-bit fields of the source and/or destination IP addresses and for IPv4, header checksum,
     // source and/or destination port number(s) and UDP checksum are updated.
     int i; // cycle variable to index the N size array: takes {0..N-1} values
+    frameReuse fr(eth_id, side); // the copies of the frames are reused safely
     struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
     uint8_t *pkt; // working pointer to the current frame (in the message buffer)
-    uint8_t *fg_src_ip[N], *fg_dst_ip[N], *fg_ipv4_chksum[N], *bg_src_ip[N], *bg_dst_ip[N]; // pointers to the given 16-bit fields to be modified
+    uint8_t *fg_src_ip[N], *fg_dst_ip[N], *fg_ipv4_chksum[N], *bg_src_ip[N], *bg_dst_ip[N]; // pointers to the given fields to be modified
     uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N]; // pointers to the given fields
-    uint16_t *ip_src, *ip_dst, *ipv4_chksum; // working pointers to the given 16-bit fields to be modified
+    uint8_t *ip_src, *ip_dst; // working pointers to the varying fields of the IP addresses
+    uint16_t *ipv4_chksum; // working pointer to the IPv4 header checksum
     uint16_t *udp_sport, *udp_dport, *udp_chksum; // working pointers to the given fields to be modified
     uint16_t fg_ipv4_chksum_start;  // starting values (uncomplemented checksums taken from the original frames)
     uint16_t fg_udp_chksum_start, bg_udp_chksum_start;  // starting values (uncomplemented checksums taken from the original frames)
     uint32_t v4_chksum; // temporary variable: stores the starting value from the packet
-    uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the 16-bit IP address fields
+    uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the varying IP address fields
     uint32_t chksum; // temporary variable for UDP checksum calculation (store both)
-    uint16_t src_ip, dst_ip; // values of source and destination IP addresses -- to be preserved, when increase or decrease is done 
+    uint64_t src_ip, dst_ip; // values of source and destination IP addresses -- to be preserved, when increase or decrease is done 
     uint16_t sport, dport; // values of source and destination port numbers -- to be preserved, when increase or decrease is done 
-    uint16_t e_sip, e_dip; // values of source and destination IP addresses -- to be preserved, used for IP addresses enumeration of foreground traffic
+    uint64_t e_sip, e_dip; // values of source and destination IP addresses -- to be preserved, used for IP addresses enumeration of foreground traffic
     uint16_t e_sport, e_dport; // values of source and destination port numbers -- to be preserved, used for port enumeration of foreground traffic
-    uint16_t sip, dip; // values of source and destination IP addresses -- temporary values
+    uint64_t sip, dip; // values of source and destination IP addresses -- temporary values
     uint16_t sp, dp; // values of source and destination port numbers -- temporary values
     
-    for ( i=0; i<N; i++ ) {
+    for ( i=0; i<fr.copies; i++ ) {
       // create foreground Test Frame
       if ( ip_version == 4 ) {
-        fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport);
+        fg_pkt_mbuf[i] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv4, dst_ipv4, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-        fg_src_ip[i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the 16-bits to be modified
-        fg_dst_ip[i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the 16-bits to be modified
+        fg_src_ip[i] = pkt + 26 + src_ipv4_offset;  // 14+12: source IPv4 address, the varying field to be modified
+        fg_dst_ip[i] = pkt + 30 + dst_ipv4_offset;  // 14+16: destination IPv4 address, the varying field to be modified
         fg_ipv4_chksum[i] = pkt + 24;               // 14+10: IPv4 header checksum
         fg_udp_sport[i] = pkt + 34;    // 14+20+0: source UDP port 
         fg_udp_dport[i] = pkt + 36;    // 14+20+2: destination UDP port
-        fg_udp_chksum[i] = pkt + 40;   // 14+20+6: UDP checksum 
+        fg_udp_chksum[i] = pkt + (tcp_flags ? 50 : 40);   // 14+20+16: TCP checksum, 14+20+6: UDP checksum
       } else { // IPv6
-        fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+        fg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-        fg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
-        fg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
+        fg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the varying field to be modified
+        fg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the varying field to be modified
         fg_udp_sport[i] = pkt + 54;    // 14+40+0: source UDP port
         fg_udp_dport[i] = pkt + 56;    // 14+40+2: destination UDP port
-        fg_udp_chksum[i] = pkt + 60;   // 14+40+6: UDP checksum
+        fg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);   // 14+40+16: TCP checksum, 14+40+6: UDP checksum
       }
       if ( ip_version == 4 )
         fg_ipv4_chksum_start = ~*(uint16_t *)fg_ipv4_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
       fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
       // create backround Test Frame (always IPv6)
-      bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+      bg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
       pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
-      bg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the 16-bits to be modified
-      bg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the 16-bits to be modified
+      bg_src_ip[i] = pkt + 22 + src_ipv6_offset;  // 14+8:  source IPv6 address, the varying field to be modified
+      bg_dst_ip[i] = pkt + 38 + dst_ipv6_offset;  // 14+24: destination IPv6 address, the varying field to be modified
       bg_udp_sport[i] = pkt + 54;    // 14+40+0: source UDP port
       bg_udp_dport[i] = pkt + 56;    // 14+40+2: destination UDP port
-      bg_udp_chksum[i] = pkt + 60;   // 14+40+6: UDP checksum
+      bg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);   // 14+40+16: TCP checksum, 14+40+6: UDP checksum
       bg_udp_chksum_start = *(uint16_t *)bg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
     } 
 
@@ -2890,7 +4846,7 @@ int imsend(void *par) {
           e_dport = dport_max;
           break;
         case 3:
-          if ( !uniqueFtComb )
+          if ( !uniqueFtComb && !perm )
             rte_exit(EXIT_FAILURE, "Error: Initiator/Sender received a NULL pointer to the array of pre-prepaired unique random IP addresses and port numbers!\n");
           // unique pseudorandom four tuples are guaranteed by pre-prepaired random permutation
           break;
@@ -2898,24 +4854,27 @@ int imsend(void *par) {
 
     // prepare random number infrastructure
     thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-    thread_local std::mt19937_64 gen_sip(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    thread_local std::mt19937_64 gen_dip(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<int> uni_dis_sip(sip_min, sip_max);     // uniform distribution in [sip_min, sip_max]
-    std::uniform_int_distribution<int> uni_dis_dip(dip_min, dip_max);     // uniform distribution in [dip_min, dip_max]
-    thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);	// uniform distribution in [sport_min, sport_max]
-    std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);	// uniform distribution in [sport_min, sport_max]
+    thread_local fastRandom gen_sip(rd());
+    thread_local fastRandom gen_dip(rd());
+    randomRange uni_dis_sip(sip_min, sip_max);     // uniform distribution in [sip_min, sip_max]
+    randomRange uni_dis_dip(dip_min, dip_max);     // uniform distribution in [dip_min, dip_max]
+    randomRange64 uni_dis_sip64(sip_min, sip_max);	// uniform distribution for 64-bit fields in [sip_min, sip_max]
+    randomRange64 uni_dis_dip64(dip_min, dip_max);	// uniform distribution for 64-bit fields in [dip_min, dip_max]
+    thread_local fastRandom gen_sport(rd());
+    thread_local fastRandom gen_dport(rd());
+    randomRange uni_dis_sport(sport_min, sport_max);	// uniform distribution in [sport_min, sport_max]
+    randomRange uni_dis_dport(dport_min, dport_max);	// uniform distribution in [sport_min, sport_max]
 
     // naive sender version: it is simple and fast
     i=0; // increase maunally after each sending
     for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
       // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
       if ( fg_frame = sent_frames % n  < m ) {
+        fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
         // foreground frame is to be sent
         v4_chksum = fg_ipv4_chksum_start; // rubbish, if IPv6, but a branch instruction is spared
-        ip_src = (uint16_t *)fg_src_ip[i];
-        ip_dst = (uint16_t *)fg_dst_ip[i];
+        ip_src = fg_src_ip[i];
+        ip_dst = fg_dst_ip[i];
         ipv4_chksum = (uint16_t *)fg_ipv4_chksum[i]; // rubbish, if IPv6, but a branch instruction is spared
         chksum = fg_udp_chksum_start;
         udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -2923,9 +4882,10 @@ int imsend(void *par) {
         udp_chksum = (uint16_t *)fg_udp_chksum[i];
         pkt_mbuf = fg_pkt_mbuf[i];
       } else {
+        fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
         // background frame is to be sent, it is surely IPv6
-        ip_src = (uint16_t *)bg_src_ip[i];
-        ip_dst = (uint16_t *)bg_dst_ip[i];
+        ip_src = bg_src_ip[i];
+        ip_dst = bg_dst_ip[i];
         chksum = bg_udp_chksum_start;
         udp_sport = (uint16_t *)bg_udp_sport[i];
         udp_dport = (uint16_t *)bg_udp_dport[i];
@@ -2973,15 +4933,23 @@ int imsend(void *par) {
               dp = e_dport, sip = e_sip, dip = e_dip;
             break;
           case 3: // the next unique pseudorandom IP address and port number combination is taken
-            sip = uniqueFC->ft.sip;	// read source IP address
-            dip = uniqueFC->ft.dip;	// read destination IP address
-            sp = uniqueFC->ft.sport;	// read source port number
-            dp = uniqueFC->ft.dport; 	// read destination port number
-            uniqueFC++;               	// increase pointer: no check needed, we have surely enough
+            if ( likely( !perm ) ) {
+              sip = uniqueFC->ft.sip;	// read source IP address
+              dip = uniqueFC->ft.dip;	// read destination IP address
+              sp = uniqueFC->ft.sport;	// read source port number
+              dp = uniqueFC->ft.dport; 	// read destination port number
+              uniqueFC++;               	// increase pointer: no check needed, we have surely enough
+            } else {
+              v = (*perm)();            	// wide fields: split the next element of the permutation
+              sp = nextDigit(v, sport_min, sport_max-sport_min+1);
+              dp = nextDigit(v, dport_min, dport_max-dport_min+1);
+              sip = nextDigit(v, sip_min, sip_max-sip_min+1);
+              dip = nextDigit(v, dip_min, dip_max-dip_min+1);
+            }
             break;
         } // end of switch
-        ip_chksum += *ip_src = htons(sip);  // set src IP 16-bit field and add to checksum
-        ip_chksum += *ip_dst = htons(dip);  // set dst IP 16-bit field and add to checksum
+        ip_chksum += setIpField(ip_src, sip, sip_bytes);  // set src IP field and add to checksum
+        ip_chksum += setIpField(ip_dst, dip, dip_bytes);  // set dst IP field and add to checksum
         chksum += *udp_sport = htons(sp);   // set source port and add to checksum 
         chksum += *udp_dport = htons(dp);   // set destination port and add to checksum 
       } else {
@@ -2998,9 +4966,9 @@ int imsend(void *par) {
                 src_ip = sip_max;
               break;
             case 3:                   // pseudorandom 
-              sip = uni_dis_sip(gen_sip);
+              sip = sip_bytes < 8 ? uni_dis_sip(gen_sip) : uni_dis_sip64(gen_sip);
           }
-          ip_chksum += *ip_src = htons(sip);     // set src IP 16-bit field and add to checksum
+          ip_chksum += setIpField(ip_src, sip, sip_bytes);     // set src IP field and add to checksum
         }
         if ( var_dip ) {
           // destination IP is varying
@@ -3014,9 +4982,9 @@ int imsend(void *par) {
                 dst_ip = dip_max;
               break;
             case 3:                           // pseudorandom
-              dip = uni_dis_dip(gen_dip);
+              dip = dip_bytes < 8 ? uni_dis_dip(gen_dip) : uni_dis_dip64(gen_dip);
           }
-          ip_chksum += *ip_dst = htons(dip);     // set dst IP 16-bit field and add to checksum
+          ip_chksum += setIpField(ip_dst, dip, dip_bytes);     // set dst IP field and add to checksum
         }
         if ( var_sport ) {
           // sport is varying
@@ -3068,27 +5036,26 @@ int imsend(void *par) {
         chksum = 0xffff;
       *udp_chksum = (uint16_t) chksum;            // set checksum in the frame
       // finally, when its time is here, send the frame
-      while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); 	// Beware: an "empty" loop, as well as in the next line
-      while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) ); 		// send out the frame
-      i = (i+1) % N;
+      lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+      fr.send(pkt_mbuf); 		// send out the frame
+      i = (i+1) % fr.copies;
     } // this is the end of the sending cycle
 
   } // end of implementation of varying port numbers 
   // Now, we check the time
   uint64_t elapsed_tsc = rte_rdtsc()-start_tsc;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, (double)elapsed_tsc/hz);
+  late = lateness.report(side, hz, cp->max_lateness);
   // this is a preliminary test, 'duration' is not valid
   if ( elapsed_tsc > hz*frames_to_send/frame_rate*TOLERANCE )
     printf("Warning: %s sending was too slow (only %3.10lf percent of required rate), the test is invalid.\n", side,
              100.0*frames_to_send/elapsed_tsc*hz/frame_rate);
-  else
+  else if ( !late )
     printf("%s frames sent: %lu\n", side, sent_frames);
 
-  if ( uniqueIpComb )
-    rte_free(uniqueIpComb);   // free the array for pre-generated unique IP address combinations
-  if ( uniqueFtComb )
-    rte_free(uniqueFtComb);   // free the array for pre-generated unique 4-tuple combinations
-  return 0;
+  // the arrays of pre-generated unique combinations are not freed: they are reused by the steps of the searches and calibration
+  delete perm;
+  return elapsed_tsc > hz*frames_to_send/frame_rate*TOLERANCE || late; // non-zero, if the sending was too slow (used by the self-calibration)
 
 }
 // Responder/Sender: sends Test Frames for throughput (or frame loss rate) measurement
@@ -3106,6 +5073,7 @@ int rsend(void *par) {
   uint32_t m = cp->m;
   uint64_t hz = cp->hz;
   uint64_t start_tsc = cp->start_tsc;
+  uint8_t tcp_flags = cp->tcp_flags;
 
   // parameters which are different for the Left sender and the Right sender
   int ip_version = p->ip_version;
@@ -3114,7 +5082,7 @@ int rsend(void *par) {
   const char *side = p->side;
   struct ether_addr *dst_mac = p->dst_mac;
   struct ether_addr *src_mac = p->src_mac;
-  uint16_t num_dest_nets = p->num_dest_nets;
+  uint32_t num_dest_nets = p->num_dest_nets;
   uint32_t *src_ipv4 = p->src_ipv4;
   uint32_t *dst_ipv4 = p->dst_ipv4;
   struct in6_addr *src_ipv6 = p->src_ipv6;
@@ -3136,6 +5104,8 @@ int rsend(void *par) {
   // further local variables
   uint64_t frames_to_send = duration * frame_rate;	// Each active sender sends this number of frames
   uint64_t sent_frames=0; // counts the number of sent frames
+  latenessHistogram lateness(side, eth_id); // lateness of the frames relative to their scheduled sending times
+  int late; // non-zero, if a frame was sent later than allowed
   double elapsed_seconds; // for checking the elapsed seconds during sending
 
   unsigned index;   	// current state table index for reading a 4-tuple (used when 'responder-ports' is 1 or 2)
@@ -3151,16 +5121,16 @@ int rsend(void *par) {
       struct rte_mbuf *fg_pkt_mbuf, *bg_pkt_mbuf; // message buffers for fg. and bg. Test Frames
       // create foreground Test Frame
       if ( ip_version == 4 )
-        fg_pkt_mbuf = mkFinalTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, ntohs(ft.resp_port), ntohs(ft.init_port));
+        fg_pkt_mbuf = mkFinalTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, ntohs(ft.resp_port), ntohs(ft.init_port), tcp_flags);
       else  // IPv6 -- stateful operation is not yet supported!
-        fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0);
+        fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0, tcp_flags);
   
       // create backround Test Frame (always IPv6)
-      bg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0);
+      bg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0, tcp_flags);
   
       // naive sender version: it is simple and fast
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further two will come!
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
         if ( sent_frames % n  < m )
           while ( !rte_eth_tx_burst(eth_id, 0, &fg_pkt_mbuf, 1) ); // send foreground frame
         else
@@ -3170,45 +5140,56 @@ int rsend(void *par) {
     else {
       // optimized code for multiple destination networks -- only regarding background traffic! 
       // always the same foreground frame is sent!
-      // background frames are generated for each network and pointers are stored in arrays
-      // assertion: num_dest_nets <= 256 
-      struct rte_mbuf *fg_pkt_mbuf, *bg_pkt_mbuf[256]; // message buffers for fg. and bg. Test Frames
-      in6_addr curr_dst_bg; 	// backround IPv6 destination address, which will be changed
-      int i; 			// cycle variable for grenerating different destination network addresses
+      // the same background frame is used for each network, its destination address field carrying the network and its checksum
+      // are set from a compact table (see send()), the frame exists in several copies to resolve the write after send problem
+      int j; // cycle variable to index the copies: takes {0..fr.copies-1} values
+      frameReuse fr(eth_id, side); // the copies of the background frame are reused safely
+      struct rte_mbuf *fg_pkt_mbuf, *bg_pkt_mbuf[N], *pkt_mbuf; // message buffers for fg. and bg. Test Frames
+      uint8_t *pkt; // working pointer to the current frame (in the message buffer)
+      uint8_t *bg_dst[N], *bg_chksum[N]; // pointers to the given fields
+      destNetFields *nets, *net; // fields of the background frame for each destination network, and working pointer to the current one
 
-      curr_dst_bg = *dst_bg;
-  
       // create foreground Test Frame
       if ( ip_version == 4 ) {
-        fg_pkt_mbuf = mkFinalTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, ntohs(ft.resp_port), ntohs(ft.init_port));
+        fg_pkt_mbuf = mkFinalTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ft.resp_addr, &ft.init_addr, ntohs(ft.resp_port), ntohs(ft.init_port), tcp_flags);
       }
       else { // IPv6 -- stateful operation is not yet supported!
-        fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0);
+        fg_pkt_mbuf = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, 0, 0, tcp_flags);
       } 
 
-      for ( i=0; i<num_dest_nets; i++ ) { 
-        // create backround Test Frames (always IPv6)
-        ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, 0, 0);
+      for ( j=0; j<fr.copies; j++ ) {
+        // create backround Test Frame (always IPv6)
+        bg_pkt_mbuf[j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, 0, 0, tcp_flags));
+        pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
+        bg_dst[j] = pkt + 44;
+        bg_chksum[j] = pkt + (tcp_flags ? 70 : 60);
       }
+      nets = mkDestNets(bg_pkt_mbuf[0], bg_pkt_mbuf[0], 6, num_dest_nets, 0, tcp_flags, side); // only the background fields are used
    
       // random number infrastructure is taken from: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      // MT64 is used because of https://medium.com/@odarbelaeze/how-competitive-are-c-standard-random-number-generators-f3de98d973f0
       // thread_local is used on the basis of https://stackoverflow.com/questions/40655814/is-mersenne-twister-thread-safe-for-cpp
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engine
-      thread_local std::mt19937_64 gen(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);	// uniform distribution in [0, num_dest_nets-1]
+      thread_local fastRandom gen(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);	// uniform distribution in [0, num_dest_nets-1]
   
       // naive sender version: it is simple and fast
+      j=0; // increase maunally after each sending of a background frame
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); // Beware: an "empty" loop, and further two will come!
-        if ( sent_frames % n  < m )
+        if ( sent_frames % n  < m ) {
+          lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
           while ( !rte_eth_tx_burst(eth_id, 0, &fg_pkt_mbuf, 1) ); // send foreground frame
-        else {
-          int net_index = uni_dis_net(gen);	// index of the pre-generated frame
-          while ( !rte_eth_tx_burst(eth_id, 0, &bg_pkt_mbuf[net_index], 1) ); // send background frame
+        } else {
+          net = nets + uni_dis_net(gen);	// fields of the randomly chosen destination network
+          pkt_mbuf = bg_pkt_mbuf[j];
+          fr.wait(pkt_mbuf); // its previous transmission must be completed
+          *(uint16_t *)bg_dst[j] = net->bg_dst;
+          *(uint16_t *)bg_chksum[j] = net->bg_chksum;
+          lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+          fr.send(pkt_mbuf);           // send out background frame
+          j = (j+1) % fr.copies;
 	}
       } // this is the end of the sending cycle
+      rte_free(nets);
     } // end of optimized code for multiple destination networks
   } // end of optimized code for fixed port numbers
   else {
@@ -3228,6 +5209,7 @@ int rsend(void *par) {
       // N size arrays are used to resolve the write after send problem.
       // IPv4 addresses, source and/or destination port number(s) and UDP checksum are updated in the actually used copy.
       int i; // cycle variable for the above mentioned purpose: takes {0..N-1} values
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
       struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N], *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N]; // pointers to the given fields
@@ -3240,11 +5222,11 @@ int rsend(void *par) {
       uint16_t sport, dport; // values of source and destination port numbers -- to be preserved, when increase or decrease is done 
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
       
-      for ( i=0; i<N; i++ ) {
+      for ( i=0; i<fr.copies; i++ ) {
         // create foreground Test Frame
         if ( ip_version == 4 ) {
 	  // All IPv4 addresses and port numbers are set to 0.
-          fg_pkt_mbuf[i] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1, tcp_flags));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
 	  fg_rte_ipv4_hdr[i] = pkt + 14;
           fg_ipv4_chksum[i] = pkt + 24;
@@ -3252,21 +5234,21 @@ int rsend(void *par) {
           fg_ipv4_dst[i] = pkt + 30;
           fg_udp_sport[i] = pkt + 34;
           fg_udp_dport[i] = pkt + 36;
-          fg_udp_chksum[i] = pkt + 40;
+          fg_udp_chksum[i] = pkt + (tcp_flags ? 50 : 40);
         } else { // IPv6 -- stateful operation is not yet supported!
-          fg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+          fg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[i] = pkt + 54;
           fg_udp_dport[i] = pkt + 56;
-          fg_udp_chksum[i] = pkt + 60;
+          fg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);
         }
         fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i") 
         // create backround Test Frame (always IPv6)
-        bg_pkt_mbuf[i] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport);
+        bg_pkt_mbuf[i] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
         pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i], uint8_t *); // Access the Test Frame in the message buffer
         bg_udp_sport[i] = pkt + 54;
         bg_udp_dport[i] = pkt  + 56;
-        bg_udp_chksum[i] = pkt + 60;
+        bg_udp_chksum[i] = pkt + (tcp_flags ? 70 : 60);
         bg_udp_chksum_start = *(uint16_t *)bg_udp_chksum[i]; // save the uncomplemented checksum value (same for all values of "i")
       } 
 
@@ -3282,18 +5264,19 @@ int rsend(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_index(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);	// uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);	// uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<unsigned> uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      thread_local fastRandom gen_index(rd());
+      popularityDistribution uni_dis_sport(sport_min, sport_max, var_sport == 3 ? cp->popularity : 0);	// uniform or skewed distribution in [sport_min, sport_max]
+      popularityDistribution uni_dis_dport(dport_min, dport_max, var_dport == 3 ? cp->popularity : 0);	// uniform or skewed distribution in [sport_min, sport_max]
+      popularityDistribution uni_dis_index(0, state_table_size-1, responder_tuples == 3 ? cp->popularity : 0); // uniform or skewed distribution in [0, state_table_size-1]
 
       // naive sender version: it is simple and fast
       i=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[i]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start;
           udp_sport = (uint16_t *)fg_udp_sport[i];
@@ -3305,6 +5288,7 @@ int rsend(void *par) {
 	  ipv4_dst = (uint32_t *)fg_ipv4_dst[i];	// this is rubbish if IP version is 6 
           pkt_mbuf = fg_pkt_mbuf[i];
         } else {
+          fr.wait(bg_pkt_mbuf[i]); // its previous transmission must be completed
           // background frame is to be sent
           chksum = bg_udp_chksum_start;
           udp_sport = (uint16_t *)bg_udp_sport[i];
@@ -3393,40 +5377,37 @@ int rsend(void *par) {
 	}
 
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate ); 	// Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) ); 		// send out the frame
-        i = (i+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf); 		// send out the frame
+        i = (i+1) % fr.copies;
       } // this is the end of the sending cycle
     } // end of optimized code for single destination network
     else { 
       // optimized code for multiple destination networks:
-      // N copies of foreground frames are prepared, and N cpopies of background frames for each destination network are prepared,
-      // N size arrays are used to resolve the write after send problem
-      // IPv4 addresses, source and/or destination port number(s) and UDP checksum are updated in the actually used copy before sending
-      // assertion: num_dest_nets <= 256
+      // N copies of foreground frames and N copies of background frames are prepared, N size arrays are used to resolve the write after send problem
+      // IPv4 addresses, source and/or destination port number(s) and UDP checksum are updated in the actually used copy before sending,
+      // the destination network of a background frame is set from a compact table (see send())
       int j; // cycle variable to index the N size array: takes {0..N-1} values
-      struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[256][N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
+      frameReuse fr(eth_id, side); // the copies of the frames are reused safely
+      struct rte_mbuf *fg_pkt_mbuf[N], *bg_pkt_mbuf[N], *pkt_mbuf; // pointers of message buffers for fg. and bg. Test Frames
       uint8_t *pkt; // working pointer to the current frame (in the message buffer)
       uint8_t *fg_udp_sport[N], *fg_udp_dport[N], *fg_udp_chksum[N]; // pointers to the given fields of the pre-prepared Test Frames
-      uint8_t *bg_udp_sport[256][N], *bg_udp_dport[256][N], *bg_udp_chksum[256][N]; // pointers to the given fields of the pre-prepared Test Frames
+      uint8_t *bg_udp_sport[N], *bg_udp_dport[N], *bg_udp_chksum[N], *bg_dst[N]; // pointers to the given fields of the pre-prepared Test Frames
       uint8_t *fg_rte_ipv4_hdr[N], *fg_ipv4_chksum[N], *fg_ipv4_src[N], *fg_ipv4_dst[N]; // further ones for stateful tests, but not per dest. networks!
       rte_ipv4_hdr *rte_ipv4_hdr_start; // used for IPv4 header checksum calculation
       uint16_t *udp_sport, *udp_dport, *udp_chksum, *ipv4_chksum; // working pointers to the given fields
       uint32_t *ipv4_src, *ipv4_dst; // further ones for stateful tests
-      uint16_t fg_udp_chksum_start, bg_udp_chksum_start[256];  // starting values (uncomplemented checksums taken from the original frames)
+      uint16_t fg_udp_chksum_start;  // starting value (uncomplemented checksum taken from the original frame)
       uint32_t chksum; // temporary variable for checksum calculation
       uint16_t sport, dport; // values of source and destination port numbers -- to be preserved, when increase or decrease is done
       uint16_t sp, dp; // values of source and destination port numbers -- temporary values
-      in6_addr curr_dst_bg;       // backround IPv6 destination address, which will be changed
-      int i;                      // cycle variable for grenerating different destination network addresses
- 
-      curr_dst_bg = *dst_bg;
+      destNetFields *nets, *net; // fields of the background frame for each destination network, and working pointer to the current one
 
       // create Test Frames
-      for ( j=0; j<N; j++ ) {
+      for ( j=0; j<fr.copies; j++ ) {
         // create foreground Test Frame (IPv4 or IPv6)
         if ( ip_version == 4 ) {
-          fg_pkt_mbuf[j] = mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1);
+          fg_pkt_mbuf[j] = fr.add(mkTestFrame4(ipv4_frame_size, pkt_pool, side, dst_mac, src_mac, &ipv4_zero, &ipv4_zero, 1, 1, tcp_flags));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
           fg_rte_ipv4_hdr[j] = pkt + 14;
           fg_ipv4_chksum[j] = pkt + 24;
@@ -3434,27 +5415,26 @@ int rsend(void *par) {
           fg_ipv4_dst[j] = pkt + 30;
           fg_udp_sport[j] = pkt + 34;
           fg_udp_dport[j] = pkt + 36;
-          fg_udp_chksum[j] = pkt + 40;
+          fg_udp_chksum[j] = pkt + (tcp_flags ? 50 : 40);
         } else { // IPv6 -- stateful operation is not yet supported!
-          fg_pkt_mbuf[j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport);
+          fg_pkt_mbuf[j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_ipv6, dst_ipv6, var_sport, var_dport, tcp_flags));
           pkt = rte_pktmbuf_mtod(fg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
           fg_udp_sport[j] = pkt + 54;
           fg_udp_dport[j] = pkt + 56;
-          fg_udp_chksum[j] = pkt + 60;
+          fg_udp_chksum[j] = pkt + (tcp_flags ? 70 : 60);
         }
         fg_udp_chksum_start = *(uint16_t *)fg_udp_chksum[j]; // save the uncomplemented checksum value (same for all values of "j")
 
-        // create backround Test Frames for all destination networks (always IPv6)
-        for ( i=0; i<num_dest_nets; i++ ) {
-          ((uint8_t *)&curr_dst_bg)[7] = (uint8_t) i; // see comment above
-          bg_pkt_mbuf[i][j] = mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, &curr_dst_bg, var_sport, var_dport);
-          pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[i][j], uint8_t *); // Access the Test Frame in the message buffer
-          bg_udp_sport[i][j] = pkt + 54;
-          bg_udp_dport[i][j] = pkt  + 56;
-          bg_udp_chksum[i][j] = pkt + 60;
-          bg_udp_chksum_start[i] = *(uint16_t *)bg_udp_chksum[i][j]; // save the uncomplemented checksum value (same for all values of "j")
-        }
+        // create backround Test Frame (always IPv6)
+        bg_pkt_mbuf[j] = fr.add(mkTestFrame6(ipv6_frame_size, pkt_pool, side, dst_mac, src_mac, src_bg, dst_bg, var_sport, var_dport, tcp_flags));
+        pkt = rte_pktmbuf_mtod(bg_pkt_mbuf[j], uint8_t *); // Access the Test Frame in the message buffer
+        bg_dst[j] = pkt + 44;
+        bg_udp_sport[j] = pkt + 54;
+        bg_udp_dport[j] = pkt  + 56;
+        bg_udp_chksum[j] = pkt + (tcp_flags ? 70 : 60);
       }
+      // the starting values of the checksums of the background frame are taken from the table
+      nets = mkDestNets(bg_pkt_mbuf[0], bg_pkt_mbuf[0], 6, num_dest_nets, varport, tcp_flags, side); // only the background fields are used
 
       // set the starting values of port numbers, if they are increased or decreased
       if ( var_sport == 1 )
@@ -3468,20 +5448,21 @@ int rsend(void *par) {
 
       // prepare random number infrastructure
       thread_local std::random_device rd;  // Will be used to obtain a seed for the random number engines
-      thread_local std::mt19937_64 gen_net(rd()); //Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_sport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_dport(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      thread_local std::mt19937_64 gen_index(rd()); // Standard 64-bit mersenne_twister_engine seeded with rd()
-      std::uniform_int_distribution<int> uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
-      std::uniform_int_distribution<int> uni_dis_sport(sport_min, sport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<int> uni_dis_dport(dport_min, dport_max);   // uniform distribution in [sport_min, sport_max]
-      std::uniform_int_distribution<unsigned> uni_dis_index(0, state_table_size-1); // uniform distribution in [0, state_table_size-1]
+      thread_local fastRandom gen_net(rd());
+      thread_local fastRandom gen_sport(rd());
+      thread_local fastRandom gen_dport(rd());
+      thread_local fastRandom gen_index(rd());
+      randomRange uni_dis_net(0, num_dest_nets-1);     // uniform distribution in [0, num_dest_nets-1]
+      popularityDistribution uni_dis_sport(sport_min, sport_max, var_sport == 3 ? cp->popularity : 0);   // uniform or skewed distribution in [sport_min, sport_max]
+      popularityDistribution uni_dis_dport(dport_min, dport_max, var_dport == 3 ? cp->popularity : 0);   // uniform or skewed distribution in [sport_min, sport_max]
+      popularityDistribution uni_dis_index(0, state_table_size-1, responder_tuples == 3 ? cp->popularity : 0); // uniform or skewed distribution in [0, state_table_size-1]
 
       // naive sender version: it is simple and fast
       j=0; // increase maunally after each sending
       for ( sent_frames = 0; sent_frames < frames_to_send; sent_frames++ ){ // Main cycle for the number of frames to send
         // set the temporary variables (including several pointers) to handle the right pre-generated Test Frame
         if ( fg_frame = sent_frames % n  < m ) {
+          fr.wait(fg_pkt_mbuf[j]); // its previous transmission must be completed
           // foreground frame is to be sent
           chksum = fg_udp_chksum_start;
           udp_sport = (uint16_t *)fg_udp_sport[j];
@@ -3494,12 +5475,14 @@ int rsend(void *par) {
           pkt_mbuf = fg_pkt_mbuf[j];
         } else {
           // background frame is to be sent
-          int net_index = uni_dis_net(gen_net); // index of the pre-generated Test Frame for the given destination network
-          chksum = bg_udp_chksum_start[net_index];
-          udp_sport = (uint16_t *)bg_udp_sport[net_index][j];
-          udp_dport = (uint16_t *)bg_udp_dport[net_index][j];
-          udp_chksum = (uint16_t *)bg_udp_chksum[net_index][j];
-          pkt_mbuf = bg_pkt_mbuf[net_index][j];
+          net = nets + uni_dis_net(gen_net); // fields of the randomly chosen destination network
+          fr.wait(bg_pkt_mbuf[j]); // its previous transmission must be completed
+          *(uint16_t *)bg_dst[j] = net->bg_dst;
+          chksum = net->bg_chksum;
+          udp_sport = (uint16_t *)bg_udp_sport[j];
+          udp_dport = (uint16_t *)bg_udp_dport[j];
+          udp_chksum = (uint16_t *)bg_udp_chksum[j];
+          pkt_mbuf = bg_pkt_mbuf[j];
         }
         ipv4_frame = ip_version == 4 && fg_frame; // precalculated to have it ready when needed
 
@@ -3582,29 +5565,27 @@ int rsend(void *par) {
 	}
 
         // finally, when its time is here, send the frame
-        while ( rte_rdtsc() < start_tsc+sent_frames*hz/frame_rate );    // Beware: an "empty" loop, as well as in the next line
-        while ( !rte_eth_tx_burst(eth_id, 0, &pkt_mbuf, 1) );           // send out the frame
-        j = (j+1) % N;
+        lateness.wait(start_tsc+sent_frames*hz/frame_rate); // busy waiting for the sending time of the frame
+        fr.send(pkt_mbuf);           // send out the frame
+        j = (j+1) % fr.copies;
       } // this is the end of the sending cycle
+      rte_free(nets);
     } // end of the optimized code for multiple destination networks
   } // end of implementation of varying port numbers 
 
   // Now, we check the time
   elapsed_seconds = (double)(rte_rdtsc()-start_tsc)/hz;
   printf("Info: %s sender's sending took %3.10lf seconds.\n", side, elapsed_seconds);
+  late = lateness.report(side, hz, cp->max_lateness);
   if ( elapsed_seconds > duration*TOLERANCE )
     printf("Warning: %s sending exceeded the %3.10lf seconds limit, the test is invalid.\n", side, duration*TOLERANCE);
-  else
+  else if ( !late )
     printf("%s frames sent: %lu\n", side, sent_frames);
 
-  return 0;
+  return elapsed_seconds > duration*TOLERANCE || late; // non-zero, if the sending was too slow (used by the self-calibration)
 }
 
-// receives Test Frames for throughput (or frame loss rate) measurements
-// Offsets from the start of the Ethernet Frame:
-// EtherType: 6+6=12
-// IPv6 Next header: 14+6=20, UDP Data for IPv6: 14+40+8=62
-// IPv4 Protolcol: 14+9=23, UDP Data for IPv4: 14+20+8=42
+// receives Test Frames for throughput (or frame loss rate) measurements (the Test Frames are recognized by isTestFrame())
 int receive(void *par) {
   // collecting input parameters:
   class receiverParameters *p = (class receiverParameters *)par;
@@ -3615,29 +5596,147 @@ int receive(void *par) {
   // further local variables
   int frames, i;
   struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of received frames
-  uint16_t ipv4=htons(0x0800); // EtherType for IPv4 in Network Byte Order
-  uint16_t ipv6=htons(0x86DD); // EtherType for IPv6 in Network Byte Order
-  uint8_t identify[8]= { 'I', 'D', 'E', 'N', 'T', 'I', 'F', 'Y' };	// Identificion of the Test Frames
-  uint64_t *id=(uint64_t *) identify;
   uint64_t received=0; 	// number of received frames
 
-  while ( rte_rdtsc() < finish_receiving ){
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
     frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
+    polls.count(frames, poll_tsc);
     for (i=0; i < frames; i++){
-      uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the Test Frame in the message buffer
-      // check EtherType at offset 12: IPv6, IPv4, or anything else
-      if ( *(uint16_t *)&pkt[12]==ipv6 ) { /* IPv6  */
-        /* check if IPv6 Next Header is UDP, and the first 8 bytes of UDP data is 'IDENTIFY' */
-        if ( likely( pkt[20]==17 && *(uint64_t *)&pkt[62]==*id ) )
+      if ( likely( isTestFrame(rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *)) ) ) // Access the Test Frame in the message buffer
+        received++;
+      rte_pktmbuf_free(pkt_mbufs[i]);
+    }
+  }
+  polls.report(side);
+  printf("%s frames received: %lu\n", side, received);
+  p->received = received;
+  return received;
+}
+
+// like receive(), but the received test frames are also counted for each IMIX frame size class
+// the class is identified by the frame size: IPv4 frames are 20 bytes shorter than the IPv6 frames of the same class
+int receiveImix(void *par) {
+  // collecting input parameters:
+  class receiverParametersImix *p = (class receiverParametersImix *)par;
+  uint64_t finish_receiving = p->finish_receiving;
+  uint16_t eth_id = p->eth_id;
+  const char *side = p->side;
+  const uint8_t *class_of = p->imix->class_of;
+
+  // further local variables
+  int frames, i;
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of received frames
+  uint16_t ipv4=htons(0x0800); // EtherType for IPv4 in Network Byte Order
+  uint16_t ipv6=htons(0x86DD); // EtherType for IPv6 in Network Byte Order
+  uint8_t identify[8]= { 'I', 'D', 'E', 'N', 'T', 'I', 'F', 'Y' };	// Identificion of the Test Frames
+  uint64_t *id=(uint64_t *) identify;
+  uint64_t received=0; 	// number of received frames
+  uint64_t class_received[IMIX_MAX_SIZES+1] = {0}; // number of received frames of each class (the last one: unknown size)
+  unsigned size; // the size of the IPv6 frames of the class of the received frame (including FCS)
+
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
+    frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
+    polls.count(frames, poll_tsc);
+    for (i=0; i < frames; i++){
+      uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the Test Frame in the message buffer
+      size = pkt_mbufs[i]->pkt_len + RTE_ETHER_CRC_LEN;
+      // check EtherType at offset 12: IPv6, IPv4, or anything else
+      if ( *(uint16_t *)&pkt[12]==ipv6 ) { /* IPv6  */
+        /* check if IPv6 Next Header is UDP, and the first 8 bytes of UDP data is 'IDENTIFY' */
+        if ( likely( pkt[20]==17 && *(uint64_t *)&pkt[62]==*id ) ) {
           received++;
+          class_received[size <= MAX_FRAME_SIZE+20 ? class_of[size] : IMIX_MAX_SIZES]++;
+        }
       } else if ( *(uint16_t *)&pkt[12]==ipv4 ) { /* IPv4 */
-        if ( likely( pkt[23]==17 && *(uint64_t *)&pkt[42]==*id ) )
-           received++;
+        if ( likely( pkt[23]==17 && *(uint64_t *)&pkt[42]==*id ) ) {
+          received++;
+          size += 20;
+          class_received[size <= MAX_FRAME_SIZE+20 ? class_of[size] : IMIX_MAX_SIZES]++;
+        }
+      }
+      rte_pktmbuf_free(pkt_mbufs[i]);
+    }
+  }
+  polls.report(side);
+  printf("%s frames received: %lu\n", side, received);
+  for ( unsigned j=0; j<p->imix->sizes; j++ ) {
+    printf("%s frames received of size %u: %lu\n", side, p->imix->size[j], class_received[j]);
+    p->class_received[j] = class_received[j];
+  }
+  if ( class_received[IMIX_MAX_SIZES] )
+    printf("Warning: %s received %lu test frames of unexpected size.\n", side, class_received[IMIX_MAX_SIZES]);
+  p->received = received;
+  return received;
+}
+
+// like receive(), but the received test frames are also counted for each destination network
+// the network is identified by the 16-bit field of the destination address set by send() (see destNetFields):
+// bytes 1-2 of the IPv4 destination address (offset 14+16+1=31), or bytes 6-7 of the IPv6 destination address (offset 14+24+6=44)
+// the offset of the field from that of network 0 is mapped to the network index by a lookup table (no branches),
+// values out of range are counted separately; only the entries of the used networks are touched, thus they stay cache-resident
+int receiveNets(void *par) {
+  // collecting input parameters:
+  class receiverParametersNets *p = (class receiverParametersNets *)par;
+  uint64_t finish_receiving = p->finish_receiving;
+  uint16_t eth_id = p->eth_id;
+  const char *side = p->side;
+  uint32_t num_nets = p->num_nets;
+  uint16_t ipv4_dst = p->ipv4_dst;
+  uint16_t ipv6_dst = p->ipv6_dst;
+
+  // further local variables
+  int frames, i;
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of received frames
+  uint16_t ipv4=htons(0x0800); // EtherType for IPv4 in Network Byte Order
+  uint16_t ipv6=htons(0x86DD); // EtherType for IPv6 in Network Byte Order
+  uint8_t identify[8]= { 'I', 'D', 'E', 'N', 'T', 'I', 'F', 'Y' };	// Identificion of the Test Frames
+  uint64_t *id=(uint64_t *) identify;
+  uint64_t received=0; 	// number of received frames
+  uint64_t *net_received;	// number of received frames of each network (the last one: unknown network)
+  uint32_t *net_of;	// network index of each offset of the 16-bit field (num_nets for the offsets out of range)
+
+  // the tables are allocated from the memory of the NUMA node of the receiver
+  net_received = (uint64_t *) rte_zmalloc("Receiver's per network counters", sizeof(uint64_t)*(num_nets+1), 64);
+  net_of = (uint32_t *) rte_malloc("Receiver's network lookup table", sizeof(uint32_t)*65536, 64);
+  if ( !net_received || !net_of )
+    rte_exit(EXIT_FAILURE, "Error: %s receiver can't allocate memory for the per network counters!\n", side);
+  for ( uint32_t j=0; j<65536; j++ )
+    net_of[j] = j < num_nets ? j : num_nets;
+
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
+    frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
+    polls.count(frames, poll_tsc);
+    for (i=0; i < frames; i++){
+      uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the Test Frame in the message buffer
+      // check EtherType at offset 12: IPv6, IPv4, or anything else
+      if ( *(uint16_t *)&pkt[12]==ipv6 ) { /* IPv6  */
+        /* check if IPv6 Next Header is UDP, and the first 8 bytes of UDP data is 'IDENTIFY' */
+        if ( likely( pkt[20]==17 && *(uint64_t *)&pkt[62]==*id ) ) {
+          received++;
+          net_received[net_of[(uint16_t)((pkt[44]<<8 | pkt[45]) - ipv6_dst)]]++;
+        }
+      } else if ( *(uint16_t *)&pkt[12]==ipv4 ) { /* IPv4 */
+        if ( likely( pkt[23]==17 && *(uint64_t *)&pkt[42]==*id ) ) {
+          received++;
+          net_received[net_of[(uint16_t)((pkt[31]<<8 | pkt[32]) - ipv4_dst)]]++;
+        }
       }
       rte_pktmbuf_free(pkt_mbufs[i]);
     }
   }
+  polls.report(side);
   printf("%s frames received: %lu\n", side, received);
+  if ( net_received[num_nets] )
+    printf("Warning: %s received %lu test frames to unexpected destination networks.\n", side, net_received[num_nets]);
+  rte_free(net_of);
+  p->net_received = net_received; // per network counters are reported and released by measure() together with the sent ones
+  p->received = received;
   return received;
 }
 
@@ -3646,6 +5745,7 @@ int receive(void *par) {
 // EtherType: 6+6=12
 // IPv6 Next header: 14+6=20, UDP Data for IPv6: 14+40+8=62
 // IPv4 Protocol: 14+9=23, UDP Data for IPv4: 14+20+8=42
+// TCP Data (stateful tests with 'TCP 1'): 14+40+20=74 for IPv6, 14+20+20=54 for IPv4
 int rreceive(void *par) {
   // collecting input parameters:
   class rReceiverParameters *p = (class rReceiverParameters *)par;
@@ -3681,30 +5781,37 @@ int rreceive(void *par) {
   }
 
   // frames are received and their four tuples are recorded
-  while ( rte_rdtsc() < finish_receiving ){
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  polls.lc->state_entries.store(*valid_entries, std::memory_order_relaxed); // 0 in the preliminary phase
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
     frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
+    polls.count(frames, poll_tsc);
     for (i=0; i < frames; i++){
       uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the Test Frame in the message buffer
       // check EtherType at offset 12: IPv6, IPv4, or anything else
       if ( *(uint16_t *)&pkt[12]==ipv6 ) { /* IPv6  */
-        /* check if IPv6 Next Header is UDP, and the first 8 bytes of UDP data is 'IDENTIFY' */
-        if ( likely( pkt[20]==17 && *(uint64_t *)&pkt[62]==*id ) )
+        /* check if IPv6 Next Header is UDP (or TCP), and the first 8 bytes of UDP (or TCP) data is 'IDENTIFY' */
+        if ( likely( pkt[20]==17 && *(uint64_t *)&pkt[62]==*id || pkt[20]==6 && *(uint64_t *)&pkt[74]==*id ) )
           bg_received++;	// it is considered a background frame: we do not deal with it any more
       } else if ( *(uint16_t *)&pkt[12]==ipv4 ) { /* IPv4 */
-        if ( likely( pkt[23]==17 && *(uint64_t *)&pkt[42]==*id ) ) {
+        if ( likely( pkt[23]==17 && *(uint64_t *)&pkt[42]==*id || pkt[23]==6 && *(uint64_t *)&pkt[54]==*id ) ) {
           fg_received++;	// it is considered a freground frame: we must learn its 4-tuple
           // copy IPv4 fields to the four_tuple -- without using conversion from network byte order to host byte order
           four_tuple.init_addr = *(uint32_t *)&pkt[26]; 	// 14+12: source IPv4 address
           four_tuple.resp_addr = *(uint32_t *)&pkt[30]; 	// 14+16: destination IPv4 address
-          four_tuple.init_port = *(uint16_t *)&pkt[34]; 	// 14+20: source UDP port
-          four_tuple.resp_port = *(uint16_t *)&pkt[36]; 	// 14+22: destination UDP port
+          four_tuple.init_port = *(uint16_t *)&pkt[34]; 	// 14+20: source UDP (or TCP) port
+          four_tuple.resp_port = *(uint16_t *)&pkt[36]; 	// 14+22: destination UDP (or TCP) port
 	  stTbl[index] = four_tuple; 				// atomic write
 	  index = ++index % state_table_size;			// maintain write pointer
         }
       }
       rte_pktmbuf_free(pkt_mbufs[i]);
     }
+    if ( !*valid_entries ) // preliminary phase: the state table is being filled
+      polls.lc->state_entries.store(fg_received < state_table_size ? fg_received : state_table_size, std::memory_order_relaxed);
   }
+  polls.report(side);
   printf("%s frames received: %lu\n", side, fg_received+bg_received);
   if ( !*valid_entries ) {
     // This one was a preliminary test, the number of valid entries should be reported
@@ -3713,128 +5820,249 @@ int rreceive(void *par) {
   return fg_received+bg_received;
 }
 
-// performs throughput (or frame loss rate) measurement
-void Throughput::measure(uint16_t leftport, uint16_t rightport) {
-  time_t now; // needed for printing out a timestamp in Info message
-
-  // Several parameters are provided to the various sender functions (send, isend, msend, imsend) 
-  // and receiver functions (receive, ) in the following 'struct'-s.
-  // They are declared here so that they will not be overwritten in the stack when the program leaves an 'if' block.
-  senderCommonParameters scp1, scp2;
-  senderParameters spars1, spars2; 
-  iSenderParameters ispars;
-  mSenderParameters mspars1, mspars2;
-  imSenderParameters imspars;
-  receiverParameters rpars1, rpars2;
-  rReceiverParameters rrpars1, rrpars2;
-  rSenderParameters rspars;
-
-  switch ( stateful ) {
-    case 0:	// stateless test is to be performed
-      {
-
-      // set common parameters for senders
-      scp1=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc);
+// Responder/Receiver in echo mode: receives Preliminary or Test Frames like rreceive, 
+// and in the test phase, it also turns each foreground frame into an echo reply to its own 4-tuple:
+// MAC addresses, IPv4 addresses and UDP port numbers are swapped in place (the checksums remain valid),
+// and the reply is passed to the Responder/Sender (rsendEcho) through an rte_ring.
+// Offsets from the start of the Ethernet Frame:
+// EtherType: 6+6=12
+// IPv6 Next header: 14+6=20, UDP Data for IPv6: 14+40+8=62
+// IPv4 Protocol: 14+9=23, UDP Data for IPv4: 14+20+8=42
+int rreceiveEcho(void *par) {
+  // collecting input parameters:
+  class rReceiverParametersEcho *p = (class rReceiverParametersEcho *)par;
+  uint64_t finish_receiving = p->finish_receiving;
+  uint16_t eth_id = p->eth_id;
+  const char *side = p->side;
+  unsigned state_table_size = p->state_table_size;
+  unsigned *valid_entries = p->valid_entries;
+  atomicFourTuple **stateTable = p->stateTable;
+  struct rte_ring *echo_ring = p->echo_ring;
 
-      if ( forward ) {	// Left to Right direction is active
-        // set individual parameters for the left sender
-  
-        // collect the appropriate values dependig on the IP versions 
-        ipQuad ipq(ip_left_version,ip_right_version,&ipv4_left_real,&ipv4_right_real,&ipv4_left_virtual,&ipv4_right_virtual,
-                   &ipv6_left_real,&ipv6_right_real,&ipv6_left_virtual,&ipv6_right_virtual);
+  atomicFourTuple *stTbl = *stateTable;	// the state table was allocated in the preliminary phase by rreceive
+  unsigned index = 0; 			// state table index: first write will happen to this position
+  fourTuple four_tuple;			// 4-tuple for collecting IPv4 addresses and port numbers
 
-        if ( !ip_varies ) { // use traditional single source and destination IP addresses
-     
-          // initialize the parameter class instance
-          spars1=senderParameters(&scp1,ip_left_version,pkt_pool_left_sender,leftport,"Forward",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
-                                  ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,num_right_nets,
-                                  fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max);
-          // start left sender
-          if ( rte_eal_remote_launch(send, &spars1, cpu_left_sender) )
-            std::cout << "Error: could not start Left Sender." << std::endl;
+  // further local variables
+  int frames, i, replies, enqueued;
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of received frames
+  struct rte_mbuf *echo_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of echo replies
+  uint16_t ipv4=htons(0x0800); // EtherType for IPv4 in Network Byte Order
+  uint16_t ipv6=htons(0x86DD); // EtherType for IPv6 in Network Byte Order
+  uint8_t identify[8]= { 'I', 'D', 'E', 'N', 'T', 'I', 'F', 'Y' };	// Identificion of the Test Frames
+  uint64_t *id=(uint64_t *) identify;
+  uint64_t fg_received=0, bg_received=0;	// number of received (fg, bg) frames (counted separetely)
+  uint64_t echoed=0;				// number of echo replies passed to the Responder/Sender
+  uint8_t mac[6];				// temporary storage for swapping MAC addresses
+  uint32_t addr;				// temporary storage for swapping IPv4 addresses
+  uint16_t port;				// temporary storage for swapping port numbers
+
+  // frames are received, their four tuples are recorded and the foreground frames are echoed
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  polls.lc->state_entries.store(*valid_entries, std::memory_order_relaxed); // 0 in the preliminary phase
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
+    frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
+    polls.count(frames, poll_tsc);
+    replies = 0;
+    for (i=0; i < frames; i++){
+      uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the Test Frame in the message buffer
+      // check EtherType at offset 12: IPv6, IPv4, or anything else
+      if ( *(uint16_t *)&pkt[12]==ipv6 ) { /* IPv6  */
+        /* check if IPv6 Next Header is UDP, and the first 8 bytes of UDP data is 'IDENTIFY' */
+        if ( likely( pkt[20]==17 && *(uint64_t *)&pkt[62]==*id ) )
+          bg_received++;	// it is considered a background frame: we do not deal with it any more
+      } else if ( *(uint16_t *)&pkt[12]==ipv4 ) { /* IPv4 */
+        if ( likely( pkt[23]==17 && *(uint64_t *)&pkt[42]==*id ) ) {
+          fg_received++;	// it is considered a freground frame: we must learn its 4-tuple and echo it
+          // copy IPv4 fields to the four_tuple -- without using conversion from network byte order to host byte order
+          four_tuple.init_addr = *(uint32_t *)&pkt[26]; 	// 14+12: source IPv4 address
+          four_tuple.resp_addr = *(uint32_t *)&pkt[30]; 	// 14+16: destination IPv4 address
+          four_tuple.init_port = *(uint16_t *)&pkt[34]; 	// 14+20: source UDP port
+          four_tuple.resp_port = *(uint16_t *)&pkt[36]; 	// 14+22: destination UDP port
+	  stTbl[index] = four_tuple; 				// atomic write
+	  index = ++index % state_table_size;			// maintain write pointer
+          // turn the frame into an echo reply: swap MAC addresses, IPv4 addresses and UDP port numbers
+          rte_memcpy(mac, pkt, 6);
+          rte_memcpy(pkt, pkt+6, 6);
+          rte_memcpy(pkt+6, mac, 6);
+          addr = *(uint32_t *)&pkt[26];
+          *(uint32_t *)&pkt[26] = *(uint32_t *)&pkt[30];
+          *(uint32_t *)&pkt[30] = addr;
+          port = *(uint16_t *)&pkt[34];
+          *(uint16_t *)&pkt[34] = *(uint16_t *)&pkt[36];
+          *(uint16_t *)&pkt[36] = port;
+          echo_mbufs[replies++] = pkt_mbufs[i];
+          continue;	// this mbuf is not freed here
+        }
+      }
+      rte_pktmbuf_free(pkt_mbufs[i]);
+    }
+    if ( replies ) {
+      enqueued = rte_ring_sp_enqueue_burst(echo_ring, (void **)echo_mbufs, replies, NULL);
+      echoed += enqueued;
+      for ( i=enqueued; i < replies; i++ )
+        rte_pktmbuf_free(echo_mbufs[i]);	// the ring is full: these echo replies are dropped
+    }
+    if ( !*valid_entries ) // preliminary phase: the state table is being filled
+      polls.lc->state_entries.store(fg_received < state_table_size ? fg_received : state_table_size, std::memory_order_relaxed);
+  }
+  polls.report(side);
+  printf("%s frames received: %lu\n", side, fg_received+bg_received);
+  printf("%s frames echoed: %lu\n", side, echoed);
+  return fg_received+bg_received;
+}
 
-        } else { // use multiple source and/or destination IP addresses
+// Responder/Sender in echo mode: sends the echo replies prepared by rreceiveEcho as soon as possible
+int rsendEcho(void *par) {
+  // collecting input parameters:
+  class rSenderParametersEcho *p = (class rSenderParametersEcho *)par;
+  uint64_t finish_sending = p->finish_sending;
+  uint16_t eth_id = p->eth_id;
+  const char *side = p->side;
+  struct rte_ring *echo_ring = p->echo_ring;
 
-          // initialize the parameter class instance
-          mspars1=mSenderParameters(&scp1,ip_left_version,pkt_pool_left_sender,leftport,"Forward",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
-                                    ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,
-                                    ip_left_varies,ip_right_varies,ip_left_min,ip_left_max,ip_right_min,ip_right_max,
-                                    ipv4_left_offset,ipv4_right_offset,ipv6_left_offset,ipv6_right_offset,
-                                    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max);
+  // further local variables
+  unsigned frames, sent;
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of echo replies
+  uint64_t sent_replies=0; 	// number of sent echo replies
+
+  while ( rte_rdtsc() < finish_sending ) {
+    frames = rte_ring_sc_dequeue_burst(echo_ring, (void **)pkt_mbufs, MAX_PKT_BURST, NULL);
+    for ( sent=0; sent < frames; )
+      sent += rte_eth_tx_burst(eth_id, 0, pkt_mbufs+sent, frames-sent);
+    sent_replies += frames;
+  }
+  // echo replies possibly left in the ring are dropped
+  while ( (frames = rte_ring_sc_dequeue_burst(echo_ring, (void **)pkt_mbufs, MAX_PKT_BURST, NULL)) )
+    rte_pktmbuf_free_bulk(pkt_mbufs, frames);
+  printf("%s echo replies sent: %lu\n", side, sent_replies);
+  return 0;
+}
 
-          // start left sender
-          if ( rte_eal_remote_launch(msend, &mspars1, cpu_left_sender) )
-            std::cout << "Error: could not start Left Sender." << std::endl;
-        }
+// Initiator/Receiver in echo mode: receives and counts echo replies, measures their round-trip time
+// using the time stamp written by stampEcho (the 32 bits following 'IDENTIFY')
+// Offsets from the start of the Ethernet Frame:
+// EtherType: 6+6=12
+// IPv6 Next header: 14+6=20, UDP Data for IPv6: 14+40+8=62, time stamp: 70
+// IPv4 Protolcol: 14+9=23, UDP Data for IPv4: 14+20+8=42, time stamp: 50
+int receiveEcho(void *par) {
+  // collecting input parameters:
+  class receiverParametersEcho *p = (class receiverParametersEcho *)par;
+  uint64_t finish_receiving = p->finish_receiving;
+  uint16_t eth_id = p->eth_id;
+  const char *side = p->side;
+  uint64_t hz = p->hz;
+  uint64_t expected_replies = p->expected_replies;
 
-        // set parameters for the right receiver
-        rpars1=receiverParameters(finish_receiving,rightport,"Forward");
-    
-        // start right receiver
-        if ( rte_eal_remote_launch(receive, &rpars1, cpu_right_receiver) )
-          std::cout << "Error: could not start Right Receiver." << std::endl;
+  // further local variables
+  int frames, i;
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of received frames
+  uint16_t ipv4=htons(0x0800); // EtherType for IPv4 in Network Byte Order
+  uint16_t ipv6=htons(0x86DD); // EtherType for IPv6 in Network Byte Order
+  uint8_t identify[8]= { 'I', 'D', 'E', 'N', 'T', 'I', 'F', 'Y' };	// Identificion of the Test Frames
+  uint64_t *id=(uint64_t *) identify;
+  uint64_t received=0; 	// number of received echo replies
+  uint8_t *data;	// UDP data of the current echo reply (or 0, if it is not an echo reply)
+  uint32_t now;		// low 32 bits of the TSC at the reception of the current burst
+  uint32_t rtt, rtt_min=UINT32_MAX, rtt_max=0;	// round-trip time in TSC ticks
+  uint64_t sample_step = expected_replies/ECHO_RTT_SAMPLES+1;	// every sample_step-th round-trip time is stored
+  uint64_t num_samples=0;	// number of stored round-trip times
+
+  uint32_t *rtt_samples = (uint32_t *) rte_malloc("Initiator/Receiver's round-trip times", sizeof(uint32_t)*ECHO_RTT_SAMPLES, 0);
+  if ( !rtt_samples )
+    rte_exit(EXIT_FAILURE, "Error: Initiator/Receiver can't allocate memory for round-trip times!\n");
+
+  pollCounters polls(side, eth_id);	// cycle accounting of the receiver
+  uint64_t poll_tsc;	// TSC at the beginning of the current poll
+  while ( (poll_tsc = rte_rdtsc()) < finish_receiving ){
+    frames = rte_eth_rx_burst(eth_id, 0, pkt_mbufs, MAX_PKT_BURST);
+    now = (uint32_t) polls.count(frames, poll_tsc); // the TSC right after receiving the frames
+    for (i=0; i < frames; i++){
+      uint8_t *pkt = rte_pktmbuf_mtod(pkt_mbufs[i], uint8_t *); // Access the Test Frame in the message buffer
+      data = 0;
+      // check EtherType at offset 12: IPv6, IPv4, or anything else
+      if ( *(uint16_t *)&pkt[12]==ipv6 ) { /* IPv6  */
+        /* check if IPv6 Next Header is UDP, and the first 8 bytes of UDP data is 'IDENTIFY' */
+        if ( likely( pkt[20]==17 && *(uint64_t *)&pkt[62]==*id ) )
+          data = pkt+62;
+      } else if ( *(uint16_t *)&pkt[12]==ipv4 ) { /* IPv4 */
+        if ( likely( pkt[23]==17 && *(uint64_t *)&pkt[42]==*id ) )
+          data = pkt+42;
       }
-    
-      if ( reverse ) {	// Right to Left direction is active 
-        // set individual parameters for the right sender
-    
-        // collect the appropriate values dependig on the IP versions
-        ipQuad ipq(ip_right_version,ip_left_version,&ipv4_right_real,&ipv4_left_real,&ipv4_right_virtual,&ipv4_left_virtual,
-                   &ipv6_right_real,&ipv6_left_real,&ipv6_right_virtual,&ipv6_left_virtual);
-
-        if ( !ip_varies ) { // use traditional single source and destination IP addresses
-    
-          // initialize the parameter class instance
-          spars2=senderParameters(&scp1,ip_right_version,pkt_pool_right_sender,rightport,"Reverse",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
-                                  ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
-                                  rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max);
-          // start right sender
-          if (rte_eal_remote_launch(send, &spars2, cpu_right_sender) )
-            std::cout << "Error: could not start Right Sender." << std::endl;
-    
-        } else { // use multiple source and/or destination IP addresses
-
-          // initialize the parameter class instance
-          mspars2=mSenderParameters(&scp1,ip_right_version,pkt_pool_right_sender,rightport,"Reverse",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
-                                    ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,
-                                    ip_right_varies,ip_left_varies,ip_right_min,ip_right_max,ip_left_min,ip_left_max,
-                                    ipv4_right_offset,ipv4_left_offset,ipv6_right_offset,ipv6_left_offset,
-                                    rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max);
+      if ( likely( data != 0 ) ) {
+        received++;
+        rtt = now - *(uint32_t *)(data+8); // wraps around correctly
+        if ( rtt < rtt_min )
+          rtt_min = rtt;
+        if ( rtt > rtt_max )
+          rtt_max = rtt;
+        if ( received % sample_step == 0 && num_samples < ECHO_RTT_SAMPLES )
+          rtt_samples[num_samples++] = rtt;
+      }
+      rte_pktmbuf_free(pkt_mbufs[i]);
+    }
+  }
+  polls.report(side);
+  printf("%s echo replies received: %lu\n", side, received);
+  printf("%s echo replies lost: %lu\n", side, expected_replies > received ? expected_replies-received : 0);
+  if ( num_samples ) {
+    std::sort(rtt_samples,rtt_samples+num_samples);
+    printf("%s RTT min: %lf\n", side, 1000.0*rtt_min/hz);
+    printf("%s RTT median: %lf\n", side, 1000.0*rtt_samples[num_samples/2]/hz);
+    printf("%s RTT 99.9th percentile: %lf\n", side, 1000.0*rtt_samples[int(ceil(0.999*num_samples))-1]/hz);
+    printf("%s RTT max: %lf\n", side, 1000.0*rtt_max/hz);
+  }
+  rte_free(rtt_samples);
+  return received;
+}
 
-          // start right sender
-          if (rte_eal_remote_launch(msend, &mspars2, cpu_right_sender) )
-            std::cout << "Error: could not start Right Sender." << std::endl;
+// forwards the frames between the software loopback ports of the self-calibration like a DUT with zero latency (Calibrate 1):
+// the frames sent by the Left Sender are passed to the Right Receiver, and the frames sent by the Right Sender to the Left Receiver,
+// the frames are neither examined nor modified, and they are dropped if the ring of the receiver is full (like at a full RX queue)
+int calibrationForwarder(void *par) {
+  // collecting input parameters:
+  class forwarderParameters *p = (class forwarderParameters *)par;
+  struct rte_ring **rings = p->rings;
 
-        }
+  // further local variables
+  unsigned frames, done, d;
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of the forwarded frames
+  uint64_t forwarded=0, dropped=0, rounds=0;
+
+  while ( !p->stop.load(std::memory_order_relaxed) ) {
+    for ( d=0; d<4; d+=2 ) { // forward and reverse direction
+      frames = rte_ring_sc_dequeue_burst(rings[d], (void **)pkt_mbufs, MAX_PKT_BURST, 0);
+      done = rte_ring_sp_enqueue_burst(rings[d+1], (void **)pkt_mbufs, frames, 0);
+      forwarded += done;
+      dropped += frames-done;
+      for ( ; done < frames; done++ )
+        rte_pktmbuf_free(pkt_mbufs[done]);
+    }
+    p->rounds.store(++rounds, std::memory_order_release);
+  }
+  p->forwarded = forwarded;
+  p->dropped = dropped;
+  return 0;
+}
 
-        // set parameters for the left receiver
-        rpars2=receiverParameters(finish_receiving,leftport,"Reverse");
+// performs the preliminary phase of a stateful test: the Initiator sends preliminary frames to create the connections in the DUT,
+// and the Responder learns their 4-tuples into its state table (used by measure() and by the in-process searches)
+void Throughput::preliminaryPhase(uint16_t leftport, uint16_t rightport) {
+  time_t now; // needed for printing out a timestamp in Info message
 
-        // start left receiver
-        if ( rte_eal_remote_launch(receive, &rpars2, cpu_left_receiver) )
-          std::cout << "Error: could not start Left Receiver." << std::endl;
+  // Parameters are provided to the sender and receiver functions in the following 'struct'-s.
+  // They are declared here so that they will not be overwritten in the stack when the program leaves an 'if' block.
+  senderCommonParameters scp1;
+  iSenderParameters ispars;
+  imSenderParameters imspars;
+  rReceiverParameters rrpars1;
 
-      }
-    
-      now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-      std::cout << "Info: Testing initiated at " << std::put_time(localtime(&now), "%F %T") << std::endl;
-    
-      // wait until active senders and receivers finish 
-      if ( forward ) {
-        rte_eal_wait_lcore(cpu_left_sender);
-        rte_eal_wait_lcore(cpu_right_receiver);
-      }
-      if ( reverse ) {
-        rte_eal_wait_lcore(cpu_right_sender);
-        rte_eal_wait_lcore(cpu_left_receiver);
-      }
-      std::cout << "Info: Test finished." << std::endl;
-      break;
-      }
+  switch ( stateful ) {
     case 1:	// stateful test: Initiator is on the left side, Responder is on the right side
       { 
       // set "common" parameters (currently not common with anyone, only code is reused; it will be common, when sending test frames)
-      scp1=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,pre_rate,0,n,m,hz,start_tsc_pre); // 0: duration in seconds is not applicable
+      scp1=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,pre_rate,0,n,m,hz,start_tsc_pre,0,0,0,tcp ? RTE_TCP_SYN_FLAG : 0); // 0: duration in seconds is not applicable
 
       // set "individual" parameters for the sender of the Initiator residing on the left side
   
@@ -3859,7 +6087,7 @@ void Throughput::measure(uint16_t leftport, uint16_t rightport) {
         // initialize the parameter class instance for premiminary phase
         imspars=imSenderParameters(&scp1,ip_left_version,pkt_pool_left_sender,leftport,"Preliminary",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
                                    ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,
-                                   ip_left_varies,ip_right_varies,ip_left_min,ip_left_max,ip_right_min,ip_right_max,
+                                   ip_left_varies,ip_right_varies,ip_left_min,ip_left_max,ip_right_min,ip_right_max,ip_left_bits,ip_right_bits,
                                    ipv4_left_offset,ipv4_right_offset,ipv6_left_offset,ipv6_right_offset,
                                    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max,
 				   enumerate_ips,enumerate_ports,pre_frames,uniqueIpComb,uniqueFtComb);
@@ -3880,18 +6108,354 @@ void Throughput::measure(uint16_t leftport, uint16_t rightport) {
       std::cout << "Info: Preliminary frame sending initiated at " << std::put_time(localtime(&now), "%F %T") << std::endl;
     
       // wait until active senders and receivers finish 
-      rte_eal_wait_lcore(cpu_left_sender);
-      rte_eal_wait_lcore(cpu_right_receiver);
+      slow_senders += rte_eal_wait_lcore(cpu_left_sender) != 0;
+      pre_received = rte_eal_wait_lcore(cpu_right_receiver);
+
+      if ( valid_entries < state_table_size )
+        printf("Error: Failed to fill state table (valid entries: %u, state table size: %u)!\n", valid_entries, state_table_size);
+      else
+      	std::cout << "Info: Preliminary phase finished." << std::endl;
+      break;
+      }
+    case 2:	// stateful test: Initiator is on the right side, Responder is on the left side
+      { 
+      // set "common" parameters (currently not common with anyone, only code is reused; it will be common, when sending test frames)
+      scp1=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,pre_rate,0,n,m,hz,start_tsc_pre,0,0,0,tcp ? RTE_TCP_SYN_FLAG : 0); // 0: duration in seconds is not applicable
+
+      // set "individual" parameters for the sender of the Initiator residing on the right side
+
+      // collect the appropriate values dependig on the IP versions
+      ipQuad ipq(ip_right_version,ip_left_version,&ipv4_right_real,&ipv4_left_real,&ipv4_right_virtual,&ipv4_left_virtual,
+                 &ipv6_right_real,&ipv6_left_real,&ipv6_right_virtual,&ipv6_left_virtual);
+
+      if ( !ip_varies ) { // use traditional single source and destination IP addresses
+  
+        // initialize the parameter class instance for preliminary phase
+        ispars=iSenderParameters(&scp1,ip_right_version,pkt_pool_right_sender,rightport,"Preliminary",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
+                                 ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
+                                 rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max,
+  			         enumerate_ports,pre_frames,uniquePortComb);
+  
+        // start right sender
+        if ( rte_eal_remote_launch(isend, &ispars, cpu_right_sender) )
+          std::cout << "Error: could not Initiator's Sender." << std::endl;
+  
+      } else { // use multiple source and/or destination IP addresses (because ip_varies OR enumerate_ips)
+
+        // initialize the parameter class instance for preliminary phase
+        imspars=imSenderParameters(&scp1,ip_right_version,pkt_pool_right_sender,rightport,"Preliminary",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
+                                   ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,
+                                   ip_right_varies,ip_left_varies,ip_right_min,ip_right_max,ip_left_min,ip_left_max,ip_right_bits,ip_left_bits,
+                                   ipv4_right_offset,ipv4_left_offset,ipv6_right_offset,ipv6_left_offset,
+                                   rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max,
+                                   enumerate_ips,enumerate_ports,pre_frames,uniqueIpComb,uniqueFtComb);
+
+        // start right sender
+        if ( rte_eal_remote_launch(imsend, &imspars, cpu_right_sender) )
+          std::cout << "Error: could not Initiator's Sender." << std::endl;
+      }
+
+      // set parameters for the left receiver
+      rrpars1=rReceiverParameters(finish_receiving_pre,leftport,"Preliminary",state_table_size,&valid_entries,&stateTable); 
+
+      // start left receiver
+      if ( rte_eal_remote_launch(rreceive, &rrpars1, cpu_left_receiver) )
+        std::cout << "Error: could not start Responder's Receiver." << std::endl;
+
+      now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+      std::cout << "Info: Preliminary frame sending initiated at " << std::put_time(localtime(&now), "%F %T") << std::endl;
+
+      // wait until active senders and receivers finish
+      slow_senders += rte_eal_wait_lcore(cpu_right_sender) != 0;
+      pre_received = rte_eal_wait_lcore(cpu_left_receiver);
+      
+      if ( valid_entries < state_table_size )
+        printf("Error: Failed to fill state table (valid entries: %u, state table size: %u)!\n", valid_entries, state_table_size);
+      else
+        std::cout << "Info: Preliminary phase finished." << std::endl;
+      break;
+      }
+  }
+}
+
+// performs throughput (or frame loss rate) measurement
+void Throughput::measure(uint16_t leftport, uint16_t rightport) {
+  time_t now; // needed for printing out a timestamp in Info message
+
+  // Several parameters are provided to the various sender functions (send, isend, msend, imsend) 
+  // and receiver functions (receive, ) in the following 'struct'-s.
+  // They are declared here so that they will not be overwritten in the stack when the program leaves an 'if' block.
+  senderCommonParameters scp1, scp2;
+  senderParameters spars2; 
+  mSenderParameters mspars2;
+  receiverParameters rpars2;
+  rReceiverParameters rrpars2;
+  rSenderParameters rspars;
+  rReceiverParametersEcho rrepars;
+  rSenderParametersEcho rsepars;
+  receiverParametersEcho repars;
+  uint64_t fg_frames = (uint64_t)duration*frame_rate/n*m + ((uint64_t)duration*frame_rate%n < m ? (uint64_t)duration*frame_rate%n : m); // number of foreground test frames
+
+  fwd_received = rev_received = 0;	// the number of received frames are aggregated over the port pairs
+  slow_senders = 0;			// the senders of the preliminary phase are also counted
+
+  switch ( stateful ) {
+    case 0:	// stateless test is to be performed
+      {
+      // parameters of the port pairs (port pair 0 uses leftport and rightport, see init())
+      senderParameters spars[MAX_PORT_PAIRS][2];
+      mSenderParameters mspars[MAX_PORT_PAIRS][2];
+      receiverParameters rpars[MAX_PORT_PAIRS][2];
+      char sides[MAX_PORT_PAIRS][2][32];	// direction names, the index of the port pair is added, if there are more than one
+      sSenderParameters sspars[2];	// parameters of the senders using a pre-materialized traffic schedule (single port pair only)
+      pSenderParameters ppars[2];	// parameters of the stages of the frame preparation pipelines (single port pair only)
+      trafficSchedule *schedules[2] = {0, 0};	// traffic schedules of the Left and Right Senders (if any), also used by the pipelines
+      receiverParametersImix rimix[2];	// parameters of the receivers counting the frames of each IMIX size class (single port pair only)
+      receiverParametersNets rnets[MAX_PORT_PAIRS][2];	// parameters of the receivers counting the frames of each destination network
+
+      // set common parameters for senders
+      scp1=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc,0,&popularity,&imix,0);
+      scp1.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
+
+      for ( unsigned i=0; i<port_pairs; i++ ) {
+        uint16_t lport = pair_port[i][0], rport = pair_port[i][1];	// ports of the port pair
+        uint8_t (*mac)[6] = pair_mac[i];	// MAC addresses of the port pair: left tester, right tester, left DUT, right DUT
+        if ( port_pairs > 1 ) {
+          snprintf(sides[i][0], 32, "Forward (pair %u)", i);
+          snprintf(sides[i][1], 32, "Reverse (pair %u)", i);
+        } else {
+          strcpy(sides[i][0], "Forward");
+          strcpy(sides[i][1], "Reverse");
+        }
+
+        if ( forward ) {	// Left to Right direction is active
+          // set individual parameters for the left sender
+  
+          // collect the appropriate values dependig on the IP versions 
+          ipQuad ipq(ip_left_version,ip_right_version,&ipv4_left_real,&ipv4_right_real,&ipv4_left_virtual,&ipv4_right_virtual,
+                     &ipv6_left_real,&ipv6_right_real,&ipv6_left_virtual,&ipv6_right_virtual);
+
+          if ( schedule || pipeline ) { // use a pre-materialized traffic schedule or the frame preparation pipeline
+            mspars[i][0]=mSenderParameters(&scp1,ip_left_version,pair_pool[i][0],lport,sides[i][0],(ether_addr *)mac[2],(ether_addr *)mac[0],
+                                           ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,
+                                           ip_left_varies,ip_right_varies,ip_left_min,ip_left_max,ip_right_min,ip_right_max,ip_left_bits,ip_right_bits,
+                                           ipv4_left_offset,ipv4_right_offset,ipv6_left_offset,ipv6_right_offset,
+                                           fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max);
+            if ( schedule )
+              schedules[0] = makeSchedule(&mspars[i][0], pair_cpu[i][0], cpu_left_helper);
+            else
+              schedules[0] = new trafficSchedule(&mspars[i][0], (uint64_t)duration*senderFrameRate(ip_left_version), MAX_PKT_BURST, rte_lcore_to_socket_id(cpu_left_helper));
+          }
+
+          if ( pipeline ) { // the frames are prepared by the helper lcore
+
+            ppars[0]=pSenderParameters(mspars[i][0], schedules[0], pipeline_ring[0]);
+            // start the producer of the left sender
+            if ( rte_eal_remote_launch(pipelineProducer, &ppars[0], cpu_left_helper) )
+              rte_exit(EXIT_FAILURE, "Error: could not start Left Sender's Helper, the sender would wait for its frames forever!\n");
+            // start left sender
+            if ( rte_eal_remote_launch(psend, &ppars[0], pair_cpu[i][0]) )
+              std::cout << "Error: could not start Left Sender." << std::endl;
+
+          } else if ( schedules[0] ) { // the whole schedule or its first chunks are generated before sending begins
+
+            sspars[0]=sSenderParameters(mspars[i][0], schedules[0]);
+            // start left sender
+            if ( rte_eal_remote_launch(ssend, &sspars[0], pair_cpu[i][0]) )
+              std::cout << "Error: could not start Left Sender." << std::endl;
+            // start the helper of the left sender
+            if ( schedules[0]->chunked && rte_eal_remote_launch(scheduleHelper, schedules[0], cpu_left_helper) )
+              rte_exit(EXIT_FAILURE, "Error: could not start Left Sender's Helper, the sender would wait for its schedule forever!\n");
+
+          } else if ( !ip_varies ) { // use traditional single source and destination IP addresses
+     
+            // initialize the parameter class instance
+            spars[i][0]=senderParameters(&scp1,ip_left_version,pair_pool[i][0],lport,sides[i][0],(ether_addr *)mac[2],(ether_addr *)mac[0],
+                                         ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,num_right_nets,
+                                         fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max);
+            // start left sender
+            if ( rte_eal_remote_launch(send, &spars[i][0], pair_cpu[i][0]) )
+              std::cout << "Error: could not start Left Sender." << std::endl;
+
+          } else { // use multiple source and/or destination IP addresses
+
+            // initialize the parameter class instance
+            mspars[i][0]=mSenderParameters(&scp1,ip_left_version,pair_pool[i][0],lport,sides[i][0],(ether_addr *)mac[2],(ether_addr *)mac[0],
+                                           ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,
+                                           ip_left_varies,ip_right_varies,ip_left_min,ip_left_max,ip_right_min,ip_right_max,ip_left_bits,ip_right_bits,
+                                           ipv4_left_offset,ipv4_right_offset,ipv6_left_offset,ipv6_right_offset,
+                                           fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max);
+
+            // start left sender
+            if ( rte_eal_remote_launch(msend, &mspars[i][0], pair_cpu[i][0]) )
+              std::cout << "Error: could not start Left Sender." << std::endl;
+          }
+
+          // set parameters for the right receiver
+          rpars[i][0]=receiverParameters(finish_receiving,rport,sides[i][0]);
+          if ( imix.sizes ) {
+            rimix[0]=receiverParametersImix(finish_receiving,rport,sides[i][0],&imix);
+            // start right receiver, it also counts the frames of each size class
+            if ( rte_eal_remote_launch(receiveImix, &rimix[0], pair_cpu[i][1]) )
+              std::cout << "Error: could not start Right Receiver." << std::endl;
+          } else if ( num_right_nets > 1 ) {
+            rnets[i][0]=receiverParametersNets(finish_receiving,rport,sides[i][0],num_right_nets,&ipv4_right_real,&ipv6_right_real);
+            // start right receiver, it also counts the frames of each destination network
+            if ( rte_eal_remote_launch(receiveNets, &rnets[i][0], pair_cpu[i][1]) )
+              std::cout << "Error: could not start Right Receiver." << std::endl;
+          } else {
+            // start right receiver
+            if ( rte_eal_remote_launch(receive, &rpars[i][0], pair_cpu[i][1]) )
+              std::cout << "Error: could not start Right Receiver." << std::endl;
+          }
+        }
+    
+        if ( reverse ) {	// Right to Left direction is active 
+          // set individual parameters for the right sender
+    
+          // collect the appropriate values dependig on the IP versions
+          ipQuad ipq(ip_right_version,ip_left_version,&ipv4_right_real,&ipv4_left_real,&ipv4_right_virtual,&ipv4_left_virtual,
+                     &ipv6_right_real,&ipv6_left_real,&ipv6_right_virtual,&ipv6_left_virtual);
+
+          if ( schedule || pipeline ) { // use a pre-materialized traffic schedule or the frame preparation pipeline
+            mspars[i][1]=mSenderParameters(&scp1,ip_right_version,pair_pool[i][2],rport,sides[i][1],(ether_addr *)mac[3],(ether_addr *)mac[1],
+                                           ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,
+                                           ip_right_varies,ip_left_varies,ip_right_min,ip_right_max,ip_left_min,ip_left_max,ip_right_bits,ip_left_bits,
+                                           ipv4_right_offset,ipv4_left_offset,ipv6_right_offset,ipv6_left_offset,
+                                           rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max);
+            if ( schedule )
+              schedules[1] = makeSchedule(&mspars[i][1], pair_cpu[i][2], cpu_right_helper);
+            else
+              schedules[1] = new trafficSchedule(&mspars[i][1], (uint64_t)duration*senderFrameRate(ip_right_version), MAX_PKT_BURST, rte_lcore_to_socket_id(cpu_right_helper));
+          }
+
+          if ( pipeline ) { // the frames are prepared by the helper lcore
+
+            ppars[1]=pSenderParameters(mspars[i][1], schedules[1], pipeline_ring[1]);
+            // start the producer of the right sender
+            if ( rte_eal_remote_launch(pipelineProducer, &ppars[1], cpu_right_helper) )
+              rte_exit(EXIT_FAILURE, "Error: could not start Right Sender's Helper, the sender would wait for its frames forever!\n");
+            // start right sender
+            if ( rte_eal_remote_launch(psend, &ppars[1], pair_cpu[i][2]) )
+              std::cout << "Error: could not start Right Sender." << std::endl;
+
+          } else if ( schedules[1] ) { // the whole schedule or its first chunks are generated before sending begins
+
+            sspars[1]=sSenderParameters(mspars[i][1], schedules[1]);
+            // start right sender
+            if ( rte_eal_remote_launch(ssend, &sspars[1], pair_cpu[i][2]) )
+              std::cout << "Error: could not start Right Sender." << std::endl;
+            // start the helper of the right sender
+            if ( schedules[1]->chunked && rte_eal_remote_launch(scheduleHelper, schedules[1], cpu_right_helper) )
+              rte_exit(EXIT_FAILURE, "Error: could not start Right Sender's Helper, the sender would wait for its schedule forever!\n");
+
+          } else if ( !ip_varies ) { // use traditional single source and destination IP addresses
+    
+            // initialize the parameter class instance
+            spars[i][1]=senderParameters(&scp1,ip_right_version,pair_pool[i][2],rport,sides[i][1],(ether_addr *)mac[3],(ether_addr *)mac[1],
+                                         ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
+                                         rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max);
+            // start right sender
+            if (rte_eal_remote_launch(send, &spars[i][1], pair_cpu[i][2]) )
+              std::cout << "Error: could not start Right Sender." << std::endl;
+    
+          } else { // use multiple source and/or destination IP addresses
+
+            // initialize the parameter class instance
+            mspars[i][1]=mSenderParameters(&scp1,ip_right_version,pair_pool[i][2],rport,sides[i][1],(ether_addr *)mac[3],(ether_addr *)mac[1],
+                                           ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,
+                                           ip_right_varies,ip_left_varies,ip_right_min,ip_right_max,ip_left_min,ip_left_max,ip_right_bits,ip_left_bits,
+                                           ipv4_right_offset,ipv4_left_offset,ipv6_right_offset,ipv6_left_offset,
+                                           rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max);
+
+            // start right sender
+            if (rte_eal_remote_launch(msend, &mspars[i][1], pair_cpu[i][2]) )
+              std::cout << "Error: could not start Right Sender." << std::endl;
+
+          }
+
+          // set parameters for the left receiver
+          rpars[i][1]=receiverParameters(finish_receiving,lport,sides[i][1]);
+          if ( imix.sizes ) {
+            rimix[1]=receiverParametersImix(finish_receiving,lport,sides[i][1],&imix);
+            // start left receiver, it also counts the frames of each size class
+            if ( rte_eal_remote_launch(receiveImix, &rimix[1], pair_cpu[i][3]) )
+              std::cout << "Error: could not start Left Receiver." << std::endl;
+          } else if ( num_left_nets > 1 ) {
+            rnets[i][1]=receiverParametersNets(finish_receiving,lport,sides[i][1],num_left_nets,&ipv4_left_real,&ipv6_left_real);
+            // start left receiver, it also counts the frames of each destination network
+            if ( rte_eal_remote_launch(receiveNets, &rnets[i][1], pair_cpu[i][3]) )
+              std::cout << "Error: could not start Left Receiver." << std::endl;
+          } else {
+            // start left receiver
+            if ( rte_eal_remote_launch(receive, &rpars[i][1], pair_cpu[i][3]) )
+              std::cout << "Error: could not start Left Receiver." << std::endl;
+          }
+
+        }
+      }
+    
+      now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+      std::cout << "Info: Testing initiated at " << std::put_time(localtime(&now), "%F %T") << std::endl;
+    
+      // wait until active senders and receivers finish 
+      for ( unsigned i=0; i<port_pairs; i++ ) {
+        if ( forward ) {
+          slow_senders += rte_eal_wait_lcore(pair_cpu[i][0]) != 0;
+          rte_eal_wait_lcore(pair_cpu[i][1]);
+          fwd_received += imix.sizes ? rimix[0].received : num_right_nets > 1 ? rnets[i][0].received : rpars[i][0].received;
+        }
+        if ( reverse ) {
+          slow_senders += rte_eal_wait_lcore(pair_cpu[i][2]) != 0;
+          rte_eal_wait_lcore(pair_cpu[i][3]);
+          rev_received += imix.sizes ? rimix[1].received : num_left_nets > 1 ? rnets[i][1].received : rpars[i][1].received;
+        }
+      }
+      // report the frame loss of each destination network (multiple destination networks imply send() and receiveNets())
+      for ( unsigned i=0; i<port_pairs; i++ )
+        for ( int x=0; x<2; x++ ) {
+          uint32_t num_nets = x ? num_left_nets : num_right_nets;
+          if ( num_nets == 1 || !(x ? reverse : forward) )
+            continue;
+          for ( uint32_t k=0; k<num_nets; k++ ) {
+            uint64_t sent = spars[i][x].net_sent[k], received = rnets[i][x].net_received[k];
+            printf("%s net %u frames sent: %lu, received: %lu, lost: %ld\n", sides[i][x], k, sent, received, (int64_t)(sent-received));
+          }
+          rte_free(spars[i][x].net_sent);
+          rte_free(rnets[i][x].net_received);
+        }
+      // release the traffic schedules (their helper lcores generate them in chunks)
+      for ( int j=0; j<2; j++ )
+        if ( schedules[j] ) {
+          if ( schedules[j]->chunked || pipeline )
+            rte_eal_wait_lcore(j ? cpu_right_helper : cpu_left_helper);
+          delete schedules[j];
+        }
+      if ( port_pairs > 1 ) {
+        // the aggregated results are printed in the same format as the results of a single port pair
+        if ( forward )
+          printf("Forward frames received: %lu\n", fwd_received);
+        if ( reverse )
+          printf("Reverse frames received: %lu\n", rev_received);
+      }
+      std::cout << "Info: Test finished." << std::endl;
+      break;
+      }
+    case 1:	// stateful test: Initiator is on the left side, Responder is on the right side
+      { 
+      // the connections are created and their 4-tuples are learnt by the Responder
+      preliminaryPhase(leftport, rightport);
+
+      // collect the appropriate values dependig on the IP versions
+      ipQuad ipq(ip_left_version,ip_right_version,&ipv4_left_real,&ipv4_right_real,&ipv4_left_virtual,&ipv4_right_virtual,
+                 &ipv6_left_real,&ipv6_right_real,&ipv6_left_virtual,&ipv6_right_virtual);
 
-      if ( valid_entries < state_table_size )
-        printf("Error: Failed to fill state table (valid entries: %u, state table size: %u)!\n", valid_entries, state_table_size);
-      else
-      	std::cout << "Info: Preliminary phase finished." << std::endl;
 
       // Now the real test may follow.
 
       // set "common" parameters 
-      scp2=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc); 
+      scp2=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc,responder_echo,&popularity,0,tcp ? RTE_TCP_ACK_FLAG : 0); 
+      scp2.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
   
       if ( forward ) {  // Left to right direction is active
 
@@ -3913,7 +6477,7 @@ void Throughput::measure(uint16_t leftport, uint16_t rightport) {
           // initialize the parameter class instance for real test (reuse previously prepared 'ipq')
           mspars2=mSenderParameters(&scp2,ip_left_version,pkt_pool_left_sender,leftport,"Forward",(ether_addr *)mac_left_dut,(ether_addr *)mac_left_tester,
                                    ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_left_real,&ipv6_right_real,
-                                   ip_left_varies,ip_right_varies,ip_left_min,ip_left_max,ip_right_min,ip_right_max,
+                                   ip_left_varies,ip_right_varies,ip_left_min,ip_left_max,ip_right_min,ip_right_max,ip_left_bits,ip_right_bits,
                                    ipv4_left_offset,ipv4_right_offset,ipv6_left_offset,ipv6_right_offset,
                                    fwd_var_sport,fwd_var_dport,fwd_sport_min,fwd_sport_max,fwd_dport_min,fwd_dport_max);
 
@@ -3922,15 +6486,38 @@ void Throughput::measure(uint16_t leftport, uint16_t rightport) {
             std::cout << "Error: could not start Left Sender." << std::endl;
         }
   
-        // set parameters for the right receiver
-        rrpars2=rReceiverParameters(finish_receiving,rightport,"Forward",state_table_size,&valid_entries,&stateTable);
+        if ( !responder_echo ) {
+          // set parameters for the right receiver
+          rrpars2=rReceiverParameters(finish_receiving,rightport,"Forward",state_table_size,&valid_entries,&stateTable);
   
-        // start right receiver
-        if ( rte_eal_remote_launch(rreceive, &rrpars2, cpu_right_receiver) )
-          std::cout << "Error: could not start Responder's Receiver." << std::endl;
+          // start right receiver
+          if ( rte_eal_remote_launch(rreceive, &rrpars2, cpu_right_receiver) )
+            std::cout << "Error: could not start Responder's Receiver." << std::endl;
+        } else {
+          // set parameters for the right receiver, which also prepares the echo replies
+          rrepars=rReceiverParametersEcho(finish_receiving,rightport,"Forward",state_table_size,&valid_entries,&stateTable,echo_ring);
+
+          // start right receiver
+          if ( rte_eal_remote_launch(rreceiveEcho, &rrepars, cpu_right_receiver) )
+            std::cout << "Error: could not start Responder's Receiver." << std::endl;
+        }
       }
 
-      if ( reverse ) {  // Right to Left direction is active
+      if ( reverse && responder_echo ) {  // Right to Left direction carries the echo replies
+        // set parameters for the right sender
+        rsepars=rSenderParametersEcho(finish_receiving,rightport,"Reverse",echo_ring);
+
+        // start right sender
+        if ( rte_eal_remote_launch(rsendEcho, &rsepars, cpu_right_sender) )
+          std::cout << "Error: could not start Right Sender." << std::endl;
+
+        // set parameters for the left receiver
+        repars=receiverParametersEcho(finish_receiving,leftport,"Reverse",hz,fg_frames);
+
+        // start left receiver
+        if ( rte_eal_remote_launch(receiveEcho, &repars, cpu_left_receiver) )
+          std::cout << "Error: could not start Left Receiver." << std::endl;
+      } else if ( reverse ) {  // Right to Left direction is active
         // set individual parameters for the right sender
 
         // first, collect the appropriate values dependig on the IP versions
@@ -3960,77 +6547,32 @@ void Throughput::measure(uint16_t leftport, uint16_t rightport) {
 
       // wait until active senders and receivers finish
       if ( forward ) {
-        rte_eal_wait_lcore(cpu_left_sender);
-        rte_eal_wait_lcore(cpu_right_receiver);
+        slow_senders += rte_eal_wait_lcore(cpu_left_sender) != 0;
+        fwd_received = rte_eal_wait_lcore(cpu_right_receiver);
       }
       if ( reverse ) {
-        rte_eal_wait_lcore(cpu_right_sender);
-        rte_eal_wait_lcore(cpu_left_receiver);
+        slow_senders += rte_eal_wait_lcore(cpu_right_sender) != 0;
+        val_received = rev_received = rte_eal_wait_lcore(cpu_left_receiver);
       }
+      rte_free(spars2.net_sent); // the per network counters of send() are reported in stateless tests only
       std::cout << "Info: Test finished." << std::endl;
       break;
       }
     case 2:	// stateful test: Initiator is on the right side, Responder is on the left side
       { 
-      // set "common" parameters (currently not common with anyone, only code is reused; it will be common, when sending test frames)
-      scp1=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,pre_rate,0,n,m,hz,start_tsc_pre); // 0: duration in seconds is not applicable
-
-      // set "individual" parameters for the sender of the Initiator residing on the right side
+      // the connections are created and their 4-tuples are learnt by the Responder
+      preliminaryPhase(leftport, rightport);
 
       // collect the appropriate values dependig on the IP versions
       ipQuad ipq(ip_right_version,ip_left_version,&ipv4_right_real,&ipv4_left_real,&ipv4_right_virtual,&ipv4_left_virtual,
                  &ipv6_right_real,&ipv6_left_real,&ipv6_right_virtual,&ipv6_left_virtual);
 
-      if ( !ip_varies ) { // use traditional single source and destination IP addresses
-  
-        // initialize the parameter class instance for preliminary phase
-        ispars=iSenderParameters(&scp1,ip_right_version,pkt_pool_right_sender,rightport,"Preliminary",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
-                                 ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,num_left_nets,
-                                 rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max,
-  			         enumerate_ports,pre_frames,uniquePortComb);
-  
-        // start right sender
-        if ( rte_eal_remote_launch(isend, &ispars, cpu_right_sender) )
-          std::cout << "Error: could not Initiator's Sender." << std::endl;
-  
-      } else { // use multiple source and/or destination IP addresses (because ip_varies OR enumerate_ips)
-
-        // initialize the parameter class instance for preliminary phase
-        imspars=imSenderParameters(&scp1,ip_right_version,pkt_pool_right_sender,rightport,"Preliminary",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
-                                   ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,
-                                   ip_right_varies,ip_left_varies,ip_right_min,ip_right_max,ip_left_min,ip_left_max,
-                                   ipv4_right_offset,ipv4_left_offset,ipv6_right_offset,ipv6_left_offset,
-                                   rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max,
-                                   enumerate_ips,enumerate_ports,pre_frames,uniqueIpComb,uniqueFtComb);
-
-        // start right sender
-        if ( rte_eal_remote_launch(imsend, &imspars, cpu_right_sender) )
-          std::cout << "Error: could not Initiator's Sender." << std::endl;
-      }
-
-      // set parameters for the left receiver
-      rrpars1=rReceiverParameters(finish_receiving_pre,leftport,"Preliminary",state_table_size,&valid_entries,&stateTable); 
-
-      // start left receiver
-      if ( rte_eal_remote_launch(rreceive, &rrpars1, cpu_left_receiver) )
-        std::cout << "Error: could not start Responder's Receiver." << std::endl;
-
-      now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-      std::cout << "Info: Preliminary frame sending initiated at " << std::put_time(localtime(&now), "%F %T") << std::endl;
-
-      // wait until active senders and receivers finish
-      rte_eal_wait_lcore(cpu_right_sender);
-      rte_eal_wait_lcore(cpu_left_receiver);
-      
-      if ( valid_entries < state_table_size )
-        printf("Error: Failed to fill state table (valid entries: %u, state table size: %u)!\n", valid_entries, state_table_size);
-      else
-        std::cout << "Info: Preliminary phase finished." << std::endl;
 
       // Now the real test may follow.
 
       // set "common" parameters
-      scp2=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc);
+      scp2=senderCommonParameters(ipv6_frame_size,ipv4_frame_size,frame_rate,duration,n,m,hz,start_tsc,responder_echo,&popularity,0,tcp ? RTE_TCP_ACK_FLAG : 0);
+      scp2.max_lateness = (uint64_t)max_lateness*hz/1000000; // 'Max-lateness' in TSC cycles
 
       if ( reverse ) {  // Right to Left direction is active
 
@@ -4052,7 +6594,7 @@ void Throughput::measure(uint16_t leftport, uint16_t rightport) {
           // initialize the parameter class instance
           mspars2=mSenderParameters(&scp2,ip_right_version,pkt_pool_right_sender,rightport,"Reverse",(ether_addr *)mac_right_dut,(ether_addr *)mac_right_tester,
                                     ipq.src_ipv4,ipq.dst_ipv4,ipq.src_ipv6,ipq.dst_ipv6,&ipv6_right_real,&ipv6_left_real,
-                                    ip_right_varies,ip_left_varies,ip_right_min,ip_right_max,ip_left_min,ip_left_max,
+                                    ip_right_varies,ip_left_varies,ip_right_min,ip_right_max,ip_left_min,ip_left_max,ip_right_bits,ip_left_bits,
                                     ipv4_right_offset,ipv4_left_offset,ipv6_right_offset,ipv6_left_offset,
                                     rev_var_sport,rev_var_dport,rev_sport_min,rev_sport_max,rev_dport_min,rev_dport_max);
 
@@ -4061,15 +6603,38 @@ void Throughput::measure(uint16_t leftport, uint16_t rightport) {
             std::cout << "Error: could not start Right Sender." << std::endl;
         }
 
-        // set parameters for the left receiver
-        rrpars2=rReceiverParameters(finish_receiving,leftport,"Reverse",state_table_size,&valid_entries,&stateTable);
+        if ( !responder_echo ) {
+          // set parameters for the left receiver
+          rrpars2=rReceiverParameters(finish_receiving,leftport,"Reverse",state_table_size,&valid_entries,&stateTable);
   
-        // start left receiver
-        if ( rte_eal_remote_launch(rreceive, &rrpars2, cpu_left_receiver) )
-          std::cout << "Error: could not start Responder's Receiver." << std::endl;
+          // start left receiver
+          if ( rte_eal_remote_launch(rreceive, &rrpars2, cpu_left_receiver) )
+            std::cout << "Error: could not start Responder's Receiver." << std::endl;
+        } else {
+          // set parameters for the left receiver, which also prepares the echo replies
+          rrepars=rReceiverParametersEcho(finish_receiving,leftport,"Reverse",state_table_size,&valid_entries,&stateTable,echo_ring);
+
+          // start left receiver
+          if ( rte_eal_remote_launch(rreceiveEcho, &rrepars, cpu_left_receiver) )
+            std::cout << "Error: could not start Responder's Receiver." << std::endl;
+        }
       }
 
-      if ( forward ) {  // Left to right direction is active
+      if ( forward && responder_echo ) {  // Left to right direction carries the echo replies
+        // set parameters for the left sender
+        rsepars=rSenderParametersEcho(finish_receiving,leftport,"Forward",echo_ring);
+
+        // start left sender
+        if ( rte_eal_remote_launch(rsendEcho, &rsepars, cpu_left_sender) )
+          std::cout << "Error: could not start Left Sender." << std::endl;
+
+        // set parameters for the right receiver
+        repars=receiverParametersEcho(finish_receiving,rightport,"Forward",hz,fg_frames);
+
+        // start right receiver
+        if ( rte_eal_remote_launch(receiveEcho, &repars, cpu_right_receiver) )
+          std::cout << "Error: could not start Right Receiver." << std::endl;
+      } else if ( forward ) {  // Left to right direction is active
         // set individual parameters for the left sender
 
         // first, collect the appropriate values dependig on the IP versions
@@ -4099,19 +6664,635 @@ void Throughput::measure(uint16_t leftport, uint16_t rightport) {
 
       // wait until active senders and receivers finish
       if ( reverse ) {
-        rte_eal_wait_lcore(cpu_right_sender);
-        rte_eal_wait_lcore(cpu_left_receiver);
+        slow_senders += rte_eal_wait_lcore(cpu_right_sender) != 0;
+        rev_received = rte_eal_wait_lcore(cpu_left_receiver);
       }
       if ( forward ) {
-        rte_eal_wait_lcore(cpu_left_sender);
-        rte_eal_wait_lcore(cpu_right_receiver);
+        slow_senders += rte_eal_wait_lcore(cpu_left_sender) != 0;
+        val_received = fwd_received = rte_eal_wait_lcore(cpu_right_receiver);
       }
+      rte_free(spars2.net_sent); // the per network counters of send() are reported in stateless tests only
       std::cout << "Info: Test finished." << std::endl;
       break;
       }
   }
 }
 
+// the frame rate of a sender, which sends foreground frames of the given IP version: with 'IMIX-bps', the frame rate is calculated
+// from the IPv6 frame sizes, but the IPv4 foreground frames are 20 bytes shorter, thus more of them are needed for the same bit rate
+uint32_t Throughput::senderFrameRate(int ip_version) {
+  if ( !imix.bps || ip_version != 4 )
+    return frame_rate;
+  return (uint64_t)imix.bit_rate*1000000*imix.period*n/(imix.periodBits()*n-(uint64_t)imix.period*20*8*m);
+}
+
+// prepares the pre-materialized traffic schedule of a sender (Schedule 1) and reports its memory needs
+// return: the schedule, or 0, if the sender has to compute the frames during sending
+trafficSchedule *Throughput::makeSchedule(const mSenderParameters *p, int cpu_sender, int cpu_helper) {
+  uint64_t frames = (uint64_t)duration*senderFrameRate(p->ip_version);	// number of frames to be sent
+  uint64_t needed = trafficSchedule::memory(frames);	// memory needed for the whole schedule
+  bool chunked = needed > (uint64_t)schedule_memory*1024*1024;
+
+  if ( !chunked ) {
+    printf("Info: %s traffic schedule of %lu frames needs %.1lf MB memory.\n", p->side, frames, needed/1048576.0);
+  } else if ( cpu_helper >= 0 ) {
+    printf("Info: %s traffic schedule of %lu frames would need %.1lf MB memory, it is generated by a helper lcore in chunks using %.1lf MB memory.\n",
+           p->side, frames, needed/1048576.0, trafficSchedule::memory(2*SCHEDULE_CHUNK)/1048576.0);
+  } else {
+    printf("Warning: %s traffic schedule of %lu frames would need %.1lf MB memory (more than 'Schedule-memory') and no helper lcore was specified, "
+           "the frames are computed during sending.\n", p->side, frames, needed/1048576.0);
+    return 0;
+  }
+  return new trafficSchedule(p, frames, chunked ? 2*SCHEDULE_CHUNK : frames, rte_lcore_to_socket_id(cpu_sender));
+}
+
+// runs the DUT reset command (if specified) to clear the connections created by the previous step of a search
+void Throughput::resetDut() {
+  int ret;	// return value of the command
+
+  if ( !dut_reset[0] )
+    return;
+  std::cout << "Info: Resetting the DUT using the command: " << dut_reset << std::endl;
+  if ( (ret = system(dut_reset)) != 0 )
+    std::cout << "Warning: DUT reset command returned " << ret << "." << std::endl;
+}
+
+// prepares the k-th repetition of the measurement (siitperf-lat and siitperf-pdv): like the steps of the searches,
+// the DUT is reset, and the state table is allocated again by the preliminary phase (the timestamps are set by measure())
+void Throughput::prepareRepetition(unsigned k) {
+  repetition = k;
+  if ( repetitions == 1 )
+    return;
+  if ( k > 1 ) {
+    resetDut();
+    if ( search_sleep )
+      sleep(search_sleep);	// give the DUT a chance to relax
+    if ( stateTable ) {
+      rte_free(stateTable);
+      stateTable = 0;
+    }
+    valid_entries = 0;		// indicates the preliminary phase for rreceive and rsend
+  }
+  printf("Info: Repetition %u of %u.\n", k, repetitions);
+}
+
+// returns the highest number of connections, for which unique 4-tuples can be provided by the Initiator
+uint32_t Throughput::maxConnections() {
+  uint64_t c = UINT32_MAX;	// no limit, if enumeration is not used
+
+  if ( enumerate_ports && !enumerate_ips ) {
+    if ( stateful == 1 )
+      c = (uint64_t)(fwd_sport_max-fwd_sport_min+1)*(fwd_dport_max-fwd_dport_min+1);
+    else // sateful is 2
+      c = (uint64_t)(rev_sport_max-rev_sport_min+1)*(rev_dport_max-rev_dport_min+1);
+  }
+  if ( enumerate_ips && !enumerate_ports )
+    c = mulSat(ip_left_max-ip_left_min+1, ip_right_max-ip_right_min+1);
+  if ( enumerate_ips && enumerate_ports ) {
+    if ( stateful == 1 )
+      c = mulSat(mulSat(ip_left_max-ip_left_min+1, ip_right_max-ip_right_min+1), (uint64_t)(fwd_sport_max-fwd_sport_min+1)*(fwd_dport_max-fwd_dport_min+1));
+    else // sateful is 2
+      c = mulSat(mulSat(ip_left_max-ip_left_min+1, ip_right_max-ip_right_min+1), (uint64_t)(rev_sport_max-rev_sport_min+1)*(rev_dport_max-rev_dport_min+1));
+  }
+  return c < UINT32_MAX ? c : UINT32_MAX;
+}
+
+// counts the distinct 4-tuples among the valid entries of the state table of the Responder
+uint32_t Throughput::distinctTuples() {
+  uint32_t i, distinct;
+  fourTuple ft;
+  std::pair<uint64_t,uint32_t> *tuples; // addresses and port numbers of the 4-tuples packed for sorting
+
+  if ( !valid_entries )
+    return 0;
+  tuples = new std::pair<uint64_t,uint32_t>[valid_entries];
+  if ( !tuples )
+    rte_exit(EXIT_FAILURE, "Error: Tester can't allocate memory for counting distinct 4-tuples!\n");
+  for ( i=0; i<valid_entries; i++ ) {
+    ft = stateTable[i]; // atomic read
+    tuples[i] = std::make_pair((uint64_t)ft.init_addr<<32 | ft.resp_addr, (uint32_t)ft.init_port<<16 | ft.resp_port);
+  }
+  std::sort(tuples,tuples+valid_entries);
+  distinct = std::unique(tuples,tuples+valid_entries)-tuples;
+  delete[] tuples;
+  return distinct;
+}
+
+// performs a single step of the in-process searches: the preliminary phase creates 'c' connections at rate 'r',
+// Search-mode 1: then the Responder validates them by sending test frames using the 4-tuples learnt (validation rate: r*alpha/100)
+// Search-mode 2: no test phase follows, the connections are validated by the distinct 4-tuples learnt by the Responder
+// the EAL, the ports, the packet pools and the pre-generated unique combinations are reused, only the state table is reallocated
+// returns 1, if all preliminary frames were received and the validation was successful; 0 otherwise
+int Throughput::searchStep(uint16_t leftport, uint16_t rightport, uint32_t c, uint32_t r) {
+  uint32_t vr = (uint64_t)r*search_alpha/100;	// validation rate
+  uint64_t d = c/(vr ? vr : 1)+1;		// duration of the validation (there is some extra time)
+  uint32_t distinct;				// number of distinct 4-tuples learnt by the Responder
+
+  if ( search_mode == 1 && (vr < 1 || vr > (max_frame_rate ? max_frame_rate : MAX_FRAME_RATE) || d > 3600) ) {
+    printf("Warning: Step with C: %u, R: %u skipped: validation rate %u or duration %lu is out of range, the step is failed.\n", c, r, vr, d);
+    return 0;
+  }
+  resetDut();
+  pre_frames = eff_pre_frames = state_table_size = c;
+  pre_rate = r;
+  frame_rate = vr;
+  duration = d;
+  pre_delay = (uint64_t)1000*c/r + 2*pre_timeout;
+  if ( stateTable ) {
+    rte_free(stateTable);	// the state table is allocated again by rreceive, its size may be different
+    stateTable = 0;
+  }
+  valid_entries = 0;		// indicates the preliminary phase for rreceive and rsend
+  setTimestamps();
+  if ( search_mode == 2 ) {
+    std::cout << "Info: Search step: C: " << c << ", R: " << r << std::endl;
+    preliminaryPhase(leftport, rightport);
+    distinct = distinctTuples();
+    std::cout << "Info: Search step: distinct 4-tuples learnt by the Responder: " << distinct << std::endl;
+    if ( search_sleep )
+      sleep(search_sleep);	// give the DUT a chance to relax
+    if ( pre_received != c || distinct != c ) {
+      std::cout << "Info: Search step: preliminary phase FAILED." << std::endl;
+      return 0;
+    }
+    std::cout << "Info: Search step: PASSED." << std::endl;
+    return 1;
+  }
+  std::cout << "Info: Search step: C: " << c << ", R: " << r << ", validation rate: " << vr << ", duration: " << d << ", D: " << pre_delay << std::endl;
+  measure(leftport, rightport);
+  if ( search_sleep )
+    sleep(search_sleep);	// give the DUT a chance to relax
+  if ( pre_received != c || valid_entries != c ) {
+    std::cout << "Info: Search step: preliminary phase FAILED." << std::endl;
+    return 0;
+  }
+  if ( val_received != d*vr ) {
+    std::cout << "Info: Search step: validation FAILED." << std::endl;
+    return 0;
+  }
+  std::cout << "Info: Search step: PASSED." << std::endl;
+  return 1;
+}
+
+// binary search for the maximum connection establishment rate using 'c' connections in the [0, h] interval
+// if a step fails at a rate below 'stoprate', the search exits early
+// returns the highest rate at which the step passed (0, if none)
+uint32_t Throughput::searchRate(uint16_t leftport, uint16_t rightport, uint32_t c, uint32_t h, uint32_t stoprate) {
+  uint32_t l = 0;	// lower bound
+  uint32_t r;		// rate to be tested
+  uint32_t result = 0;	// the highest rate passed
+
+  while ( h-l > search_r_error ) {
+    r = l+(h-l)/2;
+    if ( searchStep(leftport, rightport, c, r) )
+      l = result = r;	// the upper half interval is chosen
+    else {
+      h = r;		// the lower half interval is chosen
+      if ( r < stoprate ) {
+        std::cout << "Info: " << r << " is under the stop rate " << stoprate << ", the binary search exits." << std::endl;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+// connection tracking table capacity measurement (RFC 9693) performed in a single process (see scripts/cttc.sh):
+// an initial binary search for R0 using C0 connections, an exponential search for the order of magnitude of the capacity,
+// and a final binary search for the capacity; the command line parameters 'N' and 'R' are used as C0 and the upper bound of R
+void Throughput::cttcSearch(uint16_t leftport, uint16_t rightport) {
+  uint32_t c0 = pre_frames;		// beginning safe value for the size of the connection tracking table
+  uint32_t c_max = maxConnections();	// the number of unique 4-tuples may limit the search
+  uint32_t cs, ct, c;			// safe, examined, and current number of connections
+  uint32_t r0, rs, rt, r;		// rates belonging to the above values
+
+  if ( c0 > c_max ) {
+    std::cout << "Error: C0 (" << c0 << ") is higher than the number of unique combinations (" << c_max << ")." << std::endl;
+    freeUniqueCombinations();
+    return;
+  }
+  r0 = searchRate(leftport, rightport, c0, pre_rate, 0);
+  printf("Info: CTTC initial binary search: C0: %u, R0: %u\n", c0, r0);
+  if ( !r0 ) {
+    std::cout << "Error: CTTC search failed: no rate passed with C0 connections." << std::endl;
+    freeUniqueCombinations();
+    return;
+  }
+
+  // exponential search: the capacity will be between CS and CT
+  for ( cs=c0, rs=r0; ; cs=ct, rs=rt ) {
+    if ( cs == c_max ) {
+      printf("Warning: the number of unique combinations (%u) limits the CTTC search.\n", c_max);
+      ct = cs;
+      break;
+    }
+    ct = (uint64_t)2*cs < c_max ? 2*cs : c_max;
+    rt = searchRate(leftport, rightport, ct, rs, (uint64_t)rs*search_beta/100);
+    printf("Info: CTTC exponential search: CS: %u, RS: %u, CT: %u, RT: %u\n", cs, rs, ct, rt);
+    if ( rt < (uint64_t)rs*search_beta/100 || !rt )
+      break;
+  }
+  printf("Info: CTTC exponential search finished: %u <= C < %u\n", cs, ct);
+
+  // final binary search for the capacity
+  while ( ct-cs > search_c_error ) {
+    c = cs+(ct-cs)/2;
+    r = searchRate(leftport, rightport, c, rs, (uint64_t)rs*search_gamma/100);
+    printf("Info: CTTC final binary search: CS: %u, C: %u, CT: %u, R: %u\n", cs, c, ct, r);
+    if ( r < (uint64_t)rs*search_gamma/100 || !r )
+      ct = c;		// the lower half interval is chosen
+    else {
+      cs = c;		// the upper half interval is chosen
+      rs = r;
+    }
+  }
+  printf("CTTC: %u\n", cs);
+  printf("CTTC rate: %u\n", rs);
+  freeUniqueCombinations();
+}
+
+// maximum connection establishment rate measurement performed in a single process (see scripts/binary-rate-alg.sh-R):
+// binary search for 'R' in the [0, R] interval using 'N' connections, only the preliminary phase is performed in each step
+void Throughput::rateSearch(uint16_t leftport, uint16_t rightport) {
+  uint32_t c = pre_frames;	// number of connections
+  uint32_t r;			// result
+
+  if ( c > maxConnections() ) {
+    std::cout << "Error: N (" << c << ") is higher than the number of unique combinations (" << maxConnections() << ")." << std::endl;
+    freeUniqueCombinations();
+    return;
+  }
+  r = searchRate(leftport, rightport, c, pre_rate, 0);
+  printf("Maximum connection establishment rate: %u\n", r);
+  freeUniqueCombinations();
+}
+
+// self-calibration of the Tester (Calibrate 1): binary search for the highest frame rate in the [0, frame_rate] interval,
+// at which the Tester can send and receive all the test frames of the given configuration, while the forwarder replaces the DUT;
+// a step is passed, if all the senders kept the frame rate and all the test frames (and preliminary frames) were received
+void Throughput::calibrationSearch(uint16_t leftport, uint16_t rightport) {
+  uint32_t l = 0;		// lower bound
+  uint32_t h = frame_rate;	// upper bound (the frame rate specified in the command line)
+  uint32_t r;			// rate to be tested
+  uint32_t result = 0;		// the highest rate passed
+  uint64_t expected;		// number of test frames to be received in each active direction
+  forwarderParameters fpars(calibration_ring);
+
+  if ( rte_eal_remote_launch(calibrationForwarder, &fpars, cpu_forwarder) ) {
+    std::cout << "Error: could not start the Forwarder." << std::endl;
+    return;
+  }
+  while ( h-l > search_r_error ) {
+    r = l+(h-l)/2;
+    frame_rate = r;
+    expected = (uint64_t)duration*r;
+    if ( stateful ) {
+      if ( stateTable ) {
+        rte_free(stateTable);	// the state table is allocated again by rreceive in the preliminary phase
+        stateTable = 0;
+      }
+      valid_entries = 0;	// indicates the preliminary phase for rreceive and rsend
+    }
+    drainCalibration(&fpars);
+    std::cout << "Info: Calibration step: frame rate: " << r << std::endl;
+    setTimestamps();
+    measure(leftport, rightport);
+    if ( slow_senders ) {
+      std::cout << "Info: Calibration step: FAILED, " << slow_senders << " sender(s) could not keep the frame rate." << std::endl;
+      h = r;
+    } else if ( stateful && ( pre_received != pre_frames || valid_entries != state_table_size ) ) {
+      std::cout << "Info: Calibration step: preliminary phase FAILED." << std::endl;
+      h = r;
+    } else if ( forward && fwd_received != expected || reverse && rev_received != expected ) {
+      std::cout << "Info: Calibration step: FAILED, frames were lost." << std::endl;
+      h = r;
+    } else {
+      std::cout << "Info: Calibration step: PASSED." << std::endl;
+      l = result = r;
+    }
+    if ( search_sleep )
+      sleep(search_sleep);
+  }
+  fpars.stop = true;
+  rte_eal_wait_lcore(cpu_forwarder);
+  printf("Info: Forwarder: %lu frames forwarded, %lu frames dropped.\n", fpars.forwarded, fpars.dropped);
+  printf("Maximum frame rate of the Tester: %u\n", result);
+  freeUniqueCombinations();
+}
+
+// waits until the forwarder is idle (the TX rings are empty and the burst being forwarded is surely completed), then frees
+// the frames left in the RX rings: the late frames of a slow or failed calibration step are not counted by the next step
+void Throughput::drainCalibration(forwarderParameters *fp) {
+  struct rte_mbuf *pkt_mbufs[MAX_PKT_BURST]; // pointers for the mbufs of the dropped frames
+  unsigned frames;
+  uint64_t rounds, drained=0;
+
+  while ( !rte_ring_empty(calibration_ring[0]) || !rte_ring_empty(calibration_ring[2]) ); // Beware: busy waiting
+  rounds = fp->rounds.load(std::memory_order_acquire);
+  while ( fp->rounds.load(std::memory_order_acquire) < rounds+2 ); // a whole round started after the rings became empty
+  for ( int d=1; d<4; d+=2 ) // the receivers are not running, thus their rings can be read here
+    while ( (frames = rte_ring_sc_dequeue_burst(calibration_ring[d], (void **)pkt_mbufs, MAX_PKT_BURST, 0)) ) {
+      drained += frames;
+      for ( unsigned i=0; i<frames; i++ )
+        rte_pktmbuf_free(pkt_mbufs[i]);
+    }
+  if ( drained )
+    printf("Info: Calibration: %lu frames left from the previous step were dropped.\n", drained);
+}
+
+// releases the arrays of the pre-generated unique combinations: they are reused by the preliminary phases of all the steps
+// of a search (or of all the repetitions), thus they are freed only once, when the search or the measurements are finished
+void Throughput::freeUniqueCombinations() {
+  if ( uniquePortComb )
+    rte_free(uniquePortComb);	// free the array for pre-generated unique port number combinations
+  if ( uniqueIpComb )
+    rte_free(uniqueIpComb);	// free the array for pre-generated unique IP address combinations
+  if ( uniqueFtComb )
+    rte_free(uniqueFtComb);	// free the array for pre-generated unique 4-tuple combinations
+  uniquePortComb = 0;
+  uniqueIpComb = 0;
+  uniqueFtComb = 0;
+}
+
+
+// seeds the lanes with the consecutive outputs of splitmix64 as recommended by the authors of xoshiro256**
+fastRandom::fastRandom(uint64_t seed) {
+  for ( int j=0; j<4; j++ )
+    for ( int l=0; l<RANDOM_LANES; l++ ) {
+      uint64_t z = (seed += 0x9e3779b97f4a7c15);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      s[j][l] = z ^ (z >> 31);
+    }
+}
+
+// chooses the number of bits of the Feistel network and its pseudorandom round keys
+randomPermutation::randomPermutation(uint64_t size_, uint64_t seed) {
+  fastRandom gen(seed);
+  unsigned bits;
+
+  size = size_;
+  for ( bits=2; bits<64 && ( !size || (size-1) >> bits ); bits+=2 );	// smallest even number of bits covering size
+  half = bits/2;
+  mask = (1ull << half) - 1;
+  for ( int i=0; i<PERMUTATION_ROUNDS; i++ )
+    key[i] = gen();
+  next = 0;
+}
+
+// sets the values of the data fields
+// IMIX is not used by default
+imixParameters::imixParameters() {
+  sizes = 0;
+  bps = 0;
+  bit_rate = 0;
+  period = 0;
+}
+
+// builds the precomputed pseudorandom order of the size classes and the lookup table of the receivers
+void imixParameters::prepare() {
+  unsigned k = 0;	// index in the order
+  for ( unsigned i=0; i<sizes; i++ )
+    for ( unsigned j=0; j<weight[i]; j++ )
+      order[k++] = i;
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::shuffle(order, order+period, gen);
+  memset(class_of, IMIX_MAX_SIZES, sizeof(class_of));
+  for ( unsigned i=0; i<sizes; i++ )
+    class_of[size[i]] = i;
+}
+
+// the number of bits of an IMIX period on the wire: IPv6 frames with preamble, SFD and IFG (IPv4 frames are 20 bytes shorter)
+uint64_t imixParameters::periodBits() {
+  uint64_t bits = 0;
+  for ( unsigned i=0; i<sizes; i++ )
+    bits += (uint64_t)weight[i]*(size[i]+20)*8;
+  return bits;
+}
+
+popularityParameters::popularityParameters(unsigned type_, double zipf_s_, unsigned hot_values_, unsigned hot_share_) {
+  type = type_;
+  zipf_s = zipf_s_;
+  hot_values = hot_values_;
+  hot_share = hot_share_;
+}
+popularityParameters::popularityParameters()
+{
+}
+
+// builds the alias table (Vose's method) for the popularity distribution over [min_, max_]
+// the lowest values are the most popular ones; no table is built for the uniform distribution (pp == 0 or pp->type == 0)
+// the table is allocated from the memory of the NUMA node of the calling lcore (the sender)
+popularityDistribution::popularityDistribution(uint32_t min_, uint32_t max_, const popularityParameters *pp) : uniform(min_, max_) {
+  uint32_t i, hot, s, l;
+  double sum;
+
+  min = min_;
+  size = max_-min_+1;
+  prob = alias = 0;
+  if ( !pp || !pp->type || size < 2 )
+    return;	// uniform distribution
+  prob = (uint32_t *) rte_malloc("Alias table probabilities", sizeof(uint32_t)*size, 128);
+  alias = (uint32_t *) rte_malloc("Alias table aliases", sizeof(uint32_t)*size, 128);
+  double *w = new double[size];	// weights, then scaled probabilities
+  uint32_t *small = new uint32_t[size], *large = new uint32_t[size]; // work lists of Vose's method
+  if ( !prob || !alias || !w || !small || !large )
+    rte_exit(EXIT_FAILURE, "Error: Sender can't allocate memory for the alias table of the popularity distribution!\n");
+
+  // calculate the weights
+  if ( pp->type == 1 ) { 
+    for ( i=0; i<size; i++ )
+      w[i] = 1.0/pow(i+1,pp->zipf_s);	// Zipf
+  } else {
+    hot = (uint64_t)size*pp->hot_values/100;	// size of the hot set
+    if ( !hot )
+      hot = 1;
+    if ( hot >= size )
+      hot = size-1;
+    for ( i=0; i<size; i++ )
+      w[i] = i < hot ? pp->hot_share/100.0/hot : (100-pp->hot_share)/100.0/(size-hot);	// hot set
+  }
+  for ( sum=0, i=0; i<size; i++ )
+    sum += w[i];
+
+  // build the alias table: each index keeps its own probability and gives the rest to its alias 
+  for ( s=l=0, i=0; i<size; i++ ) {
+    w[i] *= size/sum;	// scale so that the average is 1
+    if ( w[i] < 1.0 )
+      small[s++] = i;
+    else
+      large[l++] = i;
+  }
+  while ( s && l ) {
+    uint32_t a = small[--s], g = large[--l];
+    prob[a] = (uint32_t) (w[a]*4294967296.0);
+    alias[a] = g;
+    w[g] -= 1.0-w[a];
+    if ( w[g] < 1.0 )
+      small[s++] = g;
+    else
+      large[l++] = g;
+  }
+  while ( l ) {
+    i = large[--l];
+    prob[i] = UINT32_MAX;	// (practically) always kept
+    alias[i] = i;
+  }
+  while ( s ) {
+    i = small[--s];	// only due to rounding errors
+    prob[i] = UINT32_MAX;
+    alias[i] = i;
+  }
+  delete[] w;
+  delete[] small;
+  delete[] large;
+}
+popularityDistribution::~popularityDistribution() {
+  rte_free(prob);
+  rte_free(alias);
+}
+
+// prepares the generation of a traffic schedule, the records are stored on the NUMA node of the sender
+trafficSchedule::trafficSchedule(const mSenderParameters *p, uint64_t frames_, uint64_t slots_, int socket) :
+  gen_sip(std::random_device()()), gen_dip(std::random_device()()), gen_sport(std::random_device()()), gen_dport(std::random_device()()),
+  uni_dis_sip(p->sip_min, p->sip_max, p->var_sip == 3 ? p->cp->popularity : 0),
+  uni_dis_dip(p->dip_min, p->dip_max, p->var_dip == 3 ? p->cp->popularity : 0),
+  uni_dis_sport(p->sport_min, p->sport_max, p->var_sport == 3 ? p->cp->popularity : 0),
+  uni_dis_dport(p->dport_min, p->dport_max, p->var_dport == 3 ? p->cp->popularity : 0) {
+  ip_version = p->ip_version;
+  n = p->cp->n;
+  m = p->cp->m;
+  imix = p->cp->imix;
+  var_sip = p->var_sip;
+  var_dip = p->var_dip;
+  var_sport = p->var_sport;
+  var_dport = p->var_dport;
+  sip_min = p->sip_min;
+  sip_max = p->sip_max;
+  dip_min = p->dip_min;
+  dip_max = p->dip_max;
+  sport_min = p->sport_min;
+  sport_max = p->sport_max;
+  dport_min = p->dport_min;
+  dport_max = p->dport_max;
+  // set the starting values of the fields, if they are increased or decreased
+  src_ip = var_sip == 2 ? sip_max : sip_min;
+  dst_ip = var_dip == 2 ? dip_max : dip_min;
+  sport = var_sport == 2 ? sport_max : sport_min;
+  dport = var_dport == 2 ? dport_max : dport_min;
+  generated = 0;
+
+  frames = frames_;
+  slots = slots_;
+  chunked = slots < frames;
+  records = (scheduleRecord *) rte_malloc_socket("traffic schedule", memory(slots), 64, socket);
+  if ( !records )
+    rte_exit(EXIT_FAILURE, "Error: Cannot allocate %lu bytes for a traffic schedule.\n", memory(slots));
+  memset(fg_ipv4_chksum_start, 0, sizeof(fg_ipv4_chksum_start));
+  memset(fg_udp_chksum_start, 0, sizeof(fg_udp_chksum_start));
+  memset(bg_udp_chksum_start, 0, sizeof(bg_udp_chksum_start));
+  started = false;
+  produced = 0;
+  consumed = 0;
+}
+
+trafficSchedule::~trafficSchedule() {
+  rte_free(records);
+}
+
+// generates the next 'count' records: the fields are set and the checksums are calculated like in msend()
+void trafficSchedule::generate(uint64_t count) {
+  scheduleRecord *r; // the current record
+  bool fg_frame, ipv4_frame; // when sending IPv4 traffic, bacground frames are IPv6: they have no IPv4 checksum
+  uint32_t v4_chksum; // temporary variable for IPv4 checksum calculation
+  uint32_t ip_chksum; // temporary variable: stores only the accumulated value from the 16-bit IP address fields
+  uint32_t chksum; // temporary variable for UDP checksum calculation
+  uint16_t sip, dip, sp, dp; // temporary values of the fields
+  unsigned c; // frame size class
+
+  for ( uint64_t last = generated+count; generated < last; generated++ ) {
+    r = records + generated % slots;
+    r->fg = fg_frame = generated % n < m;
+    r->size = c = imix ? imix->order[generated % imix->period] : 0;
+    ipv4_frame = ip_version == 4 && fg_frame;
+    ip_chksum = 0;
+    if ( var_sip ) {
+      switch ( var_sip ) {
+        case 1:                   // increasing 
+          if ( (sip=src_ip++) == sip_max )
+            src_ip = sip_min;
+          break;
+        case 2:                   // decreasing 
+          if ( (sip=src_ip--) == sip_min )
+            src_ip = sip_max;
+          break;
+        case 3:                   // pseudorandom 
+          sip = uni_dis_sip(gen_sip);
+      }
+      ip_chksum += r->sip = htons(sip);
+    }
+    if ( var_dip ) {
+      switch ( var_dip ) {
+        case 1:                   // increasing
+          if ( (dip=dst_ip++) == dip_max )
+            dst_ip = dip_min;
+          break;
+        case 2:                   // decreasing
+          if ( (dip=dst_ip--) == dip_min )
+            dst_ip = dip_max;
+          break;
+        case 3:                   // pseudorandom
+          dip = uni_dis_dip(gen_dip);
+      }
+      ip_chksum += r->dip = htons(dip);
+    }
+    if ( ipv4_frame ) {
+      // only the IPv4 header contains IP checksum
+      v4_chksum = fg_ipv4_chksum_start[c] + ip_chksum;
+      v4_chksum = ((v4_chksum & 0xffff0000) >> 16) + (v4_chksum & 0xffff);   	// calculate 16-bit one's complement sum
+      v4_chksum = ((v4_chksum & 0xffff0000) >> 16) + (v4_chksum & 0xffff);   	// twice is enough: 2*0xffff=0x1fffe, 0x1+x0fffe=0xffff
+      r->ipv4_chksum = (~v4_chksum) & 0xffff;                               	// make one's complement
+    }
+    chksum = (fg_frame ? fg_udp_chksum_start[c] : bg_udp_chksum_start[c]) + ip_chksum; // UDP checksum contains the pseudo header
+    if ( var_sport ) {
+      switch ( var_sport ) {
+        case 1:                   // increasing port numbers
+          if ( (sp=sport++) == sport_max )
+            sport = sport_min;
+          break;
+        case 2:                   // decreasing port numbers
+          if ( (sp=sport--) == sport_min )
+            sport = sport_max;
+          break;
+        case 3:                   // pseudorandom port numbers
+          sp = uni_dis_sport(gen_sport);
+      }
+      chksum += r->sport = htons(sp);
+    }
+    if ( var_dport ) {
+      switch ( var_dport ) {
+        case 1:                   // increasing port numbers
+          if ( (dp=dport++) == dport_max )
+            dport = dport_min;
+          break;
+        case 2:                   // decreasing port numbers
+          if ( (dp=dport--) == dport_min )
+            dport = dport_max;
+          break;
+        case 3:                   // pseudorandom port numbers
+          dp = uni_dis_dport(gen_dport);
+      }
+      chksum += r->dport = htons(dp);
+    }
+    chksum = ((chksum & 0xffff0000) >> 16) + (chksum & 0xffff);   	// calculate 16-bit one's complement sum
+    chksum = ((chksum & 0xffff0000) >> 16) + (chksum & 0xffff);   	// twice is enough: 2*0xffff=0x1fffe, 0x1+x0fffe=0xffff
+    chksum = (~chksum) & 0xffff;                                  	// make one's complement
+    if ( unlikely( ipv4_frame && chksum == 0 ) )  // over IPv4, checksum should not be 0 (0 means, no checksum is used)
+      chksum = 0xffff;
+    r->udp_chksum = (uint16_t) chksum;
+  }
+}
 
 // sets the values of the data fields
 senderCommonParameters::senderCommonParameters(uint16_t ipv6_frame_size_, uint16_t ipv4_frame_size_, uint32_t frame_rate_, uint16_t duration_, 
@@ -4124,6 +7305,25 @@ senderCommonParameters::senderCommonParameters(uint16_t ipv6_frame_size_, uint16
   m = m_;
   hz = hz_;
   start_tsc = start_tsc_;
+  responder_echo = 0;
+  popularity = 0;
+  imix = 0;
+  tcp_flags = 0;
+  max_lateness = 0;
+}
+senderCommonParameters::senderCommonParameters(uint16_t ipv6_frame_size_, uint16_t ipv4_frame_size_, uint32_t frame_rate_, uint16_t duration_,
+                                               uint32_t n_, uint32_t m_, uint64_t hz_, uint64_t start_tsc_, unsigned responder_echo_,
+                                               const popularityParameters *popularity_) :
+  senderCommonParameters(ipv6_frame_size_, ipv4_frame_size_, frame_rate_, duration_, n_, m_, hz_, start_tsc_) {
+  responder_echo = responder_echo_;
+  popularity = popularity_ && popularity_->type ? popularity_ : 0;
+}
+senderCommonParameters::senderCommonParameters(uint16_t ipv6_frame_size_, uint16_t ipv4_frame_size_, uint32_t frame_rate_, uint16_t duration_,
+                                               uint32_t n_, uint32_t m_, uint64_t hz_, uint64_t start_tsc_, unsigned responder_echo_,
+                                               const popularityParameters *popularity_, const imixParameters *imix_, uint8_t tcp_flags_) :
+  senderCommonParameters(ipv6_frame_size_, ipv4_frame_size_, frame_rate_, duration_, n_, m_, hz_, start_tsc_, responder_echo_, popularity_) {
+  imix = imix_ && imix_->sizes ? imix_ : 0;
+  tcp_flags = tcp_flags_;
 }
 senderCommonParameters::senderCommonParameters()
 {
@@ -4133,7 +7333,7 @@ senderCommonParameters::senderCommonParameters()
 senderParameters::senderParameters(class senderCommonParameters *cp_, int ip_version_, rte_mempool *pkt_pool_, uint16_t eth_id_, const char *side_,
                                    struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
                                    struct in6_addr *src_ipv6_, struct in6_addr *dst_ipv6_, struct in6_addr *src_bg_, struct in6_addr *dst_bg_,
-                                   uint16_t num_dest_nets_, unsigned var_sport_, unsigned var_dport_,
+                                   uint32_t num_dest_nets_, unsigned var_sport_, unsigned var_dport_,
                    		   uint16_t sport_min_, uint16_t sport_max_, uint16_t dport_min_, uint16_t dport_max_) {
   cp = cp_;
   ip_version = ip_version_;
@@ -4155,9 +7355,11 @@ senderParameters::senderParameters(class senderCommonParameters *cp_, int ip_ver
   sport_max = sport_max_;
   dport_min = dport_min_;
   dport_max = dport_max_;
+  net_sent = 0;
 }
 senderParameters::senderParameters()
 {
+  net_sent = 0;
 }
 
 // sets the values of the data fields
@@ -4165,7 +7367,7 @@ mSenderParameters::mSenderParameters(class senderCommonParameters *cp_, int ip_v
                                    struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
                                    struct in6_addr *src_ipv6_, struct in6_addr *dst_ipv6_, struct in6_addr *src_bg_, struct in6_addr *dst_bg_,
                                    unsigned var_sip_, unsigned var_dip_,
-                                   uint16_t sip_min_, uint16_t sip_max_, uint16_t dip_min_, uint16_t dip_max_,
+                                   uint64_t sip_min_, uint64_t sip_max_, uint64_t dip_min_, uint64_t dip_max_, unsigned sip_bits_, unsigned dip_bits_,
                                    uint16_t src_ipv4_offset_, uint16_t dst_ipv4_offset_, uint16_t src_ipv6_offset_, uint16_t dst_ipv6_offset_,
                                    unsigned var_sport_, unsigned var_dport_,
                    		   uint16_t sport_min_, uint16_t sport_max_, uint16_t dport_min_, uint16_t dport_max_) {
@@ -4189,6 +7391,8 @@ mSenderParameters::mSenderParameters(class senderCommonParameters *cp_, int ip_v
   sip_max = sip_max_;
   dip_min = dip_min_;
   dip_max = dip_max_;
+  sip_bits = sip_bits_;
+  dip_bits = dip_bits_;
   src_ipv4_offset = src_ipv4_offset_;
   dst_ipv4_offset = dst_ipv4_offset_;
   src_ipv6_offset = src_ipv6_offset_;
@@ -4204,12 +7408,30 @@ mSenderParameters::mSenderParameters()
 {
 }
 
+// sets the values of the data fields
+sSenderParameters::sSenderParameters(const mSenderParameters &msp, trafficSchedule *schedule_) :
+  mSenderParameters(msp) {
+  schedule = schedule_;
+}
+sSenderParameters::sSenderParameters()
+{
+}
+
+// sets the values of the data fields
+pSenderParameters::pSenderParameters(const mSenderParameters &msp, trafficSchedule *schedule_, struct rte_ring *ring_) :
+  sSenderParameters(msp, schedule_) {
+  ring = ring_;
+}
+pSenderParameters::pSenderParameters()
+{
+}
+
 // sets the values of the data fields
 imSenderParameters::imSenderParameters(class senderCommonParameters *cp_, int ip_version_, rte_mempool *pkt_pool_, uint16_t eth_id_, const char *side_,
                                    struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
                                    struct in6_addr *src_ipv6_, struct in6_addr *dst_ipv6_, struct in6_addr *src_bg_, struct in6_addr *dst_bg_,
                                    unsigned var_sip_, unsigned var_dip_,
-                                   uint16_t sip_min_, uint16_t sip_max_, uint16_t dip_min_, uint16_t dip_max_,
+                                   uint64_t sip_min_, uint64_t sip_max_, uint64_t dip_min_, uint64_t dip_max_, unsigned sip_bits_, unsigned dip_bits_,
                                    uint16_t src_ipv4_offset_, uint16_t dst_ipv4_offset_, uint16_t src_ipv6_offset_, uint16_t dst_ipv6_offset_,
                                    unsigned var_sport_, unsigned var_dport_,
                    		   uint16_t sport_min_, uint16_t sport_max_, uint16_t dport_min_, uint16_t dport_max_,
@@ -4235,6 +7457,8 @@ imSenderParameters::imSenderParameters(class senderCommonParameters *cp_, int ip
   sip_max = sip_max_;
   dip_min = dip_min_;
   dip_max = dip_max_;
+  sip_bits = sip_bits_;
+  dip_bits = dip_bits_;
   src_ipv4_offset = src_ipv4_offset_;
   dst_ipv4_offset = dst_ipv4_offset_;
   src_ipv6_offset = src_ipv6_offset_;
@@ -4276,7 +7500,7 @@ iSenderParameters::iSenderParameters()
 rSenderParameters::rSenderParameters(class senderCommonParameters *cp_, int ip_version_, rte_mempool *pkt_pool_, uint16_t eth_id_, const char *side_,
                                      struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
                                      struct in6_addr *src_ipv6_, struct in6_addr *dst_ipv6_, struct in6_addr *src_bg_, struct in6_addr *dst_bg_,
-                                     uint16_t num_dest_nets_, unsigned var_sport_, unsigned var_dport_,
+                                     uint32_t num_dest_nets_, unsigned var_sport_, unsigned var_dport_,
                                      uint16_t sport_min_, uint16_t sport_max_, uint16_t dport_min_, uint16_t dport_max_,
                    		     unsigned state_table_size_, atomicFourTuple *stateTable_, unsigned responder_tuples_) :
   senderParameters(cp_, ip_version_, pkt_pool_, eth_id_, side_, dst_mac_, src_mac_, src_ipv4_, dst_ipv4_, src_ipv6_, dst_ipv6_, src_bg_, dst_bg_,
@@ -4294,11 +7518,35 @@ receiverParameters::receiverParameters(uint64_t finish_receiving_, uint16_t eth_
   finish_receiving=finish_receiving_;
   eth_id = eth_id_;
   side = side_;
+  received = 0;
 }
 receiverParameters::receiverParameters()
 {
 }
 
+// sets the values of the data fields
+receiverParametersImix::receiverParametersImix(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, const imixParameters *imix_) :
+  receiverParameters(finish_receiving_, eth_id_, side_) {
+  imix = imix_;
+  memset(class_received, 0, sizeof(class_received));
+}
+receiverParametersImix::receiverParametersImix()
+{
+}
+
+// sets the values of the data fields
+receiverParametersNets::receiverParametersNets(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, uint32_t num_nets_,
+                                               const uint32_t *ipv4_dst_, const struct in6_addr *ipv6_dst_) :
+  receiverParameters(finish_receiving_, eth_id_, side_) {
+  num_nets = num_nets_;
+  ipv4_dst = ((const uint8_t *)ipv4_dst_)[1] << 8;	// the field of network 0 (see mkDestNets)
+  ipv6_dst = ipv6_dst_->s6_addr[6] << 8;
+  net_received = 0;
+}
+receiverParametersNets::receiverParametersNets()
+{
+}
+
 // sets the values of the data fields
 rReceiverParameters::rReceiverParameters(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, unsigned state_table_size_,
                                          unsigned *valid_entries_, atomicFourTuple **stateTable_) :
@@ -4311,6 +7559,44 @@ rReceiverParameters::rReceiverParameters()
 {
 }
 
+// sets the values of the data fields
+rReceiverParametersEcho::rReceiverParametersEcho(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, unsigned state_table_size_,
+                      unsigned *valid_entries_, atomicFourTuple **stateTable_, struct rte_ring *echo_ring_) :
+  rReceiverParameters(finish_receiving_,eth_id_,side_,state_table_size_,valid_entries_,stateTable_) {
+  echo_ring = echo_ring_;
+}
+rReceiverParametersEcho::rReceiverParametersEcho()
+{
+}
+
+// sets the values of the data fields
+rSenderParametersEcho::rSenderParametersEcho(uint64_t finish_sending_, uint16_t eth_id_, const char *side_, struct rte_ring *echo_ring_) {
+  finish_sending = finish_sending_;
+  eth_id = eth_id_;
+  side = side_;
+  echo_ring = echo_ring_;
+}
+rSenderParametersEcho::rSenderParametersEcho()
+{
+}
+
+// sets the values of the data fields
+forwarderParameters::forwarderParameters(struct rte_ring **rings_) : stop(false), rounds(0) {
+  rings = rings_;
+  forwarded = 0;
+  dropped = 0;
+}
+
+// sets the values of the data fields
+receiverParametersEcho::receiverParametersEcho(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, uint64_t hz_, uint64_t expected_replies_) :
+  receiverParameters(finish_receiving_,eth_id_,side_) {
+  hz = hz_;
+  expected_replies = expected_replies_;
+}
+receiverParametersEcho::receiverParametersEcho()
+{
+}
+
 // collects the apppropriate IP addresses
 // for simplicity, both source and destionation address fields exist in both v4 and v6, but only the appropriate version IP addresses are set, 
 // and not all input parameters are used
@@ -63,11 +63,331 @@ union bits64 {
   uint64_t data;
 };
 
+// xoshiro256** pseudorandom number generator (https://prng.di.unimi.it/) with RANDOM_LANES independent lanes
+// the state is stored in structure of arrays layout, thus the compiler can vectorize the generation of a batch
+// it replaces std::mt19937_64 in the sending loops for speed: each sender seeds its thread_local engines with std::random_device
+class fastRandom {
+  uint64_t s[4][RANDOM_LANES];	// s[j][l] is the j-th state word of lane l
+
+  static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  public:
+  typedef uint64_t result_type;	// makes it usable as a UniformRandomBitGenerator, too
+  static constexpr uint64_t min() { return 0; }
+  static constexpr uint64_t max() { return UINT64_MAX; }
+
+  fastRandom(uint64_t seed);
+
+  // produces a single 64-bit number using lane 0 only
+  inline uint64_t operator()() {
+    uint64_t result = rotl(s[1][0] * 5, 7) * 9;
+    uint64_t t = s[1][0] << 17;
+    s[2][0] ^= s[0][0];
+    s[3][0] ^= s[1][0];
+    s[1][0] ^= s[2][0];
+    s[0][0] ^= s[3][0];
+    s[2][0] ^= t;
+    s[3][0] = rotl(s[3][0], 45);
+    return result;
+  }
+
+  // produces count (a multiple of RANDOM_LANES) 64-bit numbers using all the lanes
+  inline void fill(uint64_t *buf, unsigned count) {
+    for ( unsigned i=0; i<count; i+=RANDOM_LANES )
+      for ( int l=0; l<RANDOM_LANES; l++ ) {
+        buf[i+l] = rotl(s[1][l] * 5, 7) * 9;
+        uint64_t t = s[1][l] << 17;
+        s[2][l] ^= s[0][l];
+        s[3][l] ^= s[1][l];
+        s[1][l] ^= s[2][l];
+        s[0][l] ^= s[3][l];
+        s[2][l] ^= t;
+        s[3][l] = rotl(s[3][l], 45);
+      }
+  }
+};
+
+// draws uniformly distributed pseudorandom values from [min, max] (replaces std::uniform_int_distribution in the sending loops)
+// values are generated in batches of RANDOM_BUFFER using Lemire's nearly divisionless unbiased range reduction
+// (https://arxiv.org/abs/1805.10941) and the sender takes them one by one from the buffer
+class randomRange {
+  uint32_t min;		// the lowest value
+  uint32_t range;	// number of the possible values, 0 means 2^32
+  uint32_t threshold;	// products with lower low half must be rejected to avoid bias: (2^32-range) % range
+  unsigned next;	// index of the next unused value in buf
+  uint32_t buf[RANDOM_BUFFER];	// bounded values ready to be used
+
+  // generates a new batch, the rare rejections are handled in a second (scalar) pass
+  void refill(fastRandom &gen) {
+    uint64_t raw[RANDOM_BUFFER/2];	// each 64-bit number provides two 32-bit ones
+    bool rejected = false;
+    gen.fill(raw, RANDOM_BUFFER/2);
+    for ( int i=0; i<RANDOM_BUFFER; i++ ) {
+      uint64_t m = (uint64_t) (uint32_t) (raw[i/2] >> 32*(i&1)) * range;
+      buf[i] = min + (uint32_t) (m >> 32);
+      rejected |= (uint32_t) m < threshold;
+    }
+    if ( unlikely( rejected ) )
+      for ( int i=0; i<RANDOM_BUFFER; i++ ) {
+        uint64_t m = (uint64_t) (uint32_t) (raw[i/2] >> 32*(i&1)) * range;
+        while ( (uint32_t) m < threshold )
+          m = (uint64_t) (uint32_t) gen() * range;
+        buf[i] = min + (uint32_t) (m >> 32);
+      }
+    next = 0;
+  }
+
+  public:
+  randomRange(uint32_t min_, uint32_t max_) {
+    min = min_;
+    range = max_-min_+1;
+    threshold = range ? (0u-range) % range : 0;
+    next = RANDOM_BUFFER;	// the first call fills the buffer
+  }
+
+  inline uint32_t operator()(fastRandom &gen) {
+    if ( unlikely( next == RANDOM_BUFFER ) ) {
+      if ( unlikely( !range ) ) {	// the full 32-bit range needs no reduction
+        return (uint32_t) gen();
+      }
+      refill(gen);
+    }
+    return buf[next++];
+  }
+};
+
+// draws uniformly distributed pseudorandom values from [min, max] for the 64-bit varying IP address fields
+// (scalar version of the above method using 128-bit products)
+class randomRange64 {
+  uint64_t min;		// the lowest value
+  uint64_t range;	// number of the possible values, 0 means 2^64
+  uint64_t threshold;	// products with lower low half must be rejected to avoid bias: (2^64-range) % range
+
+  public:
+  randomRange64(uint64_t min_, uint64_t max_) {
+    min = min_;
+    range = max_-min_+1;
+    threshold = range ? (0ull-range) % range : 0;
+  }
+
+  inline uint64_t operator()(fastRandom &gen) {
+    if ( unlikely( !range ) )	// the full 64-bit range needs no reduction
+      return gen();
+    unsigned __int128 m = (unsigned __int128) gen() * range;
+    while ( unlikely( (uint64_t) m < threshold ) )
+      m = (unsigned __int128) gen() * range;
+    return min + (uint64_t) (m >> 64);
+  }
+};
+
+// unique pseudorandom permutation of [0, size) computed on the fly, thus it needs no memory even for huge sizes
+// (Enumerate-ips 3 with varying IP address fields wider than 16 bits): the indices are encrypted by a balanced
+// Feistel network over the smallest even number of bits covering size, and the results that fall outside
+// of [0, size) are encrypted again and again until they get inside (cycle walking)
+class randomPermutation {
+  uint64_t size;	// number of the elements, 0 means 2^64
+  unsigned half;	// number of bits of a half block
+  uint64_t mask;	// mask of a half block
+  uint64_t key[PERMUTATION_ROUNDS];	// round keys
+  uint64_t next;	// the index of the next element
+
+  inline uint64_t encrypt(uint64_t x) const {
+    uint64_t l = x >> half, r = x & mask, f;
+    for ( int i=0; i<PERMUTATION_ROUNDS; i++ ) {
+      f = (r + key[i]) * 0x9e3779b97f4a7c15ull;	// round function: the finalizer of splitmix64
+      f = (f ^ (f >> 30)) * 0xbf58476d1ce4e5b9ull;
+      f = (f ^ (f >> 27)) * 0x94d049bb133111ebull;
+      f ^= f >> 31;
+      f = (l ^ f) & mask;	// the new right half: L xor F(R)
+      l = r;
+      r = f;
+    }
+    return l << half | r;
+  }
+
+  public:
+  randomPermutation(uint64_t size_, uint64_t seed);
+
+  // returns the next element of the permutation
+  inline uint64_t operator()() {
+    uint64_t x = next++;
+    do
+      x = encrypt(x);
+    while ( size && x >= size );
+    return x;
+  }
+};
+
+// to store the parameters of the popularity distribution of pseudorandom port numbers, IP address parts and state table indices
+class popularityParameters {
+  public:
+  // encoding: 0: uniform, 1: Zipf distribution, 2: hot set
+  unsigned type;		// type of the distribution
+  double zipf_s;		// exponent of the Zipf distribution: the i-th most popular value has a weight of 1/i^s
+  unsigned hot_values;		// hot set: this percentage of the values (the lowest ones) ...
+  unsigned hot_share;		// ... is used by this percentage of the frames
+
+  popularityParameters();
+  popularityParameters(unsigned type_, double zipf_s_, unsigned hot_values_, unsigned hot_share_);
+};
+
+// to store the parameters of a frame size mix (IMIX) used instead of the single frame size of the command line
+class imixParameters {
+  public:
+  unsigned sizes;			// number of frame size classes, 0 means that IMIX is not used
+  uint16_t size[IMIX_MAX_SIZES];	// IPv6 frame sizes of the classes (IPv4 frames are 20 bytes shorter)
+  unsigned weight[IMIX_MAX_SIZES];	// weights of the classes
+  unsigned bps;				// 1: the frame rate command line parameter is a bit rate in Mbps
+  uint32_t bit_rate;			// the bit rate in Mbps, including preamble, SFD and IFG (if bps is 1)
+  unsigned period;			// sum of the weights: the length of the precomputed order
+  uint8_t order[IMIX_PERIOD];		// precomputed pseudorandom order of the size classes, it is repeated during sending
+  uint8_t class_of[MAX_FRAME_SIZE+21];	// size class of each IPv6 frame size (IMIX_MAX_SIZES means no class), used by the receivers
+
+  imixParameters();
+  void prepare();
+  uint64_t periodBits();
+};
+
+// draws pseudorandom values from [min, max]: uniformly, or following a skewed popularity distribution
+// using an alias table (built before sending begins), thus the cost of a draw is constant in both cases
+class popularityDistribution {
+  randomRange uniform;	// used for the uniform distribution
+  uint32_t min;		// the lowest value (it is the most popular one)
+  uint32_t size;	// number of the possible values
+  uint32_t *prob;	// alias table: probabilities of keeping the drawn index (scaled to 2^32), 0 means uniform distribution
+  uint32_t *alias;	// alias table: the alias of each index
+
+  public:
+  popularityDistribution(uint32_t min_, uint32_t max_, const popularityParameters *pp);
+  ~popularityDistribution();
+
+  // draws a value: a single 64-bit random number provides both the index and the coin flip
+  inline uint32_t operator()(fastRandom &gen) {
+    if ( likely( !prob ) )
+      return uniform(gen);
+    uint64_t r = gen();
+    uint32_t i = ((r >> 32) * size) >> 32;	// index in [0, size-1] without division
+    return min + ( (uint32_t) r < prob[i] ? i : alias[i] );
+  }
+};
+
+// handles the write after send problem of the senders that rewrite and resend the copies of their pre-generated frames:
+// each transmission takes a reference to the mbuf, which is released by the PMD when it cleans up the TX descriptor,
+// and a copy is rewritten only when the sender holds the only reference to it, thus correctness does not depend on timing.
+// If the PMD does not support rte_eth_tx_done_cleanup(), the references cannot be released on request, then N copies are used
+// and they are rewritten without waiting (like before). The references of the sender are released by the destructor.
+class frameReuse {
+  uint16_t eth_id;	// the port used by the sender
+  bool cleanup;		// the PMD can clean up its TX descriptors on request
+  std::vector<struct rte_mbuf *> frames;	// the copies of the frames of the sender
+
+  public:
+  unsigned copies;	// number of copies to be used of each frame: FRAME_COPIES or N
+
+  frameReuse(uint16_t eth_id_, const char *side);
+  ~frameReuse();
+
+  // registers a newly created copy
+  inline struct rte_mbuf *add(struct rte_mbuf *m) {
+    frames.push_back(m);
+    return m;
+  }
+
+  // waits until the previous transmission of the copy has been completed: only its reference count is read per frame,
+  // the TX descriptors are cleaned up only if the copy is still in flight
+  inline void wait(struct rte_mbuf *m) {
+    if ( likely( cleanup ) && unlikely( rte_mbuf_refcnt_read(m) > 1 ) )
+      reclaim(m);
+  }
+  void reclaim(struct rte_mbuf *m);
+
+  // sends out the copy keeping a reference to it
+  inline void send(struct rte_mbuf *m) {
+    rte_mbuf_refcnt_update(m, 1);	// this one is released by the PMD
+    while ( !rte_eth_tx_burst(eth_id, 0, &m, 1) );
+  }
+};
+
+// adds the difference of the new and old values of two 16-bit words to a raw (uncomplemented) checksum, see RFC 1624
+inline uint16_t adjustChksum(uint16_t chksum, const uint8_t *old_words, const uint8_t *new_words) {
+  uint32_t sum = chksum;
+  sum += (uint16_t)~*(const uint16_t *)old_words + (uint16_t)~*(const uint16_t *)(old_words+2);
+  sum += *(const uint16_t *)new_words + *(const uint16_t *)(new_words+2);
+  sum = ((sum & 0xffff0000) >> 16) + (sum & 0xffff);     // calculate 16-bit one's complement sum
+  sum = ((sum & 0xffff0000) >> 16) + (sum & 0xffff);     // twice is enough
+  return (uint16_t) sum;
+}
+
+// writes the varying field (2, 4 or 8 bytes) of an IP address into the frame in network byte order and returns
+// its contribution to the 16-bit one's complement sum: the field may start at an odd offset (the frames start at even
+// addresses), then its bytes fall into the other halves of the 16-bit words of the checksum, thus the contribution is byte swapped
+inline uint32_t setIpField(uint8_t *field, uint64_t value, unsigned bytes) {
+  uint64_t sum;
+
+  switch ( bytes ) {
+    case 2: {
+      uint16_t v = htons((uint16_t)value);
+      memcpy(field, &v, 2);
+      sum = v;
+      break;
+    }
+    case 4: {
+      uint32_t v = htonl((uint32_t)value);
+      memcpy(field, &v, 4);
+      sum = (v >> 16) + (v & 0xffff);
+      break;
+    }
+    default: {
+      uint64_t v = rte_cpu_to_be_64(value);
+      memcpy(field, &v, 8);
+      sum = (v >> 48) + ((v >> 32) & 0xffff) + ((v >> 16) & 0xffff) + (v & 0xffff);
+    }
+  }
+  sum = ((sum & 0xffff0000) >> 16) + (sum & 0xffff);     // calculate 16-bit one's complement sum
+  sum = ((sum & 0xffff0000) >> 16) + (sum & 0xffff);     // twice is enough: 4*0xffff=0x3fffc, 0x3+0xfffc=0xffff
+  if ( (uintptr_t)field & 1 )
+    sum = ((sum << 8) | (sum >> 8)) & 0xffff;
+  return (uint32_t) sum;
+}
+
+// takes the next digit of the mixed radix representation of v: the digit is the offset from min in [min, min+range-1]
+// (range 0 means 2^64), this is how the elements of a randomPermutation are split into IP address fields and port numbers
+inline uint64_t nextDigit(uint64_t &v, uint64_t min, uint64_t range) {
+  uint64_t d;
+
+  if ( !range ) {
+    d = v;
+    v = 0;
+  } else {
+    d = v % range;
+    v /= range;
+  }
+  return min+d;
+}
+
+// checks if the received frame is a Test Frame: IPv6 or IPv4 carrying UDP (or TCP), and the first 8 bytes of the data are 'IDENTIFY'
+// Offsets from the start of the Ethernet Frame:
+// EtherType: 6+6=12
+// IPv6 Next header: 14+6=20, UDP Data for IPv6: 14+40+8=62
+// IPv4 Protolcol: 14+9=23, UDP Data for IPv4: 14+20+8=42
+// TCP Data (stateful tests with 'TCP 1'): 14+40+20=74 for IPv6, 14+20+20=54 for IPv4
+inline bool isTestFrame(const uint8_t *pkt) {
+  uint64_t id;		// Identificion of the Test Frames
+  memcpy(&id, "IDENTIFY", 8);
+  if ( *(const uint16_t *)&pkt[12]==htons(0x86DD) ) // IPv6
+    return pkt[20]==17 && *(const uint64_t *)&pkt[62]==id || pkt[20]==6 && *(const uint64_t *)&pkt[74]==id;
+  if ( *(const uint16_t *)&pkt[12]==htons(0x0800) ) // IPv4
+    return pkt[23]==17 && *(const uint64_t *)&pkt[42]==id || pkt[23]==6 && *(const uint64_t *)&pkt[54]==id;
+  return false;
+}
+
 // function prepares unique random IP address or port number combinations by enumeration and then random permutation
 void randomPermutation32(bits32 *array, uint16_t src_min, uint16_t src_max, uint16_t dst_min, uint16_t dst_max);
 
 // function prepares unique random IP address and port number combinations by enumeration and then random permutation
-void randomPermutation64(bits32 *array, uint16_t si_min, uint16_t si_max, uint16_t di_min, uint16_t di_max,
+void randomPermutation64(bits64 *array, uint16_t si_min, uint16_t si_max, uint16_t di_min, uint16_t di_max,
                          uint16_t sp_min, uint16_t sp_max, uint16_t dp_min, uint16_t dp_max);
 
 // the main class for siitperf
@@ -97,14 +417,22 @@ public:
 
   int forward, reverse;		// directions are active if non-zero
   int promisc;			// set promiscuous mode 
-  uint16_t num_left_nets, num_right_nets; 	// number of destination networks
+  uint32_t num_left_nets, num_right_nets; 	// number of destination networks
 
   int cpu_left_sender; 		// lcore for left side Sender
   int cpu_right_receiver; 	// lcore for right side Receiver
   int cpu_right_sender; 	// lcore for right side Sender
   int cpu_left_receiver; 	// lcore for left side Receiver
+  unsigned cpu_placement;	// 0: the lcores are set in the config file, 1: the unset ones are chosen automatically (NUMA-aware)
+
+  // multiple port pairs (index 0 is the above single pair, it is filled in by init())
+  unsigned port_pairs;		// number of Left/Right port pairs used in parallel (stateless tests of siitperf-tp only)
+  int pair_cpu[MAX_PORT_PAIRS][4];	// lcores of the port pairs: left sender, right receiver, right sender, left receiver
+  uint8_t pair_mac[MAX_PORT_PAIRS][4][6]; // MAC addresses of the port pairs: left tester, right tester, left DUT, right DUT
 
   uint8_t memory_channels; 	// Number of memory channnels (for the EAL init.)
+  unsigned max_lateness;	// maximum allowed lateness of a frame (microseconds), the test is invalid if exceeded (0: not checked)
+  unsigned noise_check;		// host noise preflight check of the lcores: 0: off, 1: warn, 2: refuse to run
 
   // encoding: 0: use fix ports as defined in RFC 2544, 1: increase, 2: decrease, 3: pseudorandom
   unsigned fwd_var_sport;       // control value for fixed or variable source port numbers
@@ -129,15 +457,17 @@ public:
   unsigned ip_right_varies;     // control value for fixed or variable left side IP address
   unsigned ip_varies;           // derived logical value: at least one IP address has to be changed?
 
-  uint16_t ip_left_min;		// minumum value for the changing 16-bit of the left side IP address
-  uint16_t ip_left_max;		// maximum value for the changing 16-bit of the left side IP address
-  uint16_t ip_right_min;	// minumum value for the changing 16-bit of the right side IP address
-  uint16_t ip_right_max;	// maxumum value for the changing 16-bit of the right side IP address
+  uint64_t ip_left_min;		// minumum value for the changing bits of the left side IP address
+  uint64_t ip_left_max;		// maximum value for the changing bits of the left side IP address
+  uint64_t ip_right_min;	// minumum value for the changing bits of the right side IP address
+  uint64_t ip_right_max;	// maxumum value for the changing bits of the right side IP address
+  unsigned ip_left_bits;	// width of the changing field of the left side IP address: 16, 32 or 64 bits
+  unsigned ip_right_bits;	// width of the changing field of the right side IP address: 16, 32 or 64 bits
  
-  uint16_t ipv4_left_offset;	// offset from the begining of the left side IPv4 address to its varying 16-bit
-  uint16_t ipv4_right_offset;	// offset from the begining of the right side IPv4 address to its varying 16-bit
-  uint16_t ipv6_left_offset;	// offset from the begining of the left side IPv6 address to its varying 16-bit
-  uint16_t ipv6_right_offset;	// offset from the begining of the right side IPv6 address to its varying 16-bit
+  uint16_t ipv4_left_offset;	// offset from the begining of the left side IPv4 address to its varying field
+  uint16_t ipv4_right_offset;	// offset from the begining of the right side IPv4 address to its varying field
+  uint16_t ipv6_left_offset;	// offset from the begining of the left side IPv6 address to its varying field
+  uint16_t ipv6_right_offset;	// offset from the begining of the right side IPv6 address to its varying field
 
   // encoding: 0: stateless tests; 1,2: stateful, Responder is on the 1: right side, 2: left side
   unsigned stateful;            // control the type (stateless or stateful) of the DUT
@@ -148,6 +478,12 @@ public:
   //           3: select a 4-tuple from the state table in a pseudorandom way (to be RFC 4814 compliant)
   unsigned responder_tuples;     // how to select a 4-tuple for test frame generation
 
+  // encoding: 0: the Responder sends test frames using the 4-tuples of its state table (see above)
+  //           1: the Responder echoes each received foreground frame back to its own 4-tuple (request/response)
+  //              the Initiator measures round-trip time and reply loss, Responder-tuples is not used
+  unsigned responder_echo;      // the Responder replies to the received foreground frames
+  unsigned tcp;			// 1: the test frames carry TCP segments: SYN in the preliminary phase, ACK in the test phase
+
   // encoding: 
   //    0: no, use port numbers as specified by other parameters
   //  1,2: yes, sport is the low order, dport is the high order counter, their min and max values are honored
@@ -166,10 +502,47 @@ public:
   //       uniqueness is ensured by using pre-generated random permutation
   unsigned enumerate_ips;
 
+  // encoding: 0: perform a single measurement
+  //           1: connection tracking table capacity search (RFC 9693), C0 is taken from 'N', the upper bound of the rate from 'R'
+  //           2: maximum connection establishment rate search using 'N' connections, the upper bound of the rate is taken from 'R'
+  unsigned search_mode;		// in-process search keeping EAL, ports, pools and pre-generated combinations across steps
+  unsigned search_alpha;	// validation rate in percent of R
+  unsigned search_beta;		// unacceptable drop of R during the exponential search (percent)
+  unsigned search_gamma;	// unacceptable drop of R during the final binary search (percent)
+  uint32_t search_r_error;	// the binary search for R stops, when the width of the interval is not higher than this
+  uint32_t search_c_error;	// the final binary search for the capacity stops, when the width of the interval is not higher than this
+  unsigned search_sleep;	// sleeping time between the steps of a search (in seconds)
+  char dut_reset[LINELEN+1];	// command executed before each step of a search to clear the connections of the DUT (may be empty)
+
+  popularityParameters popularity;	// popularity distribution of the pseudorandom values used in the test phase
+  imixParameters imix;			// frame size mix of the stateless tests (siitperf-tp, Schedule 1 or Pipeline 1 only)
+
+  // encoding: 0: the senders compute the varying fields of the frames during sending
+  //           1: the varying fields and checksums are computed before sending (stateless tests of siitperf-tp only)
+  unsigned schedule;		// use a pre-materialized traffic schedule
+  unsigned schedule_memory;	// the memory limit of the whole schedule of a sender (MB), a larger one is generated in chunks
+  unsigned pipeline;		// 1: a helper lcore prepares the frames and passes them to the sender through an rte_ring
+  int cpu_left_helper;		// helper lcore of the Left Sender: schedule chunks or frame producer (-1: not set)
+  int cpu_right_helper;		// helper lcore of the Right Sender: schedule chunks or frame producer (-1: not set)
+
+  // encoding: 0: the Tester uses the network ports and the DUT
+  //           1: self-calibration: the ports are software loopback ports, the DUT is replaced by a forwarder lcore (siitperf-tp only)
+  unsigned calibrate;		// search for the highest frame rate the Tester itself can sustain with the given configuration
+  int cpu_forwarder;		// lcore of the forwarder replacing the DUT during the self-calibration (-1: not set)
+
+  // encoding: 0: siitperf-pdv performs a PDV (or special throughput) measurement
+  //           1: siitperf-pdv measures the number of received frames, the latency and the PDV in a single trial
+  unsigned combined;		// combined measurement with bounded memory (siitperf-pdv only)
+
+  // the buffers and the Latency Frames of the first measurement are reused by the further ones (siitperf-lat and siitperf-pdv only)
+  unsigned repetitions;		// number of measurements performed in a single process
+  unsigned repetition;		// the number of the current measurement (1-repetitions)
+
 
   // positional parameters from command line
   uint16_t ipv6_frame_size;	// size of the frames carrying IPv6 datagrams (including the 4 bytes of the FCS at the end) 
   uint16_t ipv4_frame_size; 	// redundant parameter, automatically set as ipv6_frame_size-20
+  uint16_t max_frame_size;	// derived parameter: the largest frame on the wire, jumbo frames are used above 1518
   uint32_t frame_rate;		// number of frames per second
   uint16_t duration;		// test duration (in seconds, 1-3600)
   uint16_t global_timeout;	// global timeout (in milliseconds, 0-60000)
@@ -186,6 +559,9 @@ public:
   rte_mempool *pkt_pool_left_sender, *pkt_pool_right_receiver;	// packet pools for the forward direction testing
   rte_mempool *pkt_pool_right_sender, *pkt_pool_left_receiver;	// packet pools for the reverse direction testing
   // note: the above packet pools are also used by the preliminary frame sending for the stateful tests
+  rte_mempool *pair_pool[MAX_PORT_PAIRS][4];	// packet pools of the port pairs (same order as at pair_cpu)
+  uint16_t pair_port[MAX_PORT_PAIRS][2];	// port IDs of the port pairs: left, right (pair i uses leftport+2*i and rightport+2*i)
+  uint32_t max_frame_rate;	// the highest frame rate that all the sending ports can carry (0: link speed is unknown)
   uint64_t hz;			// number of clock cycles per second 
   uint64_t start_tsc;		// sending of the test frames will begin at this time
   uint64_t finish_receiving;	// receiving of the test frames will end at this time
@@ -196,61 +572,205 @@ public:
 
   atomicFourTuple *stateTable;	// pointer of the state table of the Responder
   unsigned valid_entries = 0;	// number of valid entries in the state table
+  struct rte_ring *echo_ring;	// echo replies are passed from the Responder's Receiver to the Responder's Sender (Responder-echo 1)
+  struct rte_ring *pipeline_ring[2];	// prepared frames are passed from the producers to the Left and Right Senders (Pipeline 1)
+  struct rte_ring *calibration_ring[4];	// rings of the software loopback ports (Calibrate 1): left TX, right RX, right TX, left RX
 
   bits32 *uniquePortComb = 0; 	// array of pre-generated unique port number combinations (Enumerate-ports 3, but Enumerate-ips 0)
   bits32 *uniqueIpComb = 0; 	// array of pre-generated unique IP address combinations (Enumerate-ips 3, but Enumerate-ports 0)
   bits64 *uniqueFtComb = 0; 	// array of pre-generated unique four tuple combinations (Enumerate-ips 3, Enumerate-ports 3)
 
+  // results of the last stateful measurement, used by the in-process searches
+  uint64_t pre_received;	// number of preliminary frames received by the Responder
+  uint64_t val_received;	// number of test frames sent by the Responder and received by the Initiator
+
+  // results of the last measurement, used by the self-calibration
+  uint64_t fwd_received;	// number of test frames received in the forward direction
+  uint64_t rev_received;	// number of test frames received in the reverse direction
+  unsigned slow_senders;	// number of senders (including the preliminary phase), which could not keep the frame rate
+
 
   // helper functions (see their description at their definition)
   int findKey(const char *line, const char *key);
   int readConfigFile(const char *filename);
   int readCmdLine(int argc, const char *argv[]);
   int init(const char *argv0, uint16_t leftport, uint16_t rightport);
+  int initPortPair(unsigned i, int left_sender_pool_size, int right_sender_pool_size, int receiver_pool_size);
+  int checkMtu(uint16_t port, const struct rte_eth_conf *cfg_port);
+  uint16_t mbufSize();
+  int checkFrameRates();
+  int mkCalibrationPorts(uint16_t leftport, uint16_t rightport);
   virtual int senderPoolSize(int numDestNets, int varport);
   virtual int senderPoolSize(int numDestNets, int varport, int ip_varies);
   void numaCheck(uint16_t port, const char *port_side, int cpu, const char *cpu_name);
+  int hostNoiseCheck();
+  int placeLcores(uint16_t leftport, uint16_t rightport);
 
   // perform throughput measurement
   void measure(uint16_t leftport, uint16_t rightport);
+  class trafficSchedule *makeSchedule(const class mSenderParameters *p, int cpu_sender, int cpu_helper);
+  uint32_t senderFrameRate(int ip_version);
+  void preliminaryPhase(uint16_t leftport, uint16_t rightport);
+
+  // in-process searches
+  void setTimestamps();
+  void resetDut();
+  uint32_t maxConnections();
+  uint32_t distinctTuples();
+  int searchStep(uint16_t leftport, uint16_t rightport, uint32_t c, uint32_t r);
+  uint32_t searchRate(uint16_t leftport, uint16_t rightport, uint32_t c, uint32_t h, uint32_t stoprate);
+  void cttcSearch(uint16_t leftport, uint16_t rightport);
+  void rateSearch(uint16_t leftport, uint16_t rightport);
+  void calibrationSearch(uint16_t leftport, uint16_t rightport);
+  void drainCalibration(class forwarderParameters *fp);
+  void prepareRepetition(unsigned k);
+  void freeUniqueCombinations();
 
   Throughput();
 };
 
 // functions to create Test Frames (and their parts)
+// the versions with 'tcp_flags' create TCP segments with the given flags instead of UDP datagrams, if 'tcp_flags' is nonzero
 struct rte_mbuf *mkTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
                               const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                               const uint32_t *src_ip, const uint32_t *dst_ip, unsigned var_sport, unsigned var_dport);
+struct rte_mbuf *mkTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
+                              const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
+                              const uint32_t *src_ip, const uint32_t *dst_ip, unsigned var_sport, unsigned var_dport, uint8_t tcp_flags);
 struct rte_mbuf *mkVaripTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
                               const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                               const uint32_t *src_ip, const uint32_t *dst_ip, unsigned var_sport, unsigned var_dport);
+struct rte_mbuf *mkVaripTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
+                              const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
+                              const uint32_t *src_ip, const uint32_t *dst_ip, unsigned var_sport, unsigned var_dport, uint8_t tcp_flags);
 struct rte_mbuf *mkFinalTestFrame4(uint16_t length, rte_mempool *pkt_pool, const char *side,
                                    const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
-                                   const uint32_t *src_ip, const uint32_t *dst_ip, unsigned sport, unsigned dport);
+                                   const uint32_t *src_ip, const uint32_t *dst_ip, unsigned sport, unsigned dport, uint8_t tcp_flags);
 void mkEthHeader(struct rte_ether_hdr *eth, const struct ether_addr *dst_mac, const struct ether_addr *src_mac, const uint16_t ether_type);
 void mkIpv4Header(struct rte_ipv4_hdr *ip, uint16_t length, const uint32_t *src_ip, const uint32_t *dst_ip);
 void mkUdpHeader(struct rte_udp_hdr *udp, uint16_t length, unsigned var_sport, unsigned var_dport); 
+void mkTcpHeader(struct rte_tcp_hdr *tcp, unsigned sport, unsigned dport, uint8_t tcp_flags);
 void mkData(uint8_t *data, uint16_t length);
+void stampEcho(uint8_t *data, uint64_t tsc);
 struct rte_mbuf *mkTestFrame6(uint16_t length, rte_mempool *pkt_pool, const char *side,
                                 const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                                 const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned var_sport, unsigned var_dport);
+struct rte_mbuf *mkTestFrame6(uint16_t length, rte_mempool *pkt_pool, const char *side,
+                                const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
+                                const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned var_sport, unsigned var_dport,
+                                uint8_t tcp_flags);
 struct rte_mbuf *mkVaripTestFrame6(uint16_t length, rte_mempool *pkt_pool, const char *side,
                                 const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
                                 const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned var_sport, unsigned var_dport);
+struct rte_mbuf *mkVaripTestFrame6(uint16_t length, rte_mempool *pkt_pool, const char *side,
+                                const struct ether_addr *dst_mac, const struct ether_addr *src_mac,
+                                const struct in6_addr *src_ip, const struct in6_addr *dst_ip, unsigned var_sport, unsigned var_dport,
+                                uint8_t tcp_flags);
 void mkIpv6Header(struct rte_ipv6_hdr *ip, uint16_t length, const struct in6_addr *src_ip, const struct in6_addr *dst_ip);
 
+// compact record of the fields of the Test Frames depending on the destination network (multiple destination networks, see send() and rsend())
+// network k uses the 16-bit field of the destination address with its low byte cleared plus k: bytes 1-2 of IPv4 and bytes 6-7 of IPv6
+// addresses, thus the first 256 networks are the same as with pre-generated frames (byte 2 of IPv4 or byte 7 of IPv6 is k)
+struct destNetFields {
+  uint16_t fg_dst, bg_dst;	// the 16-bit fields of the destination addresses carrying the network (in network byte order)
+  uint16_t fg_chksum, bg_chksum;	// UDP (or TCP) checksums: final ones with fixed ports, uncomplemented ones with varying ports
+  uint16_t fg_ipv4_chksum;	// IPv4 header checksum (not used by IPv6 and background frames)
+};
+destNetFields *mkDestNets(struct rte_mbuf *fg_pkt_mbuf, struct rte_mbuf *bg_pkt_mbuf, int ip_version, uint32_t num_dest_nets,
+                          unsigned varport, uint8_t tcp_flags, const char *side);
+
 // report the current TSC of the exeucting core
 int report_tsc(void *par);
 
 // check if the TSC of the given core is synchronized with the TSC of the main core
 void check_tsc(int cpu, const char *cpu_name);
 
+// parameters of the host noise probe: the lcore reads its TSC in a tight loop, and the gaps between the consecutive
+// reads (interrupts, SMIs, preemption by other tasks, etc.) are recorded
+class noiseProbeParameters {
+  public:
+  uint64_t duration;		// duration of the probe (TSC cycles)
+  uint64_t threshold;		// gaps longer than this are counted (TSC cycles)
+  // results
+  uint64_t max_gap;		// the longest gap (TSC cycles)
+  uint64_t gaps;		// number of the gaps longer than the threshold
+  uint64_t gap_cycles;		// total length of the gaps longer than the threshold (TSC cycles)
+
+  noiseProbeParameters(uint64_t duration_, uint64_t threshold_);
+  noiseProbeParameters() {};
+};
+
+// host noise probe (par points to a noiseProbeParameters)
+int noiseProbe(void *par);
+
+// reads the first line of a (sysfs) file without the trailing newline, returns -1 if it cannot be read
+int readSysfs(const char *path, char *buf, int size);
+
+// checks if the CPU is in a cpulist of the kernel (e.g. "2-7,10")
+int inCpuList(const char *list, int cpu);
+
+// prepares the list of the online CPUs (below RTE_MAX_LCORE) for the EAL, returns -1 if it cannot be done
+int onlineCpuList(char *buf, int size);
+
+// marks the lcore and its hyper-threading siblings as used
+void markSiblings(int lcore, int *used);
+
+// measurement of the offset of the TSC of a receiver lcore relative to that of a sender lcore by ping-pong through shared memory:
+// the sender writes the round number (at its TSC t1), the receiver replies with its TSC (t2), the sender sees it (at t3),
+// the offset is t2-(t1+t3)/2 with an error of at most (t3-t1)/2; the round with the shortest round-trip time is used.
+// It is performed before and after the test (while both lcores are idle), and the receive timestamps are corrected
+// by the average of the two offsets (used by siitperf-lat and siitperf-pdv).
+class tscOffset {
+  public:
+  int sender, receiver;		// the lcores of the sender and of the receiver
+  std::atomic<uint64_t> round;	// number of the current round (written by the sender)
+  std::atomic<uint64_t> reply;	// number of the round replied (written by the receiver)
+  std::atomic<uint64_t> tsc;	// TSC of the receiver at its reply
+  int64_t offset;		// result: TSC of the receiver minus TSC of the sender (TSC cycles)
+  uint64_t error;		// result: maximum error of the offset (TSC cycles)
+  int64_t offset_before;	// offset measured before the test
+  uint64_t error_before;	// its maximum error
+
+  tscOffset(int sender_, int receiver_);
+  void measure();		// performs TSC_PINGPONG_ROUNDS rounds, the results are stored in 'offset' and 'error'
+  void correct(uint64_t num_timestamps, uint64_t *receive_ts, uint64_t hz, const char *side); // measures again and corrects
+};
+
+// the two sides of the TSC offset measurement (par points to a tscOffset)
+int tscPing(void *par);		// executed by the sender lcore
+int tscPong(void *par);		// executed by the receiver lcore
+
+// parameters of clearTimestamps(): the receive timestamps are zeroed by the idle receiver lcores
+// after the evaluation of a measurement, while the main lcore prepares the next repetition
+class clearParameters {
+  public:
+  uint64_t *ts;		// the array of the timestamps
+  uint64_t num;		// the number of its elements
+
+  clearParameters() { ts = 0; num = 0; };
+  clearParameters(uint64_t *ts_, uint64_t num_) { ts = ts_; num = num_; };
+};
+
+int clearTimestamps(void *par);	// executed by the receiver lcore owning the array
+
 // send test frame: stateless version
 int send(void *par);
 
 // send test frame: stateless version using multiple source and/or destination IP address (does not support multiple networks)
 int msend(void *par);
 
+// send test frame: stateless version using a pre-materialized traffic schedule (otherwise like msend)
+int ssend(void *par);
+
+// generates a pre-materialized traffic schedule in chunks, while ssend is sending
+int scheduleHelper(void *par);
+
+// prepares Test Frames on a helper lcore and passes them to psend through an rte_ring (Pipeline 1)
+int pipelineProducer(void *par);
+
+// send test frame: stateless version, only paces and sends the frames prepared by pipelineProducer
+int psend(void *par);
+
 // send test frame: stateful version (Initiator/Sender) -- like send, plus supports port number enumeration (with a single dest. net.)
 int isend(void *par);
 
@@ -263,9 +783,27 @@ int rsend(void *par);
 // receive and count test frames (stateless version and Initiator/Receiver, too)
 int receive(void *par);
 
+// receive and count test frames for each IMIX frame size class (stateless version)
+int receiveImix(void *par);
+
+// receive and count test frames for each destination network (stateless version, multiple destination networks)
+int receiveNets(void *par);
+
 // rreceive, store 4-tuple and count test frames: stateful version (Responder/Receiver)
 int rreceive(void *par);
 
+// like rreceive, plus turns foreground frames into echo replies and passes them to rsendEcho (Responder/Receiver, Responder-echo 1)
+int rreceiveEcho(void *par);
+
+// send the echo replies prepared by rreceiveEcho (Responder/Sender, Responder-echo 1)
+int rsendEcho(void *par);
+
+// receive and count echo replies, measure round-trip time (Initiator/Receiver, Responder-echo 1)
+int receiveEcho(void *par);
+
+// forward the frames between the software loopback ports like a DUT with zero latency (Calibrate 1)
+int calibrationForwarder(void *par);
+
 // allocate NUMA local memory and pre-generate random permutation -- Executed by the core of Initiator/Sender!
 int randomPermutationGenerator32(void *par);
 
@@ -291,6 +829,106 @@ class randomPermutationGeneratorParameters64 {
   uint64_t hz;                  // just to be able to display the execution time
 };
 
+// live counters of a worker lcore published through the telemetry socket of DPDK (see telemetryLive()), thus running tests
+// can be monitored; they are written only by the worker using relaxed atomic stores at burst granularity (every MAX_PKT_BURST
+// frames or every poll), and each lcore has its own cache line, therefore reading them does not perturb the workers
+struct alignas(RTE_CACHE_LINE_SIZE) liveCounters {
+  std::atomic<const char *> side;	// side of the worker, 0: the lcore has not been used by a worker
+  std::atomic<const char *> role;	// "sender" or "receiver"
+  std::atomic<int> port;		// the port used by the worker
+  std::atomic<uint64_t> frames;		// number of frames sent so far, or number of frames returned by rte_eth_rx_burst() so far
+  std::atomic<uint64_t> max_lateness;	// maximum lateness of the frames sent so far (TSC cycles, senders only)
+  std::atomic<uint64_t> state_entries;	// number of valid entries of the state table (Responder's receivers only)
+
+  void start(const char *side_, const char *role_, uint16_t port_); // called by the worker before its sending or receiving cycle
+};
+extern liveCounters live[RTE_MAX_LCORE];	// indexed by the lcore ID
+int telemetryLive(const char *cmd, const char *params, struct rte_tel_data *d);	// callback of the "/siitperf/live" command
+
+// log2 histogram of the lateness of the sending of the frames relative to their scheduled sending times
+// (start_tsc+sent_frames*hz/frame_rate): bin 0 counts the frames sent on time, bin k counts the frames sent late
+// by [2^(k-1), 2^k) TSC cycles. It is cheap enough to be updated for every frame by the senders.
+class latenessHistogram {
+  public:
+  uint64_t bins[LATENESS_BINS];	// number of frames in each bin
+  uint64_t max;			// maximum lateness (TSC cycles)
+  uint64_t begin;		// TSC at the first call of wait(): the cycle accounting of the sender starts here
+  uint64_t idle;		// cycles spent by busy waiting for the sending times (pacing), the rest is spent preparing and sending
+  uint64_t frames;		// number of calls of wait(), that is, the number of frames
+  liveCounters *lc;		// live counters of the sender
+
+  latenessHistogram(const char *side, uint16_t port) {
+    memset(bins, 0, sizeof(bins)); max = 0; begin = 0; idle = 0; frames = 0;
+    lc = &live[rte_lcore_id()];
+    lc->start(side, "sender", port);
+  }
+  // waits until the scheduled sending time of a frame and records its lateness, returns the current TSC
+  inline uint64_t wait(uint64_t due) {
+    uint64_t entry, now, late;
+    entry = now = rte_rdtsc();
+    if ( unlikely( !begin ) )
+      begin = entry;
+    while ( now < due )
+      now = rte_rdtsc(); // Beware: busy waiting
+    idle += now - entry;
+    late = now - due;
+    bins[late ? 64 - __builtin_clzll(late) : 0]++;
+    if ( unlikely( late > max ) ) {
+      max = late;
+      lc->max_lateness.store(max, std::memory_order_relaxed);
+    }
+    if ( unlikely( ++frames % MAX_PKT_BURST == 0 ) )
+      lc->frames.store(frames, std::memory_order_relaxed);
+    return now;
+  }
+  int report(const char *side, uint64_t hz, uint64_t bound); // non-zero, if the maximum lateness exceeded the bound
+};
+
+// cycle accounting of a receiver: the cycles spent in rte_eth_rx_burst() calls returning frames, processing the frames,
+// and in empty polls (idle); a receiver getting full bursts (MAX_PKT_BURST frames) in most of its polls is close to its limit
+class pollCounters {
+  public:
+  uint64_t polls, empty_polls, full_bursts;	// number of rte_eth_rx_burst() calls by their results
+  uint64_t rx_cycles, work_cycles, idle_cycles;	// cycles spent by receiving, processing and empty polls
+  uint64_t last;		// TSC at the end of the previous rte_eth_rx_burst() call (0: no previous call)
+  int last_frames;		// the number of frames returned by the previous call
+  uint64_t frames_total;	// number of frames returned by rte_eth_rx_burst() so far (including non-test frames)
+  liveCounters *lc;		// live counters of the receiver
+
+  pollCounters(const char *side, uint16_t port) {
+    polls = empty_polls = full_bursts = rx_cycles = work_cycles = idle_cycles = last = frames_total = 0; last_frames = 0;
+    lc = &live[rte_lcore_id()];
+    lc->start(side, "receiver", port);
+  }
+  // called after each rte_eth_rx_burst() call, which was started at 'start' and returned 'frames' frames
+  // the cycles since the end of the previous call were spent processing its frames (or idle, if it did not return any)
+  // returns the current TSC
+  inline uint64_t count(int frames, uint64_t start) {
+    uint64_t now = rte_rdtsc();
+    if ( likely( last ) ) {
+      if ( last_frames )
+        work_cycles += start - last;
+      else
+        idle_cycles += start - last;
+    }
+    polls++;
+    if ( frames ) {
+      rx_cycles += now - start;
+      if ( frames == MAX_PKT_BURST )
+        full_bursts++;
+      frames_total += frames;
+      lc->frames.store(frames_total, std::memory_order_relaxed);
+    } else {
+      idle_cycles += now - start;
+      empty_polls++;
+    }
+    last = now;
+    last_frames = frames;
+    return now;
+  }
+  void report(const char *side);
+};
+
 // to store identical parameters for both senders
 class senderCommonParameters {
   public:
@@ -302,10 +940,21 @@ class senderCommonParameters {
   uint64_t hz;                  // number of clock cycles per second
   uint64_t start_tsc;           // sending of the test frames will begin at this time
 //  uint64_t frames_to_send;      // number of frames to send
+  unsigned responder_echo;      // if non-zero, foreground frames carry a timestamp for round-trip time measurement
+  const popularityParameters *popularity; // popularity distribution of the pseudorandom values, 0 means uniform
+  const imixParameters *imix;	// frame size mix, 0 means that the above frame sizes are used
+  uint8_t tcp_flags;		// 0: UDP test frames, otherwise TCP segments with these flags (stateful tests only)
+  uint64_t max_lateness;	// maximum allowed lateness of a frame (TSC cycles), 0: not checked (see latenessHistogram)
 
   senderCommonParameters();
   senderCommonParameters(uint16_t ipv6_frame_size_, uint16_t ipv4_frame_size_, uint32_t frame_rate_, uint16_t duration_,
                          uint32_t n_, uint32_t m_, uint64_t hz_, uint64_t start_tsc_);
+  senderCommonParameters(uint16_t ipv6_frame_size_, uint16_t ipv4_frame_size_, uint32_t frame_rate_, uint16_t duration_,
+                         uint32_t n_, uint32_t m_, uint64_t hz_, uint64_t start_tsc_, unsigned responder_echo_,
+                         const popularityParameters *popularity_);
+  senderCommonParameters(uint16_t ipv6_frame_size_, uint16_t ipv4_frame_size_, uint32_t frame_rate_, uint16_t duration_,
+                         uint32_t n_, uint32_t m_, uint64_t hz_, uint64_t start_tsc_, unsigned responder_echo_,
+                         const popularityParameters *popularity_, const imixParameters *imix_, uint8_t tcp_flags_);
 };
 
 // to store differing parameters for each sender
@@ -320,15 +969,16 @@ class senderParameters {
   uint32_t *src_ipv4, *dst_ipv4;
   struct in6_addr *src_ipv6, *dst_ipv6;
   struct in6_addr *src_bg, *dst_bg;
-  uint16_t num_dest_nets;
+  uint32_t num_dest_nets;
   unsigned var_sport, var_dport;
   uint16_t sport_min, sport_max, dport_min, dport_max;
+  uint64_t *net_sent;	// output: number of test frames sent to each destination network (allocated by send(), multiple destination networks only)
 
   senderParameters();
   senderParameters(class senderCommonParameters *cp_, int ip_version_, rte_mempool *pkt_pool_, uint16_t eth_id_, const char *side_,
                    struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
                    struct in6_addr *src_ipv6_, struct in6_addr *dst_ipv6_, struct in6_addr *src_bg_, struct in6_addr *dst_bg_,
-                   uint16_t num_dest_nets_, unsigned var_sport_, unsigned var_dport_,
+                   uint32_t num_dest_nets_, unsigned var_sport_, unsigned var_dport_,
 	           uint16_t sport_min_, uint16_t sport_max_, uint16_t dport_min_, uint16_t dport_max_);
 };
 
@@ -347,7 +997,8 @@ class mSenderParameters {
   struct in6_addr *src_bg, *dst_bg;
   // excluded: uint16_t num_dest_nets;
   unsigned var_sip, var_dip;
-  uint16_t sip_min, sip_max, dip_min, dip_max;
+  uint64_t sip_min, sip_max, dip_min, dip_max;
+  unsigned sip_bits, dip_bits;	// width of the varying fields of the IP addresses: 16, 32 or 64 bits
   uint16_t src_ipv4_offset, dst_ipv4_offset, src_ipv6_offset, dst_ipv6_offset;
   unsigned var_sport, var_dport;
   uint16_t sport_min, sport_max, dport_min, dport_max;
@@ -357,12 +1008,80 @@ class mSenderParameters {
                    struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
                    struct in6_addr *src_ipv6_, struct in6_addr *dst_ipv6_, struct in6_addr *src_bg_, struct in6_addr *dst_bg_,
                    unsigned var_sip_, unsigned var_dip_,
-                   uint16_t sip_min_, uint16_t sip_max_, uint16_t dip_min_, uint16_t dip_max,
+                   uint64_t sip_min_, uint64_t sip_max_, uint64_t dip_min_, uint64_t dip_max, unsigned sip_bits_, unsigned dip_bits_,
                    uint16_t src_ipv4_offset_, uint16_t dst_ipv4_offset_, uint16_t src_ipv6_offset_, uint16_t dst_ipv6_offset,
                    unsigned var_sport_, unsigned var_dport_,
 	           uint16_t sport_min_, uint16_t sport_max_, uint16_t dport_min_, uint16_t dport_max_);
 };
 
+// compact record of the varying fields of a Test Frame in a pre-materialized traffic schedule (Schedule 1)
+// the values are stored in network byte order, thus the sender only copies them into the frame
+struct scheduleRecord {
+  uint16_t sip, dip;		// the varying 16-bit parts of the source and destination IP addresses
+  uint16_t sport, dport;	// source and destination port numbers
+  uint16_t ipv4_chksum;		// IPv4 header checksum (not used by IPv6 and background frames)
+  uint16_t udp_chksum;		// UDP checksum
+  uint16_t fg;			// 1: foreground frame, 0: background frame
+  uint16_t size;		// index of the frame size class (IMIX), 0 if IMIX is not used
+};
+
+// pre-materialized traffic schedule (Schedule 1): the varying fields and the checksums of all the frames of a sender
+// are computed before sending begins, thus the sender only copies them and paces the frames.
+// If the whole schedule does not fit into 'Schedule-memory', then it is generated in chunks of SCHEDULE_CHUNK records
+// into a double buffer by a helper lcore, while the sender is sending.
+class trafficSchedule {
+  // parameters of the generation (taken from mSenderParameters)
+  int ip_version;
+  uint32_t n, m;
+  const imixParameters *imix;	// frame size mix, 0 if not used
+  unsigned var_sip, var_dip, var_sport, var_dport;
+  uint16_t sip_min, sip_max, dip_min, dip_max;
+  uint16_t sport_min, sport_max, dport_min, dport_max;
+
+  // state of the generation (continued from chunk to chunk)
+  uint16_t src_ip, dst_ip, sport, dport;	// values of the increased or decreased fields
+  fastRandom gen_sip, gen_dip, gen_sport, gen_dport;	// xoshiro256** engines
+  popularityDistribution uni_dis_sip, uni_dis_dip, uni_dis_sport, uni_dis_dport;	// uniform or skewed distributions
+  uint64_t generated;		// number of records generated so far
+
+  public:
+  uint64_t frames;		// number of frames to be sent
+  uint64_t slots;		// number of records stored: all the frames, or two chunks (double buffer)
+  bool chunked;			// the records are generated in chunks by a helper lcore (also with Pipeline 1)
+  scheduleRecord *records;	// frame i uses records[i % slots]
+  uint16_t fg_ipv4_chksum_start[IMIX_MAX_SIZES];	// uncomplemented checksums of the pre-generated frames of each size class
+  uint16_t fg_udp_chksum_start[IMIX_MAX_SIZES];	// (set by the sender)
+  uint16_t bg_udp_chksum_start[IMIX_MAX_SIZES];
+  std::atomic<bool> started;		// the sender has set the above checksums
+  std::atomic<uint64_t> produced;	// the records of the frames below this index are ready
+  std::atomic<uint64_t> consumed;	// the frames below this index have been sent (used in chunked mode)
+
+  trafficSchedule(const class mSenderParameters *p, uint64_t frames_, uint64_t slots_, int socket);
+  ~trafficSchedule();
+  void generate(uint64_t count);
+
+  // memory needed for the given number of records
+  static uint64_t memory(uint64_t records) { return records*sizeof(scheduleRecord); }
+};
+
+// to store differing parameters for each sender + par. for ssend
+class sSenderParameters : public mSenderParameters {
+  public:
+  trafficSchedule *schedule;	// pre-materialized traffic schedule of the sender
+
+  sSenderParameters();
+  sSenderParameters(const mSenderParameters &msp, trafficSchedule *schedule_);
+};
+
+// to store differing parameters for each sender + par. for the two stages of the pipeline (pipelineProducer and psend)
+class pSenderParameters : public sSenderParameters {
+  public:
+  struct rte_ring *ring;	// prepared frames are passed from the producer to the sender
+
+  pSenderParameters();
+  pSenderParameters(const mSenderParameters &msp, trafficSchedule *schedule_, struct rte_ring *ring_);
+};
+
 // to store differing parameters for each sender + par. for isend
 class iSenderParameters : public senderParameters {
   public:
@@ -394,7 +1113,8 @@ class imSenderParameters {
   struct in6_addr *src_bg, *dst_bg;
   // excluded: uint16_t num_dest_nets;
   unsigned var_sip, var_dip;
-  uint16_t sip_min, sip_max, dip_min, dip_max;
+  uint64_t sip_min, sip_max, dip_min, dip_max;
+  unsigned sip_bits, dip_bits;	// width of the varying fields of the IP addresses: 16, 32 or 64 bits
   uint16_t src_ipv4_offset, dst_ipv4_offset, src_ipv6_offset, dst_ipv6_offset;
   unsigned var_sport, var_dport;
   uint16_t sport_min, sport_max, dport_min, dport_max;
@@ -409,7 +1129,7 @@ class imSenderParameters {
                    struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
                    struct in6_addr *src_ipv6_, struct in6_addr *dst_ipv6_, struct in6_addr *src_bg_, struct in6_addr *dst_bg_,
                    unsigned var_sip_, unsigned var_dip_,
-                   uint16_t sip_min_, uint16_t sip_max_, uint16_t dip_min_, uint16_t dip_max,
+                   uint64_t sip_min_, uint64_t sip_max_, uint64_t dip_min_, uint64_t dip_max, unsigned sip_bits_, unsigned dip_bits_,
                    uint16_t src_ipv4_offset_, uint16_t dst_ipv4_offset_, uint16_t src_ipv6_offset_, uint16_t dst_ipv6_offset,
                    unsigned var_sport_, unsigned var_dport_,
 	           uint16_t sport_min_, uint16_t sport_max_, uint16_t dport_min_, uint16_t dport_max_,
@@ -428,7 +1148,7 @@ class rSenderParameters : public senderParameters {
   rSenderParameters(class senderCommonParameters *cp_, int ip_version_, rte_mempool *pkt_pool_, uint16_t eth_id_, const char *side_,
                    struct ether_addr *dst_mac_,  struct ether_addr *src_mac_,  uint32_t *src_ipv4_, uint32_t *dst_ipv4_,
                    struct in6_addr *src_ipv6_, struct in6_addr *dst_ipv6_, struct in6_addr *src_bg_, struct in6_addr *dst_bg_,
-                   uint16_t num_dest_nets_, unsigned var_sport_, unsigned var_dport_,
+                   uint32_t num_dest_nets_, unsigned var_sport_, unsigned var_dport_,
                    uint16_t sport_min_, uint16_t sport_max_, uint16_t dport_min_, uint16_t dport_max_,
                    unsigned state_table_size_, atomicFourTuple *stateTable_, unsigned responder_tuples_);
 };
@@ -439,11 +1159,34 @@ class receiverParameters {
   uint64_t finish_receiving;     // this one is common, but it was not worth dealing with it.
   uint16_t eth_id;
   const char *side;
+  uint64_t received;		// output: number of received test frames (set by receive(), used for aggregation over port pairs)
 
   receiverParameters();
   receiverParameters(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_);
 };
 
+// to store parameters for the receiver counting the frames of each IMIX frame size class
+class receiverParametersImix : public receiverParameters {
+  public:
+  const imixParameters *imix;	// frame size mix
+  uint64_t class_received[IMIX_MAX_SIZES];	// output: number of received test frames of each size class
+
+  receiverParametersImix();
+  receiverParametersImix(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, const imixParameters *imix_);
+};
+
+// to store parameters for the receiver counting the frames sent to each destination network
+class receiverParametersNets : public receiverParameters {
+  public:
+  uint32_t num_nets;		// number of destination networks (Num-L-Nets or Num-R-Nets)
+  uint16_t ipv4_dst, ipv6_dst;	// the 16-bit fields of the IPv4 and IPv6 destination addresses of network 0 (see destNetFields)
+  uint64_t *net_received;	// output: number of received test frames of each destination network (allocated by receiveNets())
+
+  receiverParametersNets();
+  receiverParametersNets(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, uint32_t num_nets_,
+                         const uint32_t *ipv4_dst_, const struct in6_addr *ipv6_dst_);
+};
+
 // to store parameters for Responder's receiver
 class rReceiverParameters : public receiverParameters {
   public:
@@ -456,6 +1199,50 @@ class rReceiverParameters : public receiverParameters {
                       unsigned *valid_entries_, atomicFourTuple **stateTable_);
 };
 
+// to store parameters for Responder's receiver in echo mode
+class rReceiverParametersEcho : public rReceiverParameters {
+  public:
+  struct rte_ring *echo_ring;	// echo replies are enqueued here
+
+  rReceiverParametersEcho();
+  rReceiverParametersEcho(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_,unsigned state_table_size_,
+                          unsigned *valid_entries_, atomicFourTuple **stateTable_, struct rte_ring *echo_ring_);
+};
+
+// to store parameters for Responder's sender in echo mode
+class rSenderParametersEcho {
+  public:
+  uint64_t finish_sending;	// echo replies are sent until this time
+  uint16_t eth_id;
+  const char *side;
+  struct rte_ring *echo_ring;	// echo replies are dequeued from here
+
+  rSenderParametersEcho();
+  rSenderParametersEcho(uint64_t finish_sending_, uint16_t eth_id_, const char *side_, struct rte_ring *echo_ring_);
+};
+
+// to store parameters for the forwarder of the self-calibration (Calibrate 1)
+class forwarderParameters {
+  public:
+  struct rte_ring **rings;	// left TX, right RX, right TX, left RX: frames are moved from ring 0 to 1, and from ring 2 to 3
+  std::atomic<bool> stop;	// the forwarder runs until this flag is set
+  std::atomic<uint64_t> rounds;	// number of the completed polling rounds, used for checking that the forwarder is idle
+  uint64_t forwarded;		// output: number of forwarded frames
+  uint64_t dropped;		// output: number of frames dropped because the ring of the receiver was full
+
+  forwarderParameters(struct rte_ring **rings_);
+};
+
+// to store parameters for Initiator's receiver in echo mode
+class receiverParametersEcho : public receiverParameters {
+  public:
+  uint64_t hz;			// for converting round-trip times to milliseconds
+  uint64_t expected_replies;	// number of foreground frames sent by the Initiator: each of them should be replied
+
+  receiverParametersEcho();
+  receiverParametersEcho(uint64_t finish_receiving_, uint16_t eth_id_, const char *side_, uint64_t hz_, uint64_t expected_replies_);
+};
+
 // to collect source and destionation IPv4 and IPv6 addresses
 class ipQuad {
   public: